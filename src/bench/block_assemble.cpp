@@ -2,6 +2,7 @@
 // Distributed under the MIT software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
+#include <arith_uint256.h>
 #include <bench/bench.h>
 #include <chainparams.h>
 #include <coins.h>
@@ -13,6 +14,7 @@
 #include <scheduler.h>
 #include <txdb.h>
 #include <txmempool.h>
+#include <utilstrencodings.h>
 #include <utiltime.h>
 #include <validation.h>
 #include <validationinterface.h>
@@ -22,6 +24,13 @@
 #include <list>
 #include <vector>
 #include "pocketdb/services/Serializer.h"
+#include "pocketdb/models/dto/Subscribe.h"
+#include "pocketdb/pocketnet.h"
+
+// Social part of mempool: subscriptions between registered accounts. Every tenth one repeats
+// subscription of the same template and is rejected by social consensus of block.
+static const int SOCIAL_TXS = 2000;
+static const int SOCIAL_ADDRESSES = 200;
 
 
 static std::shared_ptr<CBlock> StakeBlock(const CScript& coinbase_scriptPubKey)
@@ -73,6 +82,54 @@ static CTxIn MineBlock(const CScript& coinbase_scriptPubKey)
 }
 
 
+static std::string SocialAddress(int i)
+{
+    return "benchaddress" + std::to_string(i % SOCIAL_ADDRESSES);
+}
+
+static void RegisterSocialAccounts()
+{
+    // Rows with the same hashes are kept - datadir of previous run is already seeded
+    auto sql = strprintf(R"sql(
+        insert or ignore into Transactions (Type, Hash, Time, BlockHash, BlockNum, Height, Last, Id, String1)
+        with recursive n(i) as (select 0 union all select i + 1 from n where i < %d)
+        select 100, 'benchuser' || i, i, 'benchblock', i, 1, 1, i, 'benchaddress' || i
+        from n
+    )sql", SOCIAL_ADDRESSES - 1);
+
+    char* errMsg = nullptr;
+    if (sqlite3_exec(PocketDb::SQLiteDbInst.m_db, sql.c_str(), nullptr, nullptr, &errMsg) != SQLITE_OK)
+    {
+        std::string error = errMsg ? errMsg : "";
+        sqlite3_free(errMsg);
+        throw std::runtime_error("can't register social accounts: " + error);
+    }
+}
+
+static void AddSocialTx(int i, const CScript& scriptPubKey) EXCLUSIVE_LOCKS_REQUIRED(::mempool.cs)
+{
+    // Every pass over accounts subscribes to next neighbours, repeated one takes neighbour of previous pass
+    int pass = i / SOCIAL_ADDRESSES;
+    if (i % 10 == 9 && pass > 0)
+        pass -= 1;
+
+    auto ptx = std::make_shared<PocketTx::Subscribe>();
+    ptx->SetAddress(SocialAddress(i));
+    ptx->SetAddressTo(SocialAddress(i + 1 + pass));
+
+    CMutableTransaction tx;
+    tx.vin.emplace_back(COutPoint{ArithToUint256(arith_uint256(i + 1)), 0});
+    tx.vout.emplace_back(0, CScript() << OP_RETURN << ParseHex(OR_SUBSCRIBE) << ParseHex(ptx->BuildHash()));
+    tx.vout.emplace_back(1337, scriptPubKey);
+    auto txRef = MakeTransactionRef(tx);
+
+    ptx->SetHash(txRef->GetHash().GetHex());
+
+    LockPoints lp;
+    ::mempool.addUnchecked(CTxMemPoolEntry(txRef, DEFAULT_MIN_POCKETNET_TX_FEE, 0, 1, false, 4, lp));
+    ::mempool.addPocketUnchecked(ptx);
+}
+
 static void AssembleBlock(benchmark::Bench& bench)
 {
     const std::vector<unsigned char> op_true{OP_TRUE};
@@ -130,6 +187,13 @@ static void AssembleBlock(benchmark::Bench& bench)
             assert(ret);
         }
     }
+    {
+        RegisterSocialAccounts();
+
+        LOCK2(::cs_main, ::mempool.cs);
+        for (int i = 0; i < SOCIAL_TXS; i++)
+            AddSocialTx(i, SCRIPT_PUB);
+    }
 
     bench.run([&] {
         StakeBlock(SCRIPT_PUB);
@@ -0,0 +1,101 @@
+// Copyright (c) 2018-2022 The Pocketnet developers
+// Distributed under the Apache 2.0 software license, see the accompanying
+// https://www.apache.org/licenses/LICENSE-2.0
+
+#include <bench/bench.h>
+#include <primitives/transaction.h>
+#include <util.h>
+
+#include "pocketdb/models/dto/Post.h"
+
+using namespace PocketTx;
+
+// Pocket transaction models the way block deserialization and consensus use them:
+// build 1000 posts with payload, 3 inputs and 3 outputs each, then read them back
+// the way Check does - op_return hash and payload size of every post.
+
+static const int BLOCK_TXS = 1000;
+static const int TX_INOUTS = 3;
+
+static std::string MakeHash(int i, char salt)
+{
+    auto hash = std::string(64, salt);
+    auto number = std::to_string(i);
+    return hash.replace(0, number.size(), number);
+}
+
+static std::vector<std::shared_ptr<Post>> BuildPosts()
+{
+    std::vector<std::shared_ptr<Post>> posts;
+    posts.reserve(BLOCK_TXS);
+
+    for (int i = 0; i < BLOCK_TXS; i++)
+    {
+        auto hash = MakeHash(i, 'a');
+
+        auto ptx = std::make_shared<Post>();
+        ptx->SetHash(hash);
+        ptx->SetTime(1600000000 + i);
+        ptx->SetAddress("PR7srzZt4EfcNb3s27grgmiG8aB9vYNV82" + std::to_string(i % 100));
+        ptx->SetRootTxHash(hash);
+
+        ptx->GeneratePayload();
+        ptx->GetPayload()->SetString1("en");
+        ptx->GetPayload()->SetString2("Caption of post " + std::to_string(i));
+        ptx->GetPayload()->SetString3(std::string(200, 'm'));
+        ptx->GetPayload()->SetString4("[\"tag1\",\"tag2\"]");
+        ptx->GetPayload()->SetString7("https://example.com/" + std::to_string(i));
+
+        for (int n = 0; n < TX_INOUTS; n++)
+        {
+            auto& inp = ptx->Inputs().emplace_back();
+            inp.SetSpentTxHash(hash);
+            inp.SetTxHash(MakeHash(i * TX_INOUTS + n, 'b'));
+            inp.SetNumber(n);
+
+            auto& out = ptx->Outputs().emplace_back();
+            out.SetTxHash(hash);
+            out.SetNumber(n);
+            out.SetValue(100000000 + n);
+            out.SetAddressHash(*ptx->GetAddress());
+            out.SetScriptPubKey(std::string(50, 's'));
+        }
+
+        posts.push_back(ptx);
+    }
+
+    return posts;
+}
+
+static void PocketTransactionBuild(benchmark::Bench& bench)
+{
+    bench.unit("block").run([&] {
+        auto posts = BuildPosts();
+        ankerl::nanobench::doNotOptimizeAway(posts);
+    });
+}
+
+static void PocketTransactionValidate(benchmark::Bench& bench)
+{
+    auto posts = BuildPosts();
+
+    bench.unit("block").run([&] {
+        size_t size = 0;
+        for (const auto& ptx : posts)
+        {
+            size += ptx->BuildHash().size();
+
+            for (const auto* field : {&ptx->GetPayloadUrl(), &ptx->GetPayloadCaption(), &ptx->GetPayloadMessage(),
+                                      &ptx->GetRelayTxHash(), &ptx->GetPayloadSettings(), &ptx->GetPayloadLang()})
+                size += *field ? (*field)->size() : 0;
+
+            for (const auto& out : ptx->Outputs())
+                size += *out.GetValue() > 0 && *out.GetAddressHash() == *ptx->GetAddress();
+        }
+
+        ankerl::nanobench::doNotOptimizeAway(size);
+    });
+}
+
+BENCHMARK(PocketTransactionBuild);
+BENCHMARK(PocketTransactionValidate);
@@ -0,0 +1,123 @@
+// Copyright (c) 2018-2022 The Pocketnet developers
+// Distributed under the Apache 2.0 software license, see the accompanying
+// https://www.apache.org/licenses/LICENSE-2.0
+
+#include <bench/bench.h>
+#include <util.h>
+
+#include "pocketdb/consensus/BlockContext.h"
+#include "pocketdb/models/dto/Comment.h"
+#include "pocketdb/models/dto/Post.h"
+#include "pocketdb/models/dto/ScoreContent.h"
+#include "pocketdb/models/dto/Subscribe.h"
+#include "pocketdb/models/dto/User.h"
+
+using namespace PocketTx;
+using namespace PocketConsensus;
+
+// Block-local part of social consensus: for every transaction of a 5000 transactions block
+// find related transactions of the same block the way validators do it.
+// Chain and mempool checks need database and are not measured here.
+
+static const int BLOCK_TXS = 5000;
+static const int ADDRESSES = 500;
+
+static PocketBlockRef MakeSocialBlock()
+{
+    auto block = make_shared<PocketBlock>();
+    auto address = [](int i) { return "address" + std::to_string(i % ADDRESSES); };
+
+    for (int i = 0; i < BLOCK_TXS; i++)
+    {
+        auto hash = "tx" + std::to_string(i);
+
+        PTransactionRef ptx;
+        switch (i % 5)
+        {
+            case 0:
+            {
+                auto user = make_shared<User>();
+                user->GeneratePayload();
+                user->GetPayload()->SetString2("name" + std::to_string(i));
+                ptx = user;
+                break;
+            }
+            case 1:
+                ptx = make_shared<Post>();
+                ptx->SetString2(hash);
+                break;
+            case 2:
+                ptx = make_shared<Comment>();
+                ptx->SetString2(hash);
+                break;
+            case 3:
+                ptx = make_shared<ScoreContent>();
+                ptx->SetString2("tx" + std::to_string(i - 2));
+                break;
+            default:
+                ptx = make_shared<Subscribe>();
+                ptx->SetString2(address(i + 1));
+                break;
+        }
+
+        ptx->SetHash(hash);
+        ptx->SetString1(address(i));
+        block->push_back(ptx);
+    }
+
+    return block;
+}
+
+static size_t LookupRelated(const SocialBlockContext& context, const PTransactionRef& ptx)
+{
+    const auto& address = *ptx->GetString1();
+    switch (*ptx->GetType())
+    {
+        case ACCOUNT_USER:
+            return context.Union(context.ByAddress(address, {ACCOUNT_USER}),
+                context.ByUserName(*static_pointer_cast<User>(ptx)->GetPayloadName())).size();
+        case CONTENT_POST:
+            return context.ByAddress(address, {CONTENT_POST}).size();
+        case CONTENT_COMMENT:
+            return context.ByAddress(address, {CONTENT_COMMENT}).size();
+        case ACTION_SCORE_CONTENT:
+            return context.ByRoot(*ptx->GetString2(), {CONTENT_POST, CONTENT_VIDEO, CONTENT_ARTICLE, CONTENT_DELETE}).size() +
+                context.ByAddress(address, {ACTION_SCORE_CONTENT}).size();
+        default:
+            return context.ByAddressTo(address, *ptx->GetString2(), {ACTION_SUBSCRIBE, ACTION_SUBSCRIBE_PRIVATE, ACTION_SUBSCRIBE_CANCEL}).size();
+    }
+}
+
+static void SocialBlockContextLookup(benchmark::Bench& bench)
+{
+    auto block = MakeSocialBlock();
+
+    bench.unit("block").run([&] {
+        SocialBlockContext context(block);
+
+        size_t found = 0;
+        for (const auto& ptx : *block)
+            found += LookupRelated(context, ptx);
+
+        ankerl::nanobench::doNotOptimizeAway(found);
+    });
+}
+
+// Former approach - every validator scans whole block
+static void SocialBlockScan(benchmark::Bench& bench)
+{
+    auto block = MakeSocialBlock();
+
+    bench.unit("block").run([&] {
+        size_t found = 0;
+        for (const auto& ptx : *block)
+            for (const auto& blockTx : *block)
+                if (*blockTx->GetType() == *ptx->GetType() && *blockTx->GetString1() == *ptx->GetString1())
+                    found += 1;
+
+        ankerl::nanobench::doNotOptimizeAway(found);
+    });
+}
+
+BENCHMARK(SocialBlockContextLookup);
+BENCHMARK(SocialBlockScan);
@@ -0,0 +1,115 @@
+// Copyright (c) 2018-2022 The Pocketnet developers
+// Distributed under the Apache 2.0 software license, see the accompanying
+// https://www.apache.org/licenses/LICENSE-2.0
+
+#include <bench/bench.h>
+#include <util.h>
+
+#include "pocketdb/consensus/ValidationQueue.h"
+#include "pocketdb/pocketnet.h"
+
+using namespace PocketConsensus;
+
+// Chain reads of social consensus for a block of 1000 subscribe transactions:
+// every job checks registrations of both accounts and the last subscription between them
+// the way SubscribeConsensus::Validate does.
+// Compare sequential run with workers reading through own connections.
+// In node the same split is reported by -debug=bench as "Consensus validation" during -reindex.
+
+static const int BLOCK_TXS = 1000;
+
+// Social graph of chain - accounts with subscriptions, so reads go through populated indexes
+static const int GRAPH_USERS = 10000;
+static const int GRAPH_SUBSCRIPTIONS = 20;
+static const int GRAPH_USERS_PER_BLOCK = 100;
+
+static std::string GraphAddress(int i)
+{
+    return "benchaddress" + std::to_string(i % GRAPH_USERS);
+}
+
+// Subscription targets of account, every account is followed by the same number of others
+static int GraphTarget(int user, int k)
+{
+    return (user + 1 + k * (GRAPH_USERS / GRAPH_SUBSCRIPTIONS)) % GRAPH_USERS;
+}
+
+static void SeedSocialGraph()
+{
+    // Rows with the same hashes are kept - datadir of previous run is already seeded
+    auto sql = strprintf(R"sql(
+        insert or ignore into Transactions (Type, Hash, Time, BlockHash, BlockNum, Height, Last, Id, String1)
+        with recursive n(i) as (select 0 union all select i + 1 from n where i < %d)
+        select 100, 'benchuser' || i, i, 'benchblock' || (i / %d), i %% %d, 1 + i / %d, 1, i, 'benchaddress' || i
+        from n;
+
+        insert or ignore into Transactions (Type, Hash, Time, BlockHash, BlockNum, Height, Last, Id, String1, String2)
+        with recursive
+            n(i) as (select 0 union all select i + 1 from n where i < %d),
+            k(j) as (select 0 union all select j + 1 from k where j < %d)
+        select 302, 'benchsubscribe' || i || '_' || j, i, 'benchblock' || (i / %d), %d + j, 1 + i / %d, 1,
+            %d + i * %d + j, 'benchaddress' || i, 'benchaddress' || ((i + 1 + j * %d) %% %d)
+        from n cross join k;
+    )sql",
+        GRAPH_USERS - 1, GRAPH_USERS_PER_BLOCK, GRAPH_USERS_PER_BLOCK, GRAPH_USERS_PER_BLOCK,
+        GRAPH_USERS - 1, GRAPH_SUBSCRIPTIONS - 1, GRAPH_USERS_PER_BLOCK, GRAPH_USERS_PER_BLOCK, GRAPH_USERS_PER_BLOCK,
+        GRAPH_USERS, GRAPH_SUBSCRIPTIONS, GRAPH_USERS / GRAPH_SUBSCRIPTIONS, GRAPH_USERS);
+
+    char* errMsg = nullptr;
+    if (sqlite3_exec(PocketDb::SQLiteDbInst.m_db, sql.c_str(), nullptr, nullptr, &errMsg) != SQLITE_OK)
+    {
+        std::string error = errMsg ? errMsg : "";
+        sqlite3_free(errMsg);
+        throw std::runtime_error("can't seed social graph: " + error);
+    }
+}
+
+static void SocialValidationReads(benchmark::Bench& bench, int threads)
+{
+    SeedSocialGraph();
+
+    PocketDb::SQLiteConsensusPoolInst.Init(std::max(threads, 1), PocketDb::SQLiteTuning::Consensus(), 0);
+
+    SocialValidationQueue queue;
+    queue.Start(threads);
+
+    // Half of block repeats existing subscriptions, half subscribes to new accounts
+    std::vector<std::vector<std::string>> addresses(BLOCK_TXS);
+    for (int i = 0; i < BLOCK_TXS; i++)
+    {
+        int user = i * (GRAPH_USERS / BLOCK_TXS);
+        int target = i % 2 == 0 ? GraphTarget(user, i % GRAPH_SUBSCRIPTIONS) : user + GRAPH_USERS / 2 + 3;
+
+        addresses[i].push_back(GraphAddress(user));
+        addresses[i].push_back(GraphAddress(target));
+    }
+
+    bench.unit("block").run([&] {
+        size_t failed = queue.Run(addresses.size(), [&](size_t i) {
+            if (!PocketDb::ConsensusRepo().ExistsUserRegistrations(addresses[i], false))
+                return false;
+
+            auto[subscribeExists, subscribeType] = PocketDb::ConsensusRepo().GetLastSubscribeType(
+                addresses[i][0], addresses[i][1]);
+
+            return !subscribeExists || subscribeType != PocketTx::ACTION_SUBSCRIBE;
+        });
+
+        ankerl::nanobench::doNotOptimizeAway(failed);
+    });
+
+    queue.Stop();
+}
+
+static void SocialValidationSequential(benchmark::Bench& bench)
+{
+    SocialValidationReads(bench, 0);
+}
+
+static void SocialValidationParallel(benchmark::Bench& bench)
+{
+    SocialValidationReads(bench, DEFAULT_SOCIAL_CHECK_THREADS);
+}
+
+BENCHMARK(SocialValidationSequential);
+BENCHMARK(SocialValidationParallel);
@@ -17,6 +17,7 @@
 #include <rpc/register.h>
 #include <walletinitinterface.h>
 #include "eventloop.h"
+#include "pocketdb/pocketnet.h"
 
 #ifdef EVENT__HAVE_NETINET_IN_H
 #include <netinet/in.h>
@@ -35,17 +36,23 @@ static const size_t MAX_HEADERS_SIZE = 8192;
 class ExecutorSqlite : public IQueueProcessor<std::unique_ptr<HTTPClosure>>
 {
 public:
-    explicit ExecutorSqlite(bool selfDbConnection)
-    {
-        if (selfDbConnection)
-            m_sqliteConnection = std::make_shared<PocketDb::SQLiteConnection>();
-    }
     void Process(std::unique_ptr<HTTPClosure> closure) override
     {
-        (*closure)(m_sqliteConnection);
+        // Connection taken from shared pool only for the time of request.
+        // Request dropped without connection is answered with error by HTTPRequest destructor.
+        DbConnectionRef sqliteConnection;
+        try
+        {
+            sqliteConnection = PocketDb::SQLiteConnectionPoolInst.Acquire();
+        }
+        catch (const std::exception& e)
+        {
+            LogPrintf("HTTP: failed to get database connection: %s\n", e.what());
+            return;
+        }
+
+        (*closure)(sqliteConnection);
     }
-private:
-    DbConnectionRef m_sqliteConnection;
 };
 
 
@@ -379,6 +386,7 @@ bool InitHTTPServer()
     RegisterMiscRPCCommands(g_socket->m_table_rpc);
     RegisterMiningRPCCommands(g_socket->m_table_rpc);
     RegisterRawTransactionRPCCommands(g_socket->m_table_rpc);
+    RegisterPocketnetPrivateRPCCommands(g_socket->m_table_rpc);
     g_wallet_init_interface.RegisterRPC(g_socket->m_table_rpc);
 #if ENABLE_ZMQ
     RegisterZMQRPCCommands(g_socket->m_table_rpc);
@@ -440,24 +448,24 @@ void StartHTTPServer()
 
     if (g_socket)
     {
-        g_socket->StartHTTPSocket(rpcMainThreads, false);
+        g_socket->StartHTTPSocket(rpcMainThreads);
         LogPrintf("HTTP: starting %d Main worker threads\n", rpcMainThreads);
     }
 
     // The same worker threads will service POST and PUBLIC RPC requests
     if (g_webSocket)
     {
-        g_webSocket->StartHTTPSocket(rpcPublicThreads, rpcPostThreads, true);
+        g_webSocket->StartHTTPSocket(rpcPublicThreads, rpcPostThreads);
         LogPrintf("HTTP: starting %d Public worker threads\n", rpcPublicThreads);
     }
     if (g_staticSocket)
     {
-        g_staticSocket->StartHTTPSocket(rpcStaticThreads, false);
+        g_staticSocket->StartHTTPSocket(rpcStaticThreads);
         LogPrintf("HTTP: starting %d Static worker threads\n", rpcStaticThreads);
     }
     if (g_restSocket)
     {
-        g_restSocket->StartHTTPSocket(rpcRestThreads, true);
+        g_restSocket->StartHTTPSocket(rpcRestThreads);
         LogPrintf("HTTP: starting %d Rest worker threads\n", rpcRestThreads);
     }
 }
@@ -578,21 +586,20 @@ HTTPSocket::~HTTPSocket()
     }
 }
 
-void HTTPSocket::StartThreads(std::shared_ptr<Queue<std::unique_ptr<HTTPClosure>>> queue, int threadCount, bool selfDbConnection)
+void HTTPSocket::StartThreads(std::shared_ptr<Queue<std::unique_ptr<HTTPClosure>>> queue, int threadCount)
 {
+    // Executor is stateless - database connections are shared between all threads through pool
+    auto execProcessor = std::make_shared<ExecutorSqlite>();
     for (int i = 0; i < threadCount; i++) {
-        // Creating exec processor for every thread to guarantee each thread will have its own sqliteConnection.
-        // If unique sqliteConnection for each thread is not required, execProcessor can be shared between threads
-        auto execProcessor = std::make_shared<ExecutorSqlite>(selfDbConnection);
-        auto thread = std::make_shared<QueueEventLoopThread<std::unique_ptr<HTTPClosure>>>(queue, std::move(execProcessor));
+        auto thread = std::make_shared<QueueEventLoopThread<std::unique_ptr<HTTPClosure>>>(queue, execProcessor);
         thread->Start("pocketcoin-httpworker");
         m_thread_http_workers.emplace_back(thread);
     }
 }
 
-void HTTPSocket::StartHTTPSocket(int threadCount, bool selfDbConnection)
+void HTTPSocket::StartHTTPSocket(int threadCount)
 {
-    StartThreads(m_workQueue, threadCount, selfDbConnection);
+    StartThreads(m_workQueue, threadCount);
 }
 
 void HTTPSocket::StopHTTPSocket()
@@ -714,7 +721,7 @@ bool HTTPSocket::HTTPReq(HTTPRequest* req, CRPCTable& table)
 
         // Set the URI
         jreq.URI = req->GetURI();
-        std::string strReply;
+        std::vector<std::shared_ptr<const std::string>> replyParts;
 
         // singleton request
         if (valRequest.isObject())
@@ -731,21 +738,23 @@ bool HTTPSocket::HTTPReq(HTTPRequest* req, CRPCTable& table)
             LogPrint(BCLog::RPC, "RPC started method %s%s (%s) with params: %s\n",
                 uri, method, rpcKey, prms);
 
-            UniValue result = table.execute(jreq);
+            auto result = table.executeSerialized(jreq);
 
             auto execute = gStatEngineInstance.GetCurrentSystemTime();
 
             LogPrint(BCLog::RPC, "RPC executed method %s%s (%s) > %.2fms\n",
                 uri, method, rpcKey, (execute.count() - start.count()));
 
-            // Send reply
-            strReply = JSONRPCReply(result, NullUniValue, jreq.id);
+            // Send reply - same as JSONRPCReply(result, NullUniValue, jreq.id) with result already serialized
+            replyParts.push_back(std::make_shared<const std::string>("{\"result\":"));
+            replyParts.push_back(result);
+            replyParts.push_back(std::make_shared<const std::string>(",\"error\":null,\"id\":" + jreq.id.write() + "}\n"));
         }
         else
         {
             if (valRequest.isArray())
             {
-                strReply = JSONRPCExecBatch(jreq, valRequest.get_array(), table);
+                replyParts.push_back(std::make_shared<const std::string>(JSONRPCExecBatch(jreq, valRequest.get_array(), table)));
             }
             else
             {
@@ -754,7 +763,7 @@ bool HTTPSocket::HTTPReq(HTTPRequest* req, CRPCTable& table)
         }
 
         req->WriteHeader("Content-Type", "application/json");
-        req->WriteReply(HTTP_OK, strReply);
+        req->WriteReply(HTTP_OK, replyParts);
     }
     catch (const UniValue& objError)
     {
@@ -801,10 +810,10 @@ HTTPWebSocket::HTTPWebSocket(struct event_base* base, int timeout, int queueDept
 
 HTTPWebSocket::~HTTPWebSocket() = default;
 
-void HTTPWebSocket::StartHTTPSocket(int threadCount, int threadPostCount, bool selfDbConnection)
+void HTTPWebSocket::StartHTTPSocket(int threadCount, int threadPostCount)
 {
-    StartThreads(m_workQueue, threadCount, selfDbConnection);
-    StartThreads(m_workPostQueue, threadPostCount, selfDbConnection);
+    StartThreads(m_workQueue, threadCount);
+    StartThreads(m_workPostQueue, threadPostCount);
 }
 
 void HTTPWebSocket::StopHTTPSocket()
@@ -906,6 +915,36 @@ void HTTPRequest::WriteReply(int nStatus, const std::string &strReply)
     struct evbuffer *evb = evhttp_request_get_output_buffer(req);
     assert(evb);
     evbuffer_add(evb, strReply.data(), strReply.size());
+    SendReply(nStatus);
+}
+
+void HTTPRequest::WriteReply(int nStatus, const std::vector<std::shared_ptr<const std::string>>& replyParts)
+{
+    assert(!replySent && req);
+
+    struct evbuffer *evb = evhttp_request_get_output_buffer(req);
+    assert(evb);
+    for (const auto& part : replyParts)
+    {
+        if (!part || part->empty())
+            continue;
+
+        // Output buffer holds own reference to the part and releases it after sending
+        auto holder = new std::shared_ptr<const std::string>(part);
+        if (evbuffer_add_reference(evb, part->data(), part->size(), [](const void*, size_t, void* extra)
+        {
+            delete static_cast<std::shared_ptr<const std::string>*>(extra);
+        }, holder) != 0)
+        {
+            delete holder;
+        }
+    }
+
+    SendReply(nStatus);
+}
+
+void HTTPRequest::SendReply(int nStatus)
+{
     auto req_copy = req;
     auto *ev = new HTTPEvent(eventBase, true, [req_copy, nStatus]
     {
@@ -79,6 +79,8 @@ private:
     struct evhttp_request* req;
     bool replySent;
 
+    void SendReply(int nStatus);
+
     DbConnectionRef dbConnection;
 
 public:
@@ -140,6 +142,12 @@ public:
      */
     void WriteReply(int nStatus, const std::string& strReply = "");
 
+    /**
+     * Write HTTP reply with body concatenated from parts.
+     * Parts are referenced by output buffer until sent, without copying.
+     */
+    void WriteReply(int nStatus, const std::vector<std::shared_ptr<const std::string>>& replyParts);
+
     void SetDbConnection(const DbConnectionRef& _dbConnection);
 
     const DbConnectionRef& DbConnection() const;
@@ -273,7 +281,7 @@ private:
     std::vector<std::shared_ptr<QueueEventLoopThread<std::unique_ptr<HTTPClosure>>>> m_thread_http_workers;
 
 protected:
-    void StartThreads(std::shared_ptr<Queue<std::unique_ptr<HTTPClosure>>> queue, int threadCount, bool selfDbConnection);
+    void StartThreads(std::shared_ptr<Queue<std::unique_ptr<HTTPClosure>>> queue, int threadCount);
 
 public:
     HTTPSocket(struct event_base* base, int timeout, int queueDepth, bool publicAccess);
@@ -289,7 +297,7 @@ public:
     std::vector<HTTPPathHandler> m_pathHandlers;
 
     /** Start worker threads to listen on bound http sockets */
-    void StartHTTPSocket(int threadCount, bool selfDbConnection);
+    void StartHTTPSocket(int threadCount);
     /** Stop worker threads on all bound http sockets */
     void StopHTTPSocket();
 
@@ -321,7 +329,7 @@ public:
     HTTPWebSocket(struct event_base* base, int timeout, int queueDepth, int queuePostDepth, bool publicAccess);
     ~HTTPWebSocket();
 
-    void StartHTTPSocket(int threadCount, int threadPostCount, bool selfDbConnection);
+    void StartHTTPSocket(int threadCount, int threadPostCount);
     void StopHTTPSocket();
     void InterruptHTTPSocket();
 };
@@ -58,6 +58,9 @@
 #include "pocketdb/SQLiteDatabase.h"
 #include "pocketdb/pocketnet.h"
 #include "pocketdb/services/ChainPostProcessing.h"
+#include "pocketdb/services/ChainReindexer.h"
+#include "pocketdb/consensus/ValidationQueue.h"
+#include "pocketdb/helpers/BlockArena.h"
 #include "pocketdb/migrations/base.h"
 #include "pocketdb/migrations/main.h"
 #include "pocketdb/migrations/web.h"
@@ -90,7 +93,7 @@ std::unique_ptr<CConnman> g_connman;
 std::unique_ptr<PeerLogicValidation> peerLogic;
 Statistic::RequestStatEngine gStatEngineInstance;
 
-std::shared_ptr<ProtectedMap<std::string, WSUser>> WSConnections;
+std::shared_ptr<WSConnectionRegistry> WSConnections;
 std::shared_ptr<QueueEventLoopThread<std::pair<CBlock, CBlockIndex*>>> notifyClientsThread;
 std::shared_ptr<Queue<std::pair<CBlock, CBlockIndex*>>> notifyClientsQueue;
 
@@ -168,13 +171,16 @@ static CScheduler scheduler;
 
 void ShutdownPocketServices()
 {
+    PocketConsensus::SocialValidationQueueInst.Stop();
+    PocketDb::SQLiteConsensusPoolInst.Shutdown();
+    PocketDb::SQLiteConnectionPoolInst.Shutdown();
+
     PocketDb::SQLiteDbInst.m_connection_mutex.lock();
 
     PocketDb::TransRepoInst.Destroy();
     PocketDb::ChainRepoInst.Destroy();
     PocketDb::RatingsRepoInst.Destroy();
     PocketDb::ConsensusRepoInst.Destroy();
-    PocketDb::NotifierRepoInst.Destroy();
 
     PocketDb::SQLiteDbInst.DetachDatabase("web");
     PocketDb::SQLiteDbInst.Close();
@@ -210,6 +216,8 @@ void Shutdown()
         return;
 
     PocketServices::WebPostProcessorInst.Stop();
+    PocketServices::WalCheckpointerInst.Stop();
+    PocketServices::FeedMaterializerInst.Stop();
     gStatEngineInstance.Stop();
 
     StopHTTPRPC();
@@ -456,6 +464,12 @@ void SetupServerArgs()
     gArgs.AddArg("-par=<n>", strprintf(
         "Set the number of script verification threads (%u to %d, 0 = auto, <0 = leave that many cores free, default: %d)",
         -GetNumCores(), MAX_SCRIPTCHECK_THREADS, DEFAULT_SCRIPTCHECK_THREADS), false, OptionsCategory::OPTIONS);
+    gArgs.AddArg("-parsocial=<n>", strprintf(
+        "Set the number of threads validating social consensus of block transactions, each with own read-only SQLite connection (0 to %d, 0 = validate sequentially, default: %d)",
+        PocketConsensus::MAX_SOCIAL_CHECK_THREADS, PocketConsensus::DEFAULT_SOCIAL_CHECK_THREADS), false, OptionsCategory::OPTIONS);
+    gArgs.AddArg("-blockarena", strprintf(
+        "Allocate pocket transactions of every received or connected block and its social consensus indexes in one arena released with the block (default: %u)",
+        PocketHelpers::DEFAULT_BLOCK_ARENA), false, OptionsCategory::OPTIONS);
     gArgs.AddArg("-persistmempool",
         strprintf("Whether to save the mempool on shutdown and load on restart (default: %u)", DEFAULT_PERSIST_MEMPOOL),
         false, OptionsCategory::OPTIONS);
@@ -476,6 +490,10 @@ void SetupServerArgs()
         "Available 0 (Disabled), 1 (Full), 2 (Only chain), 3 (Only pocket), 4 (Only pocket indexes), 5 (Only pocket WEB part)",
         false, OptionsCategory::OPTIONS);
     gArgs.AddArg("-reindex-start", "Start block for -reindex logic (Deafult: 0)", false, OptionsCategory::OPTIONS);
+    gArgs.AddArg("-reindexgroup=<n>", strprintf("Number of blocks committed in one SQLite transaction with -reindex=3 (default: %d)",
+        PocketServices::DEFAULT_REINDEX_GROUP), false, OptionsCategory::OPTIONS);
+    gArgs.AddArg("-reindexthreads=<n>", strprintf("Number of threads reading and parsing blocks ahead with -reindex=3 (1 to %d, default: %d)",
+        PocketServices::MAX_REINDEX_THREADS, PocketServices::DEFAULT_REINDEX_THREADS), false, OptionsCategory::OPTIONS);
     gArgs.AddArg("-mempoolclean", "Clean mempool on loading and delete or non blocked transactions from sqlite db", false, OptionsCategory::OPTIONS);
     gArgs.AddArg("-reindex-chainstate", "Rebuild chain state from the currently indexed blocks. When in pruning mode or if blocks on disk might be corrupted, use full -reindex instead.", false, OptionsCategory::OPTIONS);
     gArgs.AddArg("-skip-validation=<n>", "Skip consensus check and validation before N block logic if running with -reindex or -reindex-chainstate", false, OptionsCategory::OPTIONS);
@@ -602,6 +620,7 @@ void SetupServerArgs()
     gArgs.AddArg("-blockversion=<n>", "Override block version to test forking scenarios", true, OptionsCategory::BLOCK_CREATION);
 
     gArgs.AddArg("-api", strprintf("Enable Public RPC api server (default: %u)", DEFAULT_API_ENABLE), false, OptionsCategory::RPC);
+    gArgs.AddArg("-feedsnapshots", strprintf("Select candidates of hierarchical feed and hot posts once per block for all RPC requests (default: %u)", PocketServices::DEFAULT_FEED_SNAPSHOTS), false, OptionsCategory::RPC);
     gArgs.AddArg("-rest", strprintf("Accept public REST requests (default: %u)", DEFAULT_REST_ENABLE), true, OptionsCategory::RPC);
     gArgs.AddArg("-rpcallowip=<ip>", "Allow JSON-RPC connections from specified source. Valid for <ip> are a single IP (e.g. 1.2.3.4), a network/netmask (e.g. 1.2.3.4/255.255.255.0) or a network/CIDR (e.g. 1.2.3.4/24). This option can be specified multiple times", false, OptionsCategory::RPC);
     gArgs.AddArg("-rpcauth=<userpw>", "Username and hashed password for JSON-RPC connections. The field <userpw> comes in the format: <USERNAME>:<SALT>$<HASH>. A canonical python script is included in share/rpcauth. The client then connects normally using the rpcuser=<USERNAME>/rpcpassword=<PASSWORD> pair of arguments. This option can be specified multiple times", false, OptionsCategory::RPC);
@@ -613,6 +632,7 @@ void SetupServerArgs()
     gArgs.AddArg("-staticrpcport=<port>", strprintf("Listen for static JSON-RPC connections on <port> (default: %u, testnet: %u, regtest: %u)", defaultBaseParams->StaticRPCPort(), testnetBaseParams->StaticRPCPort(), regtestBaseParams->StaticRPCPort()), false, OptionsCategory::RPC);
     gArgs.AddArg("-restport=<port>", strprintf("Listen for static REST connections on <port> (default: %u, testnet: %u, regtest: %u)", defaultBaseParams->RestPort(), testnetBaseParams->RestPort(), regtestBaseParams->RestPort()), false, OptionsCategory::RPC);
     gArgs.AddArg("-wsport=<port>", strprintf("Listen for WebSocket connections on <port> (default: %u)", 8087), false, OptionsCategory::RPC);
+    gArgs.AddArg("-wssendqueue=<n>", strprintf("Drop notifications for WebSocket client with more than <n> unsent messages (default: %u)", DEFAULT_WS_SEND_QUEUE), false, OptionsCategory::RPC);
 
     gArgs.AddArg("-rpcserialversion", strprintf("Sets the serialization of raw transaction or block hex returned in non-verbose mode, non-segwit(0) or segwit(1) (default: %d)", DEFAULT_RPC_SERIALIZE_VERSION), false, OptionsCategory::RPC);
     gArgs.AddArg("-rpcservertimeout=<n>", strprintf("Timeout during HTTP requests (default: %d)", DEFAULT_HTTP_SERVER_TIMEOUT), true, OptionsCategory::RPC);
@@ -627,7 +647,7 @@ void SetupServerArgs()
     gArgs.AddArg("-rpcstaticworkqueue=<n>", strprintf("Set the depth of the work queue to service RPC (STATIC) calls (default: %d)", DEFAULT_HTTP_STATIC_WORKQUEUE), false, OptionsCategory::RPC);
     gArgs.AddArg("-rpcpostworkqueue=<n>", strprintf("Set the depth of the work queue to service RPC (POST) calls (default: %d)", DEFAULT_HTTP_POST_WORKQUEUE), false, OptionsCategory::RPC);
     gArgs.AddArg("-rpcrestworkqueue=<n>", strprintf("Set the depth of the work queue to service RPC (REST) calls (default: %d)", DEFAULT_HTTP_REST_WORKQUEUE), false, OptionsCategory::RPC);
-    gArgs.AddArg("-rpccachesize=<n>", strprintf("Maximum amount of memory in megabytes allowed for RPCcache usage (default: %d MB)", 64), false, OptionsCategory::RPC);
+    gArgs.AddArg("-rpccachesize=<n>", strprintf("Maximum amount of memory in megabytes allowed for RPCcache usage (default: %d MB)", DEFAULT_RPC_CACHE_SIZE), false, OptionsCategory::RPC);
 
     gArgs.AddArg("-statdepth=<n>", strprintf("Set the depth of the work queue for statistic in seconds (default: %ds)", 60), false, OptionsCategory::RPC);
     gArgs.AddArg("-server", "Accept command line and JSON-RPC commands", false, OptionsCategory::RPC);
@@ -635,7 +655,24 @@ void SetupServerArgs()
     // SQLite
     gArgs.AddArg("-sqltimeout", strprintf("Timeout for ReadOnly sql querys (default: %ds)", 10), false, OptionsCategory::SQLITE);
     gArgs.AddArg("-sqlsharedcache", strprintf("Experimental: enable shared cache for sqlite connections (default: disabled)"), false, OptionsCategory::SQLITE);
-    gArgs.AddArg("-sqlcachesize", strprintf("Experimental: Cache size for SQLite connection in megabytes (default: %d mb)", 5), false, OptionsCategory::SQLITE);
+    gArgs.AddArg("-sqlcachesize=<n>", strprintf("Page cache size of SQLite connection writing blocks in megabytes, 0 for SQLite default (default: %d MB)", PocketDb::DEFAULT_SQL_CACHE_SIZE), false, OptionsCategory::SQLITE);
+    gArgs.AddArg("-sqlmmapsize=<n>", strprintf("Memory mapped I/O size of SQLite connection writing blocks in megabytes, 0 to disable (default: %d MB)", PocketDb::DEFAULT_SQL_MMAP_SIZE), false, OptionsCategory::SQLITE);
+    gArgs.AddArg("-sqltempstore=<n>", strprintf("Temporary tables and indices of SQLite connection writing blocks: 0 - SQLite default, 1 - file, 2 - memory (default: %d)", PocketDb::DEFAULT_SQL_TEMP_STORE), false, OptionsCategory::SQLITE);
+    gArgs.AddArg("-sqlwalautocheckpoint=<n>", strprintf("Number of WAL pages that triggers automatic checkpoint after commit, 0 to disable (default: %d)", PocketDb::DEFAULT_SQL_WAL_AUTOCHECKPOINT), false, OptionsCategory::SQLITE);
+    gArgs.AddArg("-sqlbatchindex", strprintf("Index block transactions with set-based statements instead of per-transaction updates (default: %u)", PocketDb::DEFAULT_SQL_BATCH_INDEX), false, OptionsCategory::SQLITE);
+    gArgs.AddArg("-sqlreadpool=<n>", strprintf("Number of read-only SQLite connections shared by RPC worker threads of all sockets (default: %d)", PocketDb::DEFAULT_SQL_READ_POOL), false, OptionsCategory::SQLITE);
+    gArgs.AddArg("-sqlreadcachesize=<n>", strprintf("Page cache size of each read-only SQLite connection in megabytes, 0 for SQLite default (default: %d MB)", PocketDb::DEFAULT_SQL_READ_CACHE_SIZE), false, OptionsCategory::SQLITE);
+    gArgs.AddArg("-sqlreadmmapsize=<n>", strprintf("Memory mapped I/O size of each read-only SQLite connection in megabytes, 0 to disable (default: %d MB)", PocketDb::DEFAULT_SQL_READ_MMAP_SIZE), false, OptionsCategory::SQLITE);
+    gArgs.AddArg("-sqlreadtempstore=<n>", strprintf("Temporary tables and indices of read-only SQLite connections: 0 - SQLite default, 1 - file, 2 - memory (default: %d)", PocketDb::DEFAULT_SQL_READ_TEMP_STORE), false, OptionsCategory::SQLITE);
+    gArgs.AddArg("-sqlreadpoolcheck=<n>", strprintf("Check read-only SQLite connection idle longer than this number of seconds before reuse, 0 to disable (default: %ds)", PocketDb::DEFAULT_SQL_READ_POOL_CHECK), false, OptionsCategory::SQLITE);
+    gArgs.AddArg("-sqlcheckpoint", strprintf("Checkpoint WAL of pocket database in background thread instead of during block commits (default: %u)", PocketDb::DEFAULT_SQL_CHECKPOINT), false, OptionsCategory::SQLITE);
+    gArgs.AddArg("-sqlcheckpointinterval=<n>", strprintf("Maximum number of seconds between background WAL checkpoints (default: %ds)", PocketServices::DEFAULT_SQL_CHECKPOINT_INTERVAL), false, OptionsCategory::SQLITE);
+    gArgs.AddArg("-sqlwaltruncatesize=<n>", strprintf("Truncate WAL file larger than this number of megabytes when database is idle (default: %d MB)", PocketServices::DEFAULT_SQL_WAL_TRUNCATE_SIZE), false, OptionsCategory::SQLITE);
+    gArgs.AddArg("-sqlbulkload", strprintf("Full reindex (-reindex=1 or 3) of pocket database without fsync and with indexes of RPC built after load (default: %u)", PocketDb::DEFAULT_SQL_BULK_LOAD), false, OptionsCategory::SQLITE);
+    gArgs.AddArg("-sqlbulkcachesize=<n>", strprintf("Page cache size of SQLite connection writing blocks with -sqlbulkload in megabytes (default: %d MB)", PocketDb::DEFAULT_SQL_BULK_CACHE_SIZE), false, OptionsCategory::SQLITE);
+    gArgs.AddArg("-sqlwarmup", strprintf("Read hot indexes of pocket database in background at startup (default: %u)", PocketDb::DEFAULT_SQL_WARMUP), false, OptionsCategory::SQLITE);
+    gArgs.AddArg("-sqlstmtcache=<n>", strprintf("Number of prepared statements cached per SQLite connection, 0 to disable (default: %d)", PocketDb::DEFAULT_SQL_STATEMENT_CACHE), false, OptionsCategory::SQLITE);
+    gArgs.AddArg("-blockpayloadcache=<n>", strprintf("Maximum amount of memory in megabytes for serialized pocket payload of blocks relayed to peers, 0 to disable (default: %d MB)", PocketServices::DEFAULT_BLOCK_PAYLOAD_CACHE), false, OptionsCategory::SQLITE);
 
 
 #if HAVE_DECL_DAEMON
@@ -773,6 +810,7 @@ static void ThreadImport(std::vector<fs::path> vImportFiles)
 
     {
         CImportingNow imp;
+        bool bulkLoad = false;
 
         // -reindex
         if (IsChainReindex())
@@ -785,6 +823,12 @@ static void ThreadImport(std::vector<fs::path> vImportFiles)
                 return;
             }
 
+            if (fReindex == 1 && PocketDb::IsSQLiteBulkLoad())
+            {
+                PocketDb::SQLiteDbInst.BeginBulkLoad((int) gArgs.GetArg("-sqlbulkcachesize", PocketDb::DEFAULT_SQL_BULK_CACHE_SIZE));
+                bulkLoad = true;
+            }
+
             // Loop all block files for restore chain
             int nFile = 0;
             while (true)
@@ -846,32 +890,32 @@ static void ThreadImport(std::vector<fs::path> vImportFiles)
             int i = (int)gArgs.GetArg("-reindex-start", 0);
             LogPrintf("Start indexing pocketnet part at height %d\n", i);
 
-            PocketServices::ChainPostProcessing::Rollback(i);
-
-            while (i <= chainActive.Height() && !ShutdownRequested())
+            if (PocketDb::IsSQLiteBulkLoad())
             {
-                try
-                {
-                    CBlockIndex* pblockindex = chainActive[i];
-                    CBlock block;
-                    if (!pblockindex || !ReadBlockFromDisk(block, pblockindex, Params().GetConsensus()))
-                    {
-                        LogPrintf("Stopping after failed index pocket part\n");
-                        StartShutdown();
-                        break;
-                    }
+                PocketDb::SQLiteDbInst.DropDeferredIndexes();
+                PocketDb::SQLiteDbInst.BeginBulkLoad((int) gArgs.GetArg("-sqlbulkcachesize", PocketDb::DEFAULT_SQL_BULK_CACHE_SIZE));
+            }
 
-                    PocketServices::ChainPostProcessing::Index(block, pblockindex->nHeight);
+            PocketServices::ChainPostProcessing::Rollback(i);
 
-                    LogPrint(BCLog::SYNC, "Indexing pocketnet part at height %d\n", pblockindex->nHeight);
-                    i += 1;
-                }
-                catch (std::exception& e)
+            PocketServices::ChainReindexer reindexer(
+                [&](int height, CBlock& block)
                 {
-                    LogPrintf("Stopping after failed index pocket part: %s\n", e.what());
-                    StartShutdown();
-                    break;
-                }
+                    CBlockIndex* pblockindex = chainActive[height];
+                    return pblockindex && ReadBlockFromDisk(block, pblockindex, Params().GetConsensus());
+                },
+                (int) gArgs.GetArg("-reindexgroup", PocketServices::DEFAULT_REINDEX_GROUP),
+                (int) std::min<int64_t>(PocketServices::MAX_REINDEX_THREADS,
+                    gArgs.GetArg("-reindexthreads", PocketServices::DEFAULT_REINDEX_THREADS)));
+
+            if (!reindexer.Run(i, chainActive.Height(), [] { return ShutdownRequested(); }))
+            {
+                LogPrintf("Stopping indexing pocketnet part, continue with -reindex=3 -reindex-start=%d\n", reindexer.NextHeight());
+                StartShutdown();
+            }
+            else
+            {
+                PocketDb::SQLiteDbInst.EndBulkLoad();
             }
         }
 
@@ -939,6 +983,11 @@ static void ThreadImport(std::vector<fs::path> vImportFiles)
             //return;
         }
 
+        // Pocket part of -reindex=1 is indexed when blocks are connected above.
+        // Interrupted reindex continues on next start, remaining indexes are created with database structure
+        if (bulkLoad && !ShutdownRequested())
+            PocketDb::SQLiteDbInst.EndBulkLoad();
+
         if (gArgs.GetBoolArg("-stopafterblockimport", DEFAULT_STOPAFTERBLOCKIMPORT))
         {
             LogPrintf("Stopping after block import\n");
@@ -1563,12 +1612,12 @@ static void StartWS()
                     if (std::find(keys.begin(), keys.end(), "nonce") != keys.end())
                     {
                         WSUser wsUser = {connection, _addr, block, ip, service, mainPort, wssPort};
-                        WSConnections->insert_or_assign(connection->ID(), wsUser);
+                        WSConnections->Subscribe(connection->ID(), wsUser);
                     } else if (std::find(keys.begin(), keys.end(), "msg") != keys.end())
                     {
                         if (val["msg"].get_str() == "unsubscribe")
                         {
-                            WSConnections->erase(connection->ID());
+                            WSConnections->Unsubscribe(connection->ID());
                         }
                     }
                 }
@@ -1590,12 +1639,12 @@ static void StartWS()
 
     ws.on_close = [](std::shared_ptr<WsServer::Connection> connection, int status, const std::string& /*reason*/)
     {
-        WSConnections->erase(connection->ID());
+        WSConnections->Unsubscribe(connection->ID());
     };
 
     ws.on_error = [](std::shared_ptr<WsServer::Connection> connection, const SimpleWeb::error_code& ec)
     {
-        WSConnections->erase(connection->ID());
+        WSConnections->Unsubscribe(connection->ID());
     };
 
     server.start();
@@ -1603,7 +1652,7 @@ static void StartWS()
 
 static void InitWS()
 {
-    WSConnections = std::make_shared<ProtectedMap<std::string, WSUser>>();
+    WSConnections = std::make_shared<WSConnectionRegistry>(gArgs.GetArg("-wssendqueue", DEFAULT_WS_SEND_QUEUE));
     auto notifyProcessor = std::make_shared<NotifyBlockProcessor>(WSConnections);
     notifyClientsQueue = std::make_shared<Queue<std::pair<CBlock, CBlockIndex*>>>();
     notifyClientsThread = std::make_shared<QueueEventLoopThread<std::pair<CBlock, CBlockIndex*>>>(notifyClientsQueue, notifyProcessor);
@@ -1690,15 +1739,53 @@ bool AppInitMain()
     PocketDb::InitSQLiteCheckpoints(GetDataDir()  / "checkpoints");
 
     PocketWeb::PocketFrontendInst.Init();
+    PocketDb::SQLiteConnectionPoolInst.Init(
+        (size_t) std::max<int64_t>(1, gArgs.GetArg("-sqlreadpool", PocketDb::DEFAULT_SQL_READ_POOL)),
+        PocketDb::SQLiteTuning::Reader(),
+        (int) std::max<int64_t>(0, gArgs.GetArg("-sqlreadpoolcheck", PocketDb::DEFAULT_SQL_READ_POOL_CHECK)));
+
+    PocketHelpers::BlockArenaScope::SetEnabled(gArgs.GetBoolArg("-blockarena", PocketHelpers::DEFAULT_BLOCK_ARENA));
+
+    int nSocialCheckThreads = (int) std::min<int64_t>(PocketConsensus::MAX_SOCIAL_CHECK_THREADS,
+        std::max<int64_t>(0, gArgs.GetArg("-parsocial", PocketConsensus::DEFAULT_SOCIAL_CHECK_THREADS)));
+    LogPrintf("Using %u threads for social consensus validation\n", nSocialCheckThreads);
+    if (nSocialCheckThreads > 0)
+    {
+        PocketDb::SQLiteConsensusPoolInst.Init(nSocialCheckThreads, PocketDb::SQLiteTuning::Consensus(),
+            (int) std::max<int64_t>(0, gArgs.GetArg("-sqlreadpoolcheck", PocketDb::DEFAULT_SQL_READ_POOL_CHECK)));
+        PocketConsensus::SocialValidationQueueInst.Start(nSocialCheckThreads);
+    }
+
+    if (gArgs.GetBoolArg("-sqlwarmup", PocketDb::DEFAULT_SQL_WARMUP))
+    {
+        threadGroup.create_thread([] {
+            RenameThread("pocketcoin-sqlwarmup");
+            PocketDb::WarmUpSQLite();
+        });
+    }
+    PocketServices::BlockPayloadCacheInst.SetMaxSize(std::max<int64_t>(0, gArgs.GetArg("-blockpayloadcache", PocketServices::DEFAULT_BLOCK_PAYLOAD_CACHE)) * 1024 * 1024);
 
     if (gArgs.GetBoolArg("-api", true))
         PocketServices::WebPostProcessorInst.Start(threadGroup);
 
+    if (gArgs.GetBoolArg("-api", true) && gArgs.GetBoolArg("-feedsnapshots", PocketServices::DEFAULT_FEED_SNAPSHOTS))
+        PocketServices::FeedMaterializerInst.Start(threadGroup);
+
+    if (gArgs.GetBoolArg("-sqlcheckpoint", PocketDb::DEFAULT_SQL_CHECKPOINT))
+        PocketServices::WalCheckpointerInst.Start(threadGroup);
+
     // ********************************************************* Step 4b: Additional settings
 
     if (gArgs.GetArg("-reindex", 0) == 4)
         PocketDb::SQLiteDbInst.RebuildIndexes();
 
+    // Fill account and content counters for databases created before their tables existed
+    if (gArgs.GetArg("-reindex", 0) != 1)
+    {
+        PocketDb::ChainRepoInst.BuildAccountStats();
+        PocketDb::ChainRepoInst.BuildContentStats();
+    }
+
     // ********************************************************* Step 4b: Start servers
 
     GetMainSignals().RegisterBackgroundSignalScheduler(scheduler);
@@ -233,11 +233,13 @@ void BlockAssembler::onlyUnconfirmed(CTxMemPool::setEntries& testSet)
     }
 }
 
-bool BlockAssembler::TestTransaction(const CTransactionRef& tx, PocketBlockRef& pblockTemplate, PocketBlockRef& pblock)
+bool BlockAssembler::TestTransaction(const CTransactionRef& tx, const PocketConsensus::SocialBlockContextRef& blockContext)
 {
-    auto ptx = PocketDb::TransRepoInst.Get(tx->GetHash().GetHex(), true);
+    // Payload kept with mempool entry, operative table Transactions is a fallback
+    auto ptx = mempool.GetPocketIndex().Get(tx->GetHash().GetHex());
+    if (!ptx)
+        ptx = PocketDb::TransRepoInst.Get(tx->GetHash().GetHex(), true);
 
-    // Payload should be in operative table Transactions
     if (!ptx)
     {
         LogPrint(BCLog::CONSENSUS, "Warning: build block skip transaction %s with result 'NOT FOUND'\n",
@@ -256,7 +258,7 @@ bool BlockAssembler::TestTransaction(const CTransactionRef& tx, PocketBlockRef&
     }
 
     // Validate consensus
-    if (auto[ok, result] = PocketConsensus::SocialConsensusHelper::Validate(tx, ptx, pblockTemplate, chainActive.Height() + 1); !ok)
+    if (auto[ok, result] = PocketConsensus::SocialConsensusHelper::Validate(tx, ptx, blockContext, chainActive.Height() + 1); !ok)
     {
         LogPrint(BCLog::CONSENSUS, "Warning: build block skip transaction %s with validate result %d\n",
             tx->GetHash().GetHex(), (int) result);
@@ -265,8 +267,7 @@ bool BlockAssembler::TestTransaction(const CTransactionRef& tx, PocketBlockRef&
     }
 
     // All is good - save for descendants
-    pblockTemplate->push_back(ptx);
-    pblock->push_back(ptx);
+    blockContext->Add(ptx);
     return true;
 }
 
@@ -412,6 +413,11 @@ void BlockAssembler::addPackageTxs(int& nPackagesSelected, int& nDescendantsUpda
     const int64_t MAX_CONSECUTIVE_FAILURES = 1000;
     int64_t nConsecutiveFailed = 0;
 
+    // Pocket transactions of template indexed once and extended by every accepted package.
+    // Chain state does not change while template is built - account state is read once too
+    auto blockContext = make_shared<PocketConsensus::SocialBlockContext>(pblocktemplate->pocketBlock);
+    PocketConsensus::ConsensusAccountScope accountScope(make_shared<PocketConsensus::ConsensusAccountCache>());
+
     while (mi != mempool.mapTx.get<ancestor_score>().end() || !mapModifiedTx.empty())
     {
         // First try to find a new transaction in mapTx to evaluate.
@@ -524,18 +530,14 @@ void BlockAssembler::addPackageTxs(int& nPackagesSelected, int& nDescendantsUpda
         std::vector<CTxMemPool::txiter> sortedEntries;
         SortForBlock(ancestors, sortedEntries);
 
-        // Test pocketnet part for all ancestors
+        // Test pocketnet part for all ancestors - tested transactions are appended
+        // to template block and dropped again if any of package failed
         bool testPocketnetPart = true;
-
-        // Temporary pocketblock object for test all transactions
-        PocketBlockRef pblock = make_shared<PocketBlock>(PocketBlock{});
-        PocketBlockRef pblockTemplate = make_shared<PocketBlock>(PocketBlock{});
-        for (const auto& it : *pblocktemplate->pocketBlock)
-            pblockTemplate->push_back(it);
+        size_t templateSize = blockContext->Size();
 
         for (CTxMemPool::txiter it : sortedEntries)
         {
-            if (!TestTransaction(it->GetSharedTx(), pblockTemplate, pblock))
+            if (!TestTransaction(it->GetSharedTx(), blockContext))
             {
                 if (fUsingModified)
                 {
@@ -548,11 +550,10 @@ void BlockAssembler::addPackageTxs(int& nPackagesSelected, int& nDescendantsUpda
             }
         }
         if (!testPocketnetPart)
+        {
+            blockContext->Rollback(templateSize);
             continue;
-        
-        // Move tested pocketnet transactions to template block
-        for (const auto& it : *pblock)
-            pblocktemplate->pocketBlock->push_back(it);
+        }
 
         // This transaction will make it in; reset the failed counter.
         nConsecutiveFailed = 0;
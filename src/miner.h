@@ -183,8 +183,8 @@ private:
     /** Remove confirmed (inBlock) entries from given set */
     void onlyUnconfirmed(CTxMemPool::setEntries& testSet);
 
-    // Check transaction with AntiBot
-    bool TestTransaction(const CTransactionRef& tx, PocketBlockRef& pblockTemplate, PocketBlockRef& pblock);
+    // Check transaction with AntiBot against transactions already in template and append it on success
+    bool TestTransaction(const CTransactionRef& tx, const PocketConsensus::SocialBlockContextRef& blockContext) EXCLUSIVE_LOCKS_REQUIRED(mempool.cs);
 
     /** Test if a new package would "fit" in the block */
     bool TestPackage(uint64_t packageSize, int64_t packageSigOpsCost) const;
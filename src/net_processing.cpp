@@ -1042,16 +1042,34 @@ void PeerLogicValidation::NewPoWValidBlock(const CBlockIndex* pindex, const std:
     uint256 hashBlock(pblock->GetHash());
 
     // Get PocketData for transactions from this block
-    std::string pocketBlockData;
-    if (pocketBlock)
-        pocketBlockData = PocketServices::Serializer::SerializeBlock(*pocketBlock)->write();
-
-    if (pocketBlockData.empty() && !PocketServices::Accessor::GetBlock(*pblock, pocketBlockData))
+    PocketBlockRef pocketBlockRef = pocketBlock;
+    if (!pocketBlockRef && !PocketServices::Accessor::GetBlock(*pblock, pocketBlockRef))
     {
         LogPrintf("Error: Failed get block payload from sqlite db %s\n", pblock->GetHash().GetHex());
         return;
     }
 
+    // Payload serialized once for each format requested by peers
+    std::map<PocketServices::PayloadFormat, std::string> pocketBlockData;
+    auto getPocketBlockData = [&pocketBlockData, &pocketBlockRef, &hashBlock](int nVersion) -> const std::string&
+    {
+        auto format = PocketServices::Serializer::GetPayloadFormat(nVersion);
+        auto it = pocketBlockData.find(format);
+        if (it == pocketBlockData.end())
+        {
+            std::string data;
+            if (!PocketServices::BlockPayloadCacheInst.Get(hashBlock, format, data))
+            {
+                data = PocketServices::Serializer::SerializeBlockPayload(pocketBlockRef ? *pocketBlockRef : PocketBlock(), format);
+                PocketServices::BlockPayloadCacheInst.Put(hashBlock, format, data);
+            }
+
+            it = pocketBlockData.emplace(format, std::move(data)).first;
+        }
+
+        return it->second;
+    };
+
     {
         LOCK(cs_most_recent_block);
         most_recent_block_hash = hashBlock;
@@ -1061,7 +1079,7 @@ void PeerLogicValidation::NewPoWValidBlock(const CBlockIndex* pindex, const std:
     }
 
     connman->ForEachNode([this, &pcmpctblock, pindex, &msgMaker, fWitnessEnabled, &hashBlock,
-                          pocketBlockData](CNode* pnode)
+                          &getPocketBlockData](CNode* pnode)
     {
         AssertLockHeld(cs_main);
 
@@ -1076,7 +1094,7 @@ void PeerLogicValidation::NewPoWValidBlock(const CBlockIndex* pindex, const std:
         if (state.fPreferHeaderAndIDs && (!fWitnessEnabled || state.fWantsCmpctWitness) &&
             !PeerHasHeader(&state, pindex) && PeerHasHeader(&state, pindex->pprev))
         {
-            connman->PushMessage(pnode, msgMaker.Make(NetMsgType::CMPCTBLOCK, *pcmpctblock, pocketBlockData));
+            connman->PushMessage(pnode, msgMaker.Make(NetMsgType::CMPCTBLOCK, *pcmpctblock, getPocketBlockData(pnode->GetSendVersion())));
             state.pindexBestHeaderSent = pindex;
 
             LogPrint(BCLog::NET, "%s sending header-and-ids %s to peer=%d\n", "PeerLogicValidation::NewPoWValidBlock",
@@ -1289,6 +1307,7 @@ void static ProcessGetBlockData(CNode* pfrom, const CChainParams& chainparams, c
         }
     }
     const CNetMsgMaker msgMaker(pfrom->GetSendVersion());
+    const auto payloadFormat = PocketServices::Serializer::GetPayloadFormat(pfrom->GetSendVersion());
     // disconnect node in case we have reached the outbound limit for serving historical blocks
     // never disconnect whitelisted nodes
     if (send && connman->OutboundTargetReached(true) && (((pindexBestHeader != nullptr) && (pindexBestHeader->GetBlockTime() - pindex->GetBlockTime() > HISTORICAL_BLOCK_AGE)) || inv.type == MSG_FILTERED_BLOCK) && !pfrom->fWhitelisted) {
@@ -1326,7 +1345,7 @@ void static ProcessGetBlockData(CNode* pfrom, const CChainParams& chainparams, c
             }
 
             std::string pocketBlockData;
-            if (!PocketServices::Accessor::GetBlock(block, pocketBlockData))
+            if (!PocketServices::Accessor::GetBlock(block, pocketBlockData, payloadFormat))
             {
                 LogPrintf("WARNING! Cannot load block payload from sqlite db: %s\n", block.GetHash().GetHex());
                 return;
@@ -1347,7 +1366,7 @@ void static ProcessGetBlockData(CNode* pfrom, const CChainParams& chainparams, c
         if (pblock)
         {
             std::string pocketBlockData;
-            if (!PocketServices::Accessor::GetBlock(*pblock, pocketBlockData))
+            if (!PocketServices::Accessor::GetBlock(*pblock, pocketBlockData, payloadFormat))
             {
                 LogPrintf("WARNING! Cannot load block payload from sqlite db: %s\n", pblock->GetHash().GetHex());
                 return;
@@ -1422,6 +1441,7 @@ void static ProcessGetData(CNode* pfrom, const CChainParams& chainparams, CConnm
     std::deque<CInv>::iterator it = pfrom->vRecvGetData.begin();
     std::vector<CInv> vNotFound;
     const CNetMsgMaker msgMaker(pfrom->GetSendVersion());
+    const auto payloadFormat = PocketServices::Serializer::GetPayloadFormat(pfrom->GetSendVersion());
     {
         LOCK(cs_main);
 
@@ -1442,7 +1462,7 @@ void static ProcessGetData(CNode* pfrom, const CChainParams& chainparams, CConnm
             if (mi != mapRelay.end()) {
                 // Join PocketNet data from PocketDB to transaction stream
                 std::string txPayloadData;
-                if (PocketServices::Accessor::GetTransaction(*mi->second, txPayloadData)) {
+                if (PocketServices::Accessor::GetTransaction(*mi->second, txPayloadData, payloadFormat)) {
                     connman->PushMessage(pfrom, msgMaker.Make(nSendFlags, NetMsgType::TX, *mi->second, txPayloadData));
                     push = true;
                 }
@@ -1453,7 +1473,7 @@ void static ProcessGetData(CNode* pfrom, const CChainParams& chainparams, CConnm
                 if (txinfo.tx && txinfo.nTime <= pfrom->timeLastMempoolReq) {
                     // Join PocketNet data from PocketDB to transaction stream
                     std::string txPayloadData;
-                    if (PocketServices::Accessor::GetTransaction(*txinfo.tx, txPayloadData)) {
+                    if (PocketServices::Accessor::GetTransaction(*txinfo.tx, txPayloadData, payloadFormat)) {
                         connman->PushMessage(pfrom, msgMaker.Make(nSendFlags, NetMsgType::TX, *txinfo.tx, txPayloadData));
                         push = true;
                     }
@@ -1510,7 +1530,7 @@ inline void static SendBlockTransactions(const CBlock& block, const BlockTransac
     }
 
     std::string pocketBlockData;
-    if (!PocketServices::Accessor::GetBlock(block, pocketBlockData))
+    if (!PocketServices::Accessor::GetBlock(block, pocketBlockData, PocketServices::Serializer::GetPayloadFormat(pfrom->GetSendVersion())))
     {
         LogPrintf("Error get block data for %s from sqlite db\n", block.GetHash().GetHex());
         return;
@@ -2768,9 +2788,14 @@ bool static ProcessMessage(CNode* pfrom, const std::string& strCommand, CDataStr
                 mapBlockSource.emplace(pblock->GetHash(), std::make_pair(pfrom->GetId(), false));
             }
 
-            // Deserialize pocket part if exists
-            auto[deserializeOk, pocketBlock] = PocketServices::Serializer::DeserializeBlock(*pblock, vRecv);
-            auto pocketBlockRef = std::make_shared<PocketBlock>(pocketBlock);
+            // Deserialize pocket part if exists - models of the block share one arena
+            std::shared_ptr<PocketBlock> pocketBlockRef;
+            {
+                // Closed before ProcessNewBlock - transactions returned to mempool on reorg must not share block arena
+                PocketHelpers::BlockArenaScope arenaScope;
+                auto[deserializeOk, pocketBlock] = PocketServices::Serializer::DeserializeBlock(*pblock, vRecv);
+                pocketBlockRef = std::make_shared<PocketBlock>(pocketBlock);
+            }
 
             // Setting fForceProcessing to true means that we bypass some of
             // our anti-DoS protections in AcceptBlock, which filters
@@ -2860,8 +2885,13 @@ bool static ProcessMessage(CNode* pfrom, const std::string& strCommand, CDataStr
         } // Don't hold cs_main when we call into ProcessNewBlock
 
         if (fBlockRead) {
-            auto[deserializeOk, pocketBlock] = PocketServices::Serializer::DeserializeBlock(*pblock, vRecv);
-            auto pocketBlockRef = std::make_shared<PocketBlock>(pocketBlock);
+            std::shared_ptr<PocketBlock> pocketBlockRef;
+            {
+                // Closed before ProcessNewBlock - transactions returned to mempool on reorg must not share block arena
+                PocketHelpers::BlockArenaScope arenaScope;
+                auto[deserializeOk, pocketBlock] = PocketServices::Serializer::DeserializeBlock(*pblock, vRecv);
+                pocketBlockRef = std::make_shared<PocketBlock>(pocketBlock);
+            }
 
             bool fNewBlock = false;
             // Since we requested this block (it was in mapBlocksInFlight), force it to be processed,
@@ -2927,9 +2957,14 @@ bool static ProcessMessage(CNode* pfrom, const std::string& strCommand, CDataStr
             mapBlockSource.emplace(hash, std::make_pair(pfrom->GetId(), true));
         }
 
-        // Deserialize pocket part if exists
-        auto[deserializeOk, pocketBlock] = PocketServices::Serializer::DeserializeBlock(*pblock, vRecv);
-        auto pocketBlockRef = std::make_shared<PocketBlock>(pocketBlock);
+        // Deserialize pocket part if exists - models of the block share one arena
+        std::shared_ptr<PocketBlock> pocketBlockRef;
+        {
+            // Closed before ProcessNewBlock - transactions returned to mempool on reorg must not share block arena
+            PocketHelpers::BlockArenaScope arenaScope;
+            auto[deserializeOk, pocketBlock] = PocketServices::Serializer::DeserializeBlock(*pblock, vRecv);
+            pocketBlockRef = std::make_shared<PocketBlock>(pocketBlock);
+        }
 
         bool fNewBlock = false;
         CValidationState state;
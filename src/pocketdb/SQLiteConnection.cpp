@@ -6,18 +6,21 @@
 
 namespace PocketDb
 {
-    SQLiteConnection::SQLiteConnection()
+    SQLiteConnection::SQLiteConnection(const SQLiteTuning& tuning)
     {
         auto dbBasePath = (GetDataDir() / "pocketdb").string();
 
         SQLiteDbInst = make_shared<SQLiteDatabase>(true);
         SQLiteDbInst->Init(dbBasePath, "main");
         SQLiteDbInst->AttachDatabase("web");
+        SQLiteDbInst->ApplyTuning(tuning);
 
         WebRpcRepoInst = make_shared<WebRpcRepository>(*SQLiteDbInst);
         ExplorerRepoInst = make_shared<ExplorerRepository>(*SQLiteDbInst);
         SearchRepoInst = make_shared<SearchRepository>(*SQLiteDbInst);
+        NotifierRepoInst = make_shared<NotifierRepository>(*SQLiteDbInst);
         TransactionRepoInst = make_shared<TransactionRepository>(*SQLiteDbInst);
+        ConsensusRepoInst = make_shared<ConsensusRepository>(*SQLiteDbInst);
     }
 
     SQLiteConnection::~SQLiteConnection()
@@ -27,7 +30,9 @@ namespace PocketDb
         WebRpcRepoInst->Destroy();
         ExplorerRepoInst->Destroy();
         SearchRepoInst->Destroy();
+        NotifierRepoInst->Destroy();
         TransactionRepoInst->Destroy();
+        ConsensusRepoInst->Destroy();
 
         SQLiteDbInst->DetachDatabase("web");
         SQLiteDbInst->Close();
@@ -35,5 +40,9 @@ namespace PocketDb
         SQLiteDbInst->m_connection_mutex.unlock();
     }
 
+    bool SQLiteConnection::IsHealthy()
+    {
+        return SQLiteDbInst->IsHealthy();
+    }
 
 } // namespace PocketDb
\ No newline at end of file
@@ -10,7 +10,9 @@
 #include "pocketdb/repositories/web/WebRpcRepository.h"
 #include "pocketdb/repositories/web/ExplorerRepository.h"
 #include "pocketdb/repositories/web/SearchRepository.h"
+#include "pocketdb/repositories/web/NotifierRepository.h"
 #include "pocketdb/repositories/TransactionRepository.h"
+#include "pocketdb/repositories/ConsensusRepository.h"
 
 #include "pocketdb/web/PocketFrontend.h"
 
@@ -27,13 +29,17 @@ namespace PocketDb
 
     public:
 
-        SQLiteConnection();
+        explicit SQLiteConnection(const SQLiteTuning& tuning = SQLiteTuning());
         virtual ~SQLiteConnection();
 
+        bool IsHealthy();
+
         WebRpcRepositoryRef WebRpcRepoInst;
         ExplorerRepositoryRef ExplorerRepoInst;
         SearchRepositoryRef SearchRepoInst;
+        NotifierRepositoryRef NotifierRepoInst;
         TransactionRepositoryRef TransactionRepoInst;
+        ConsensusRepositoryRef ConsensusRepoInst;
 
     };
 
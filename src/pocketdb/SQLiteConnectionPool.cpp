@@ -0,0 +1,158 @@
+// Copyright (c) 2018-2022 The Pocketnet developers
+// Distributed under the Apache 2.0 software license, see the accompanying
+// https://www.apache.org/licenses/LICENSE-2.0
+
+#include "pocketdb/SQLiteConnectionPool.h"
+
+#include "utiltime.h"
+
+namespace PocketDb
+{
+    // Wait for free connection longer than this is reported to log
+    static const int64_t SLOW_ACQUIRE_US = 1000 * 1000;
+
+    void SQLiteConnectionPool::Init(size_t capacity, const SQLiteTuning& tuning, int checkIntervalSec)
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_capacity = max<size_t>(capacity, 1);
+        m_tuning = tuning;
+        m_checkInterval = checkIntervalSec;
+        m_shutdown = false;
+
+        LogPrintf("SQLite read pool: %d connections, cache %d MB, mmap %d MB\n", m_capacity, m_tuning.CacheSizeMb, m_tuning.MmapSizeMb);
+    }
+
+    DbConnectionRef SQLiteConnectionPool::Acquire()
+    {
+        int64_t start = GetTimeMicros();
+        Slot slot;
+        bool waited = false;
+
+        {
+            unique_lock<mutex> lock(m_mutex);
+
+            while (!m_shutdown && m_idle.empty() && m_opened >= m_capacity)
+            {
+                waited = true;
+                m_cond.wait(lock);
+            }
+
+            if (m_shutdown)
+                throw std::runtime_error("SQLite read pool is shut down");
+
+            if (!m_idle.empty())
+            {
+                slot = move(m_idle.back());
+                m_idle.pop_back();
+            }
+            else
+            {
+                // Reserve place for new connection, it is opened outside of lock
+                m_opened += 1;
+            }
+
+            int64_t waitUs = GetTimeMicros() - start;
+            m_acquired += 1;
+            if (waited)
+            {
+                m_waited += 1;
+                m_waitTotalUs += waitUs;
+                m_waitMaxUs = max(m_waitMaxUs, waitUs);
+            }
+
+            if (waitUs > SLOW_ACQUIRE_US)
+                LogPrint(BCLog::SQLBENCH, "SQLite read pool: waited %d ms for connection\n", waitUs / 1000);
+        }
+
+        if (slot.Connection && m_checkInterval > 0 && GetTime() - slot.ReleasedAt > m_checkInterval && !slot.Connection->IsHealthy())
+        {
+            LogPrintf("SQLite read pool: reopen connection failed health check\n");
+            slot.Connection.reset();
+
+            lock_guard<mutex> lock(m_mutex);
+            m_reopened += 1;
+        }
+
+        if (!slot.Connection)
+            slot.Connection = open();
+
+        // Deleter owns real connection and gives it back instead of closing
+        auto connection = slot.Connection;
+        return DbConnectionRef(connection.get(), [this, connection](SQLiteConnection*) { release(connection); });
+    }
+
+    void SQLiteConnectionPool::Shutdown()
+    {
+        vector<Slot> idle;
+
+        {
+            lock_guard<mutex> lock(m_mutex);
+            m_shutdown = true;
+            m_opened -= m_idle.size();
+            idle.swap(m_idle);
+        }
+
+        m_cond.notify_all();
+
+        // Connections closed here with destruction of slots
+    }
+
+    SQLiteConnectionPoolStats SQLiteConnectionPool::GetStats()
+    {
+        lock_guard<mutex> lock(m_mutex);
+
+        SQLiteConnectionPoolStats stats;
+        stats.Capacity = m_capacity;
+        stats.Opened = m_opened;
+        stats.Idle = m_idle.size();
+        stats.Acquired = m_acquired;
+        stats.Waited = m_waited;
+        stats.WaitTotalUs = m_waitTotalUs;
+        stats.WaitMaxUs = m_waitMaxUs;
+        stats.Reopened = m_reopened;
+        stats.Failed = m_failed;
+
+        return stats;
+    }
+
+    shared_ptr<SQLiteConnection> SQLiteConnectionPool::open()
+    {
+        try
+        {
+            return make_shared<SQLiteConnection>(m_tuning);
+        }
+        catch (const std::exception& e)
+        {
+            LogPrintf("SQLite read pool: failed open connection: %s\n", e.what());
+
+            {
+                lock_guard<mutex> lock(m_mutex);
+                m_opened -= 1;
+                m_failed += 1;
+            }
+
+            // Place reserved for this connection is free again
+            m_cond.notify_one();
+            throw;
+        }
+    }
+
+    void SQLiteConnectionPool::release(const shared_ptr<SQLiteConnection>& connection)
+    {
+        {
+            lock_guard<mutex> lock(m_mutex);
+
+            // Connection closes when deleter drops last reference
+            if (m_shutdown)
+            {
+                m_opened -= 1;
+                return;
+            }
+
+            m_idle.push_back(Slot{connection, GetTime()});
+        }
+
+        m_cond.notify_one();
+    }
+
+} // namespace PocketDb
@@ -0,0 +1,84 @@
+// Copyright (c) 2018-2022 The Pocketnet developers
+// Distributed under the Apache 2.0 software license, see the accompanying
+// https://www.apache.org/licenses/LICENSE-2.0
+
+#ifndef POCKETDB_SQLITECONNECTIONPOOL_H
+#define POCKETDB_SQLITECONNECTIONPOOL_H
+
+#include "pocketdb/SQLiteConnection.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+namespace PocketDb
+{
+    using namespace std;
+
+    static const int DEFAULT_SQL_READ_POOL = 8;
+    static const int DEFAULT_SQL_READ_POOL_CHECK = 60;
+
+    struct SQLiteConnectionPoolStats
+    {
+        size_t Capacity = 0;
+        size_t Opened = 0;
+        size_t Idle = 0;
+        int64_t Acquired = 0;
+        int64_t Waited = 0;
+        int64_t WaitTotalUs = 0;
+        int64_t WaitMaxUs = 0;
+        int64_t Reopened = 0;
+        int64_t Failed = 0;
+    };
+
+    // Shared pool of read-only connections for RPC workers of all HTTP sockets.
+    // Connections are opened on demand up to capacity and handed out for the time of one request,
+    // so number of open connections (and memory for their page caches) does not depend on
+    // number of worker threads. Connection idle longer than check interval is verified before
+    // reuse and reopened if it can not read database anymore.
+    class SQLiteConnectionPool
+    {
+    public:
+        void Init(size_t capacity, const SQLiteTuning& tuning, int checkIntervalSec);
+
+        // Blocks until connection is available. Connection goes back to pool when last reference released.
+        DbConnectionRef Acquire();
+
+        // Close idle connections and refuse new requests. Connections in use closed on release.
+        void Shutdown();
+
+        SQLiteConnectionPoolStats GetStats();
+
+    private:
+        struct Slot
+        {
+            shared_ptr<SQLiteConnection> Connection;
+            int64_t ReleasedAt = 0;
+        };
+
+        mutex m_mutex;
+        condition_variable m_cond;
+
+        size_t m_capacity = 0;
+        SQLiteTuning m_tuning;
+        int64_t m_checkInterval = 0;
+        bool m_shutdown = false;
+
+        // Most recently released at back - reusing it first keeps pages of busy connections warm
+        vector<Slot> m_idle;
+        size_t m_opened = 0;
+
+        int64_t m_acquired = 0;
+        int64_t m_waited = 0;
+        int64_t m_waitTotalUs = 0;
+        int64_t m_waitMaxUs = 0;
+        int64_t m_reopened = 0;
+        int64_t m_failed = 0;
+
+        shared_ptr<SQLiteConnection> open();
+        void release(const shared_ptr<SQLiteConnection>& connection);
+    };
+
+} // namespace PocketDb
+
+#endif // POCKETDB_SQLITECONNECTIONPOOL_H
@@ -5,6 +5,7 @@
 #include "pocketdb/SQLiteDatabase.h"
 #include "pocketdb/pocketnet.h"
 #include "util.h"
+#include "shutdown.h"
 
 namespace PocketDb
 {
@@ -51,13 +52,13 @@ namespace PocketDb
         InitializeSqlite();
         PocketDbMigrationRef mainDbMigration = std::make_shared<PocketDbMainMigration>();
         PocketDb::SQLiteDbInst.Init(dbBasePath, "main", mainDbMigration);
-        SQLiteDbInst.CreateStructure();
+        SQLiteDbInst.ApplyTuning(SQLiteTuning::Writer());
+        SQLiteDbInst.CreateStructure(IsSQLiteBulkLoad());
 
         TransRepoInst.Init();
         ChainRepoInst.Init();
         RatingsRepoInst.Init();
         ConsensusRepoInst.Init();
-        NotifierRepoInst.Init();
 
         // Open, create structure and close `web` db
         PocketDbMigrationRef webDbMigration = std::make_shared<PocketDbWebMigration>();
@@ -88,6 +89,116 @@ namespace PocketDb
 
     }
 
+    // Hot indexes of feeds and explorer queries
+    static const vector<pair<string, string>> WARMUP_INDEXES = {
+        { "Transactions", "Transactions_Type_Last_String1_Height_Id" },
+        { "Ratings", "Ratings_Type_Id_Last_Height" },
+        { "Payload", "Payload_String1_TxHash" },
+    };
+
+    static int WarmUpProgress(void*)
+    {
+        return ShutdownRequested() ? 1 : 0;
+    }
+
+    void WarmUpSQLite()
+    {
+        try
+        {
+            // Pages are read through the same tuning as read pool, so with mmap enabled
+            // they stay in OS page cache shared with pooled connections
+            SQLiteDatabase db(true);
+            db.Init((GetDataDir() / "pocketdb").string(), "main");
+            db.ApplyTuning(SQLiteTuning::Reader());
+            sqlite3_progress_handler(db.m_db, 10000, WarmUpProgress, nullptr);
+
+            for (const auto& [table, index] : WARMUP_INDEXES)
+            {
+                int64_t nTime1 = GetTimeMicros();
+
+                // Counting through forced index walks every page of its b-tree
+                string sql = "select count(*) from " + table + " indexed by " + index + ";";
+                int res = sqlite3_exec(db.m_db, sql.c_str(), nullptr, nullptr, nullptr);
+                if (res != SQLITE_OK)
+                {
+                    LogPrintf("SQLite warm-up: %s skipped: %s\n", index, sqlite3_errmsg(db.m_db));
+                    if (res == SQLITE_INTERRUPT)
+                        break;
+
+                    continue;
+                }
+
+                int64_t nTime2 = GetTimeMicros();
+                LogPrintf("SQLite warm-up: %s loaded in %.2fs\n", index, 0.000001 * (double)(nTime2 - nTime1));
+            }
+
+            db.Close();
+        }
+        catch (const std::exception& e)
+        {
+            LogPrintf("SQLite warm-up failed: %s\n", e.what());
+        }
+    }
+
+    bool IsSQLiteBulkLoad()
+    {
+        auto reindex = gArgs.GetArg("-reindex", 0);
+        return gArgs.GetBoolArg("-sqlbulkload", DEFAULT_SQL_BULK_LOAD) && (reindex == 1 || reindex == 3);
+    }
+
+    // Names of indexes in "create index if not exists <name> on ..." statements
+    static vector<string> IndexNames(const string& sql)
+    {
+        vector<string> names;
+
+        const string prefix = "index if not exists ";
+        for (size_t pos = sql.find(prefix); pos != string::npos; pos = sql.find(prefix, pos))
+        {
+            pos += prefix.size();
+            names.push_back(sql.substr(pos, sql.find(' ', pos) - pos));
+        }
+
+        return names;
+    }
+
+    SQLiteTuning SQLiteTuning::Writer()
+    {
+        SQLiteTuning tuning;
+        tuning.CacheSizeMb = (int) max<int64_t>(0, gArgs.GetArg("-sqlcachesize", DEFAULT_SQL_CACHE_SIZE));
+        tuning.MmapSizeMb = (int) max<int64_t>(0, gArgs.GetArg("-sqlmmapsize", DEFAULT_SQL_MMAP_SIZE));
+        tuning.TempStore = (int) gArgs.GetArg("-sqltempstore", DEFAULT_SQL_TEMP_STORE);
+        tuning.WalAutocheckpoint = (int) gArgs.GetArg("-sqlwalautocheckpoint", DEFAULT_SQL_WAL_AUTOCHECKPOINT);
+
+        // Background checkpointer takes over - commits of blocks do not stall on checkpoint
+        if (gArgs.GetBoolArg("-sqlcheckpoint", DEFAULT_SQL_CHECKPOINT))
+            tuning.WalAutocheckpoint = 0;
+        return tuning;
+    }
+
+    SQLiteTuning SQLiteTuning::Reader()
+    {
+        // Read-only connections never commit, so never run automatic checkpoint
+        SQLiteTuning tuning;
+        tuning.CacheSizeMb = (int) max<int64_t>(0, gArgs.GetArg("-sqlreadcachesize", DEFAULT_SQL_READ_CACHE_SIZE));
+        tuning.MmapSizeMb = (int) max<int64_t>(0, gArgs.GetArg("-sqlreadmmapsize", DEFAULT_SQL_READ_MMAP_SIZE));
+        tuning.TempStore = (int) gArgs.GetArg("-sqlreadtempstore", DEFAULT_SQL_READ_TEMP_STORE);
+        return tuning;
+    }
+
+    SQLiteTuning SQLiteTuning::Consensus()
+    {
+        SQLiteTuning tuning = Reader();
+        tuning.QueryTimeout = false;
+        return tuning;
+    }
+
+    SQLiteTuning SQLiteTuning::Verification()
+    {
+        SQLiteTuning tuning = Reader();
+        tuning.QueryTimeout = false;
+        return tuning;
+    }
+
     SQLiteDatabase::SQLiteDatabase(bool readOnly) : isReadOnlyConnect(readOnly)
     {
     }
@@ -137,12 +248,15 @@ namespace PocketDb
 
     bool SQLiteDatabase::IsReadOnly() const { return isReadOnlyConnect; }
 
+    bool SQLiteDatabase::IsQueryTimeout() const { return isReadOnlyConnect && m_queryTimeout; }
+
     void SQLiteDatabase::Init(const std::string& dbBasePath, const std::string& dbName, const PocketDbMigrationRef& migration, bool drop)
     {
         m_db_migration = migration;
         m_db_path = dbBasePath;
         fs::path dbPath(m_db_path);
         m_file_path = dbName + ".sqlite3";
+        m_stmt_cache.SetCapacity((size_t) max<int64_t>(0, gArgs.GetArg("-sqlstmtcache", DEFAULT_SQL_STATEMENT_CACHE)));
 
         // Create directory structure
         try
@@ -208,17 +322,9 @@ namespace PocketDb
             {
                 if (sqlite3_exec(m_db, "PRAGMA journal_mode = wal;", nullptr, nullptr, nullptr) != 0)
                     throw std::runtime_error("Failed apply journal_mode = wal");
-
-                // if (sqlite3_exec(m_db, "PRAGMA temp_store = memory;", nullptr, nullptr, nullptr) != 0)
-                //     throw std::runtime_error("Failed apply temp_store = memory");
             }
 
-            // TODO (tawmaz): Not working for existed database
-            // int cacheSize = gArgs.GetArg("-sqlcachesize", 5);
-            // int pageCount = cacheSize * 1024 * 1024 / 4096;
-            // string cmd = "PRAGMA cache_size = " + to_string(pageCount) + ";";
-            // if (sqlite3_exec(m_db, cmd.c_str(), nullptr, nullptr, nullptr) != 0)
-            //     throw std::runtime_error("Failed to apply cache size");
+            // Page cache, mmap and temp store are set with ApplyTuning() by owner of connection
         }
         catch (const std::runtime_error&)
         {
@@ -228,7 +334,7 @@ namespace PocketDb
         }
     }
 
-    void SQLiteDatabase::CreateStructure()
+    void SQLiteDatabase::CreateStructure(bool deferIndexes)
     {
         assert(m_db && m_db_migration);
 
@@ -257,6 +363,9 @@ namespace PocketDb
             if (!BulkExecute(m_db_migration->Indexes()))
                 throw std::runtime_error(strprintf("%s: Failed to create database `%s` structure (Indexes)\n", __func__, m_file_path));
 
+            if (!deferIndexes && !BulkExecute(m_db_migration->DeferredIndexes()))
+                throw std::runtime_error(strprintf("%s: Failed to create database `%s` structure (DeferredIndexes)\n", __func__, m_file_path));
+
             if (!BulkExecute(m_db_migration->PostProcessing()))
                 throw std::runtime_error(strprintf("%s: Failed to create database `%s` structure (PostProcessing)\n", __func__, m_file_path));
         }
@@ -268,6 +377,9 @@ namespace PocketDb
 
     void SQLiteDatabase::DropIndexes()
     {
+        // Cached statements can reference dropped indexes
+        m_stmt_cache.Clear();
+
         std::string indexesDropSql;
 
         // Get all indexes in DB
@@ -290,6 +402,7 @@ namespace PocketDb
                 indexesDropSql += ";\n";
             }
 
+            sqlite3_finalize(stmt);
             CommitTransaction();
         }
         catch (const std::exception& ex)
@@ -304,6 +417,9 @@ namespace PocketDb
 
     void SQLiteDatabase::Close()
     {
+        // sqlite3_close fails while prepared statements exists
+        m_stmt_cache.Clear();
+
         int res = sqlite3_close(m_db);
         if (res != SQLITE_OK)
             LogPrintf("Error: %s: %d; Failed to close database %s: %s\n", __func__, res, m_file_path, sqlite3_errstr(res));
@@ -311,8 +427,17 @@ namespace PocketDb
         m_db = nullptr;
     }
 
+    bool SQLiteDatabase::InGroup() const
+    {
+        return m_groupOwner.load() == std::this_thread::get_id();
+    }
+
     bool SQLiteDatabase::BeginTransaction()
     {
+        // Already holding connection - false if group was rolled back
+        if (InGroup())
+            return sqlite3_get_autocommit(m_db) == 0;
+
         m_connection_mutex.lock();
 
         if (!m_db || sqlite3_get_autocommit(m_db) == 0) return false;
@@ -325,6 +450,9 @@ namespace PocketDb
 
     bool SQLiteDatabase::CommitTransaction()
     {
+        if (InGroup())
+            return sqlite3_get_autocommit(m_db) == 0;
+
         if (!m_db || sqlite3_get_autocommit(m_db) != 0) return false;
         int res = sqlite3_exec(m_db, "COMMIT TRANSACTION", nullptr, nullptr, nullptr);
         if (res != SQLITE_OK)
@@ -342,11 +470,50 @@ namespace PocketDb
         if (res != SQLITE_OK)
             LogPrintf("%s: %d; Failed to abort the transaction: %s\n", __func__, res, sqlite3_errstr(res));
 
-        m_connection_mutex.unlock();
+        // Connection stays with group until AbortGroup
+        if (!InGroup())
+            m_connection_mutex.unlock();
 
         return res == SQLITE_OK;
     }
 
+    bool SQLiteDatabase::BeginGroup()
+    {
+        if (!BeginTransaction())
+            return false;
+
+        m_groupOwner = std::this_thread::get_id();
+        return true;
+    }
+
+    bool SQLiteDatabase::CommitGroup()
+    {
+        if (!InGroup()) return false;
+        m_groupOwner = std::thread::id();
+
+        if (sqlite3_get_autocommit(m_db) != 0)
+        {
+            m_connection_mutex.unlock();
+            return false;
+        }
+
+        return CommitTransaction();
+    }
+
+    void SQLiteDatabase::AbortGroup()
+    {
+        if (!InGroup()) return;
+        m_groupOwner = std::thread::id();
+
+        if (sqlite3_get_autocommit(m_db) != 0)
+        {
+            m_connection_mutex.unlock();
+            return;
+        }
+
+        AbortTransaction();
+    }
+
     void SQLiteDatabase::InterruptQuery()
     {
         if (m_db)
@@ -359,6 +526,7 @@ namespace PocketDb
 
         fs::path dbPath(m_db_path);
         string cmnd = "attach database '" + (dbPath / (dbName + ".sqlite3")).string() + "' as " + dbName + ";";
+        m_stmt_cache.Clear();
         if (sqlite3_exec(m_db, cmnd.c_str(), nullptr, nullptr, nullptr) != 0)
             throw std::runtime_error("Failed attach database " + dbName);
     }
@@ -369,18 +537,171 @@ namespace PocketDb
 
         fs::path dbPath(m_db_path);
         string cmnd = "detach " + dbName + ";";
+        m_stmt_cache.Clear();
         if (sqlite3_exec(m_db, cmnd.c_str(), nullptr, nullptr, nullptr) != 0)
             throw std::runtime_error("Failed detach database " + dbName);
     }
 
+    void SQLiteDatabase::DropDeferredIndexes()
+    {
+        // Cached statements can reference dropped indexes
+        m_stmt_cache.Clear();
+
+        string sql;
+        for (const auto& name : IndexNames(m_db_migration->DeferredIndexes()))
+            sql += "drop index if exists " + name + ";\n";
+
+        LogPrintf("Deleting deferred database indexes..\n");
+        if (!BulkExecute(sql))
+            throw std::runtime_error(strprintf("%s: Failed drop deferred indexes\n", __func__));
+    }
+
+    void SQLiteDatabase::CreateDeferredIndexes()
+    {
+        LogPrintf("Creating deferred database indexes..\n");
+        BuildIndexes(m_db_migration->DeferredIndexes());
+    }
+
     void SQLiteDatabase::RebuildIndexes()
     {
         LogPrintf("Deleting database indexes..\n");
         DropIndexes();
 
         LogPrintf("Creating database indexes..\n");
+        BuildIndexes(m_db_migration->Indexes() + m_db_migration->DeferredIndexes());
         CreateStructure();
     }
 
+    void SQLiteDatabase::BuildIndexes(const string& sql)
+    {
+        vector<string> statements;
+        for (size_t begin = 0, end; (end = sql.find(';', begin)) != string::npos; begin = end + 1)
+            if (sql.find("create ", begin) < end)
+                statements.push_back(sql.substr(begin, end - begin + 1));
+
+        // Every index is built in own transaction by one table scan and sort - sorter may use helper threads
+        SetPragma("threads", to_string(min(8u, max(1u, std::thread::hardware_concurrency()))));
+
+        auto names = IndexNames(sql);
+        int64_t startTime = GetTimeMicros();
+        for (size_t i = 0; i < statements.size(); i++)
+        {
+            int64_t nTime1 = GetTimeMicros();
+
+            if (!BulkExecute(statements[i]))
+                throw std::runtime_error(strprintf("%s: Failed to build index %s\n", __func__, i < names.size() ? names[i] : ""));
+
+            int64_t nTime2 = GetTimeMicros();
+            LogPrintf("Building database indexes: %d of %d (%s) in %.2fs\n", i + 1, statements.size(),
+                i < names.size() ? names[i] : "", 0.000001 * (double)(nTime2 - nTime1));
+        }
+
+        SetPragma("threads", "0");
+        LogPrintf("Building database indexes finished in %.2fm\n", 0.000001 * (double)(GetTimeMicros() - startTime) / 60.0);
+    }
+
+    void SQLiteDatabase::BeginBulkLoad(int cacheSizeMb)
+    {
+        if (m_bulkLoad)
+            return;
+
+        lock_guard<mutex> lock(m_connection_mutex);
+
+        m_bulkSynchronous = GetPragma("synchronous");
+        m_bulkCacheSize = GetPragma("cache_size");
+
+        SetPragma("synchronous", "OFF");
+        if (cacheSizeMb > 0)
+            SetPragma("cache_size", to_string(-(int64_t) cacheSizeMb * 1024));
+
+        m_bulkLoad = true;
+        LogPrintf("SQLite bulk load: synchronous = OFF, cache %d MB, deferred indexes are built after load\n", cacheSizeMb);
+    }
+
+    void SQLiteDatabase::EndBulkLoad()
+    {
+        if (!m_bulkLoad)
+            return;
+
+        CreateDeferredIndexes();
+
+        lock_guard<mutex> lock(m_connection_mutex);
+
+        SetPragma("synchronous", m_bulkSynchronous);
+        SetPragma("cache_size", m_bulkCacheSize);
+
+        m_bulkLoad = false;
+        LogPrintf("SQLite bulk load finished\n");
+    }
+
+    string SQLiteDatabase::GetPragma(const string& name)
+    {
+        assert(m_db);
+
+        string result;
+        string cmnd = "PRAGMA " + name + ";";
+
+        sqlite3_stmt* stmt;
+        if (sqlite3_prepare_v2(m_db, cmnd.c_str(), (int) cmnd.size(), &stmt, nullptr) != SQLITE_OK)
+            throw std::runtime_error(strprintf("Failed read %s: %s", name, sqlite3_errmsg(m_db)));
+
+        if (sqlite3_step(stmt) == SQLITE_ROW && sqlite3_column_text(stmt, 0))
+            result = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+
+        sqlite3_finalize(stmt);
+        return result;
+    }
+
+    void SQLiteDatabase::SetPragma(const string& name, const string& value)
+    {
+        assert(m_db);
+
+        string cmnd = "PRAGMA " + name + " = " + value + ";";
+        if (sqlite3_exec(m_db, cmnd.c_str(), nullptr, nullptr, nullptr) != SQLITE_OK)
+            throw std::runtime_error(strprintf("Failed apply %s = %s: %s", name, value, sqlite3_errmsg(m_db)));
+    }
+
+    void SQLiteDatabase::ApplyTuning(const SQLiteTuning& tuning)
+    {
+        m_queryTimeout = tuning.QueryTimeout;
+
+        // Negative cache_size is amount of memory in kibibytes instead of pages
+        if (tuning.CacheSizeMb > 0)
+            SetPragma("cache_size", to_string(-(int64_t) tuning.CacheSizeMb * 1024));
+
+        if (tuning.MmapSizeMb > 0)
+            SetPragma("mmap_size", to_string((int64_t) tuning.MmapSizeMb * 1024 * 1024));
+
+        if (tuning.TempStore > 0 && tuning.TempStore <= 2)
+            SetPragma("temp_store", to_string(tuning.TempStore));
+
+        if (!isReadOnlyConnect && tuning.WalAutocheckpoint >= 0)
+            SetPragma("wal_autocheckpoint", to_string(tuning.WalAutocheckpoint));
+    }
+
+    bool SQLiteDatabase::IsHealthy()
+    {
+        if (!m_db)
+            return false;
+
+        lock_guard<mutex> lock(m_connection_mutex);
+        return sqlite3_exec(m_db, "select 1 from sqlite_master limit 1;", nullptr, nullptr, nullptr) == SQLITE_OK;
+    }
+
+    int SQLiteDatabase::PrepareStatement(const string& sql, sqlite3_stmt** stmt)
+    {
+        return m_stmt_cache.Acquire(m_db, sql, stmt);
+    }
+
+    int SQLiteDatabase::ReleaseStatement(sqlite3_stmt* stmt)
+    {
+        return m_stmt_cache.Release(stmt);
+    }
+
+    SQLiteStatementCacheStats SQLiteDatabase::GetStatementCacheStats() const
+    {
+        return m_stmt_cache.GetStats();
+    }
+
 } // namespace PocketDb
 
@@ -11,20 +11,65 @@
 #include "fs.h"
 
 #include <sqlite3.h>
+#include <atomic>
 #include <iostream>
+#include <thread>
 
 #include "pocketdb/migrations/base.h"
 #include "pocketdb/migrations/main.h"
 #include "pocketdb/migrations/web.h"
+#include "pocketdb/SQLiteStatementCache.h"
 
 namespace PocketDb
 {
     using namespace std;
 
+    static const int DEFAULT_SQL_STATEMENT_CACHE = 128;
+
+    static const int DEFAULT_SQL_CACHE_SIZE = 0;
+    static const int DEFAULT_SQL_MMAP_SIZE = 0;
+    static const int DEFAULT_SQL_TEMP_STORE = 0;
+    static const int DEFAULT_SQL_WAL_AUTOCHECKPOINT = 1000;
+    static const int DEFAULT_SQL_READ_CACHE_SIZE = 16;
+    static const int DEFAULT_SQL_READ_MMAP_SIZE = 0;
+    static const int DEFAULT_SQL_READ_TEMP_STORE = 0;
+    static const bool DEFAULT_SQL_WARMUP = false;
+    static const bool DEFAULT_SQL_CHECKPOINT = true;
+    static const bool DEFAULT_SQL_BULK_LOAD = false;
+    static const int DEFAULT_SQL_BULK_CACHE_SIZE = 1024;
+
+    // Pragmas applied to connection right after open
+    struct SQLiteTuning
+    {
+        // Megabytes, zero keeps SQLite default
+        int CacheSizeMb = 0;
+        int MmapSizeMb = 0;
+        // 0 - default, 1 - file, 2 - memory
+        int TempStore = 0;
+        // Pages in WAL before automatic checkpoint by committing connection, negative keeps SQLite default
+        int WalAutocheckpoint = -1;
+        // Read-only connection interrupts queries longer than -sqltimeout
+        bool QueryTimeout = true;
+
+        // Tuning of connection writing blocks and of read-only connections serving RPC
+        static SQLiteTuning Writer();
+        static SQLiteTuning Reader();
+        // Read-only connections of consensus validation - result must not depend on query time
+        static SQLiteTuning Consensus();
+        // Read-only connection of verification RPC - full scans of tables must not be interrupted
+        static SQLiteTuning Verification();
+    };
+
     void InitSQLite(fs::path path);
 
     void InitSQLiteCheckpoints(fs::path path);
 
+    // Read hot indexes of main database once so first requests after start do not wait for disk
+    void WarmUpSQLite();
+
+    // Full reindex of pocket part (-reindex=1 or 3) with -sqlbulkload
+    bool IsSQLiteBulkLoad();
+
     class SQLiteDatabase
     {
     private:
@@ -32,9 +77,24 @@ namespace PocketDb
         string m_file_path;
         string m_db_path;
         bool isReadOnlyConnect;
+        bool m_queryTimeout = true;
+        SQLiteStatementCache m_stmt_cache;
 
         bool BulkExecute(string sql);
 
+        // Thread holding connection for group of transactions
+        atomic<std::thread::id> m_groupOwner{};
+        bool InGroup() const;
+
+        // Pragmas to restore after bulk load
+        bool m_bulkLoad = false;
+        string m_bulkSynchronous;
+        string m_bulkCacheSize;
+
+        // Execute "create index" statements one by one with progress in log
+        void BuildIndexes(const string& sql);
+        string GetPragma(const string& name);
+
     public:
         sqlite3* m_db{nullptr};
         mutex m_connection_mutex;
@@ -42,12 +102,16 @@ namespace PocketDb
         explicit SQLiteDatabase(bool readOnly);
 
         bool IsReadOnly() const;
+        bool IsQueryTimeout() const;
 
         void Init(const std::string& dbBasePath, const string& dbName, const PocketDbMigrationRef& migration = nullptr, bool drop = false);
 
-        void CreateStructure();
+        // With deferIndexes only indexes read while indexing blocks are created, see DeferredIndexes()
+        void CreateStructure(bool deferIndexes = false);
 
         void DropIndexes();
+        void DropDeferredIndexes();
+        void CreateDeferredIndexes();
 
         void Cleanup() noexcept;
 
@@ -59,12 +123,38 @@ namespace PocketDb
 
         bool AbortTransaction();
 
+        // Group of transactions of calling thread: nested Begin/CommitTransaction of that thread
+        // join one transaction, so many small writes are committed and synced once.
+        // Failed transaction inside group rolls back the whole group.
+        bool BeginGroup();
+        bool CommitGroup();
+        void AbortGroup();
+
         void InterruptQuery();
 
         void DetachDatabase(const string& dbName);
         void AttachDatabase(const string& dbName);
 
         void RebuildIndexes();
+
+        // Relaxed durability and large page cache while chain is indexed from scratch - crash during load
+        // may lose recent blocks, which reindex writes again anyway. EndBulkLoad builds deferred indexes
+        // and restores pragmas.
+        void BeginBulkLoad(int cacheSizeMb);
+        void EndBulkLoad();
+
+        // Apply "PRAGMA <name> = <value>" to opened connection
+        void SetPragma(const string& name, const string& value);
+
+        void ApplyTuning(const SQLiteTuning& tuning);
+
+        // Cheap read of schema to check connection still works with database file
+        bool IsHealthy();
+
+        // Prepared statements reused through per-connection LRU cache
+        int PrepareStatement(const string& sql, sqlite3_stmt** stmt);
+        int ReleaseStatement(sqlite3_stmt* stmt);
+        SQLiteStatementCacheStats GetStatementCacheStats() const;
     };
 
     typedef shared_ptr<SQLiteDatabase> SQLiteDatabaseRef;
@@ -0,0 +1,168 @@
+// Copyright (c) 2018-2022 The Pocketnet developers
+// Distributed under the Apache 2.0 software license, see the accompanying
+// https://www.apache.org/licenses/LICENSE-2.0
+
+#include "pocketdb/SQLiteStatementCache.h"
+
+#include <vector>
+
+namespace PocketDb
+{
+    SQLiteStatementCache::SQLiteStatementCache(size_t capacity) : m_capacity(capacity)
+    {
+    }
+
+    SQLiteStatementCache::~SQLiteStatementCache()
+    {
+        Clear();
+    }
+
+    void SQLiteStatementCache::SetCapacity(size_t capacity)
+    {
+        vector<sqlite3_stmt*> evicted;
+
+        {
+            lock_guard<mutex> lock(m_mutex);
+            m_capacity = capacity;
+
+            while (m_lru.size() > m_capacity)
+            {
+                auto& victim = m_lru.back();
+                m_index.erase(string_view(victim.Sql));
+                evicted.push_back(victim.Stmt);
+                m_lru.pop_back();
+                m_evictions += 1;
+            }
+        }
+
+        for (auto* stmt : evicted)
+            sqlite3_finalize(stmt);
+    }
+
+    int SQLiteStatementCache::Acquire(sqlite3* db, const string& sql, sqlite3_stmt** stmt)
+    {
+        bool enabled;
+
+        {
+            lock_guard<mutex> lock(m_mutex);
+            enabled = m_capacity > 0;
+
+            if (enabled)
+            {
+                if (auto it = m_index.find(string_view(sql)); it != m_index.end())
+                {
+                    auto entry = it->second;
+                    m_index.erase(it);
+
+                    *stmt = entry->Stmt;
+                    m_checkedOut.emplace(entry->Stmt, CheckedOut{move(entry->Sql), m_generation});
+                    m_lru.erase(entry);
+
+                    m_hits += 1;
+                    return SQLITE_OK;
+                }
+
+                m_misses += 1;
+            }
+        }
+
+        int res = sqlite3_prepare_v2(db, sql.c_str(), (int) sql.size(), stmt, nullptr);
+        if (res != SQLITE_OK || !enabled || *stmt == nullptr)
+            return res;
+
+        lock_guard<mutex> lock(m_mutex);
+        m_checkedOut.emplace(*stmt, CheckedOut{sql, m_generation});
+
+        return res;
+    }
+
+    int SQLiteStatementCache::Release(sqlite3_stmt* stmt)
+    {
+        if (!stmt)
+            return SQLITE_OK;
+
+        string sql;
+        uint64_t generation;
+
+        {
+            lock_guard<mutex> lock(m_mutex);
+
+            auto it = m_checkedOut.find(stmt);
+            if (it == m_checkedOut.end())
+                return sqlite3_finalize(stmt);
+
+            sql = move(it->second.Sql);
+            generation = it->second.Generation;
+            m_checkedOut.erase(it);
+        }
+
+        // Result of reset repeats the error of last step same as finalize
+        int res = sqlite3_reset(stmt);
+        sqlite3_clear_bindings(stmt);
+
+        vector<sqlite3_stmt*> evicted;
+
+        {
+            lock_guard<mutex> lock(m_mutex);
+
+            // Statement prepared before Clear() or duplicate of already cached statement
+            if (generation != m_generation || m_capacity == 0 || m_index.find(string_view(sql)) != m_index.end())
+            {
+                evicted.push_back(stmt);
+            }
+            else
+            {
+                m_lru.push_front(Entry{move(sql), stmt});
+                m_index.emplace(string_view(m_lru.front().Sql), m_lru.begin());
+
+                while (m_lru.size() > m_capacity)
+                {
+                    auto& victim = m_lru.back();
+                    m_index.erase(string_view(victim.Sql));
+                    evicted.push_back(victim.Stmt);
+                    m_lru.pop_back();
+                    m_evictions += 1;
+                }
+            }
+        }
+
+        for (auto* victim : evicted)
+            sqlite3_finalize(victim);
+
+        return res;
+    }
+
+    void SQLiteStatementCache::Clear()
+    {
+        vector<sqlite3_stmt*> idle;
+
+        {
+            lock_guard<mutex> lock(m_mutex);
+
+            for (auto& entry : m_lru)
+                idle.push_back(entry.Stmt);
+
+            m_index.clear();
+            m_lru.clear();
+            m_generation += 1;
+        }
+
+        for (auto* stmt : idle)
+            sqlite3_finalize(stmt);
+    }
+
+    SQLiteStatementCacheStats SQLiteStatementCache::GetStats() const
+    {
+        lock_guard<mutex> lock(m_mutex);
+
+        SQLiteStatementCacheStats stats;
+        stats.Hits = m_hits;
+        stats.Misses = m_misses;
+        stats.Evictions = m_evictions;
+        stats.Size = m_lru.size() + m_checkedOut.size();
+        stats.Capacity = m_capacity;
+
+        return stats;
+    }
+
+} // namespace PocketDb
@@ -0,0 +1,84 @@
+// Copyright (c) 2018-2022 The Pocketnet developers
+// Distributed under the Apache 2.0 software license, see the accompanying
+// https://www.apache.org/licenses/LICENSE-2.0
+
+#ifndef POCKETDB_SQLITESTATEMENTCACHE_H
+#define POCKETDB_SQLITESTATEMENTCACHE_H
+
+#include <sqlite3.h>
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace PocketDb
+{
+    using namespace std;
+
+    struct SQLiteStatementCacheStats
+    {
+        int64_t Hits = 0;
+        int64_t Misses = 0;
+        int64_t Evictions = 0;
+        size_t Size = 0;
+        size_t Capacity = 0;
+    };
+
+    // LRU cache of prepared statements keyed by SQL text.
+    // Statement is checked out with Acquire and returned with Release, so one statement
+    // never used twice at the same time - nested use of the same SQL prepares a second instance.
+    class SQLiteStatementCache
+    {
+    public:
+        explicit SQLiteStatementCache(size_t capacity = 0);
+        ~SQLiteStatementCache();
+
+        // Zero capacity disables caching - statements prepared and finalized on every use
+        void SetCapacity(size_t capacity);
+
+        // Get reset statement from cache or prepare new one
+        // Returns sqlite3_prepare_v2 result code
+        int Acquire(sqlite3* db, const string& sql, sqlite3_stmt** stmt);
+
+        // Reset statement and return it to cache
+        // Statements prepared before last Clear() or not owned by cache are finalized
+        int Release(sqlite3_stmt* stmt);
+
+        // Finalize all idle statements and invalidate all checked out
+        // Must be called before the schema of connection changed (attach, detach, drop indexes) and before close
+        void Clear();
+
+        SQLiteStatementCacheStats GetStats() const;
+
+    private:
+        struct Entry
+        {
+            string Sql;
+            sqlite3_stmt* Stmt;
+        };
+
+        struct CheckedOut
+        {
+            string Sql;
+            uint64_t Generation;
+        };
+
+        mutable mutex m_mutex;
+        size_t m_capacity;
+        uint64_t m_generation = 0;
+
+        // Idle statements, most recently used at front
+        list<Entry> m_lru;
+        unordered_map<string_view, list<Entry>::iterator> m_index;
+        unordered_map<sqlite3_stmt*, CheckedOut> m_checkedOut;
+
+        int64_t m_hits = 0;
+        int64_t m_misses = 0;
+        int64_t m_evictions = 0;
+    };
+
+} // namespace PocketDb
+
+#endif // POCKETDB_SQLITESTATEMENTCACHE_H
@@ -0,0 +1,89 @@
+// Copyright (c) 2018-2022 The Pocketnet developers
+// Distributed under the Apache 2.0 software license, see the accompanying
+// https://www.apache.org/licenses/LICENSE-2.0
+
+#include "pocketdb/consensus/AccountCache.h"
+#include "pocketdb/pocketnet.h"
+
+namespace PocketConsensus
+{
+    // Values are read outside of lock - workers may read the same value twice,
+    // but never wait for each other's queries
+    template<class K, class V, class F>
+    static V GetOrRead(mutex& mtx, unordered_map<K, V>& values, const K& key, F read)
+    {
+        {
+            lock_guard<mutex> lock(mtx);
+            if (auto it = values.find(key); it != values.end())
+                return it->second;
+        }
+
+        V value = read();
+
+        lock_guard<mutex> lock(mtx);
+        values.emplace(key, value);
+        return value;
+    }
+
+    int ConsensusAccountCache::GetUserReputation(const string& address)
+    {
+        return GetOrRead(m_mutex, m_reputationByAddress, address, [&] { return PocketDb::ConsensusRepo().GetUserReputation(address); });
+    }
+
+    int ConsensusAccountCache::GetUserReputation(int addressId)
+    {
+        return GetOrRead(m_mutex, m_reputationById, addressId, [&] { return PocketDb::ConsensusRepo().GetUserReputation(addressId); });
+    }
+
+    int64_t ConsensusAccountCache::GetUserBalance(const string& address)
+    {
+        return GetOrRead(m_mutex, m_balance, address, [&] { return PocketDb::ConsensusRepo().GetUserBalance(address); });
+    }
+
+    int ConsensusAccountCache::GetUserLikersCount(int addressId)
+    {
+        return GetOrRead(m_mutex, m_likers, addressId, [&] { return PocketDb::ConsensusRepo().GetUserLikersCount(addressId); });
+    }
+
+    // ---------------------------------------
+
+    static thread_local ConsensusAccountCache* currentAccountCache = nullptr;
+
+    ConsensusAccountScope::ConsensusAccountScope(const ConsensusAccountCacheRef& cache) : m_previous(currentAccountCache)
+    {
+        currentAccountCache = cache.get();
+    }
+
+    ConsensusAccountScope::~ConsensusAccountScope()
+    {
+        currentAccountCache = m_previous;
+    }
+
+    int ConsensusAccountScope::GetUserReputation(const string& address)
+    {
+        return currentAccountCache
+            ? currentAccountCache->GetUserReputation(address)
+            : PocketDb::ConsensusRepo().GetUserReputation(address);
+    }
+
+    int ConsensusAccountScope::GetUserReputation(int addressId)
+    {
+        return currentAccountCache
+            ? currentAccountCache->GetUserReputation(addressId)
+            : PocketDb::ConsensusRepo().GetUserReputation(addressId);
+    }
+
+    int64_t ConsensusAccountScope::GetUserBalance(const string& address)
+    {
+        return currentAccountCache
+            ? currentAccountCache->GetUserBalance(address)
+            : PocketDb::ConsensusRepo().GetUserBalance(address);
+    }
+
+    int ConsensusAccountScope::GetUserLikersCount(int addressId)
+    {
+        return currentAccountCache
+            ? currentAccountCache->GetUserLikersCount(addressId)
+            : PocketDb::ConsensusRepo().GetUserLikersCount(addressId);
+    }
+}
@@ -0,0 +1,60 @@
+// Copyright (c) 2018-2022 The Pocketnet developers
+// Distributed under the Apache 2.0 software license, see the accompanying
+// https://www.apache.org/licenses/LICENSE-2.0
+
+#ifndef POCKETCONSENSUS_ACCOUNTCACHE_H
+#define POCKETCONSENSUS_ACCOUNTCACHE_H
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace PocketConsensus
+{
+    using namespace std;
+
+    // Account state read by consensus rules - reputation, balance and likers.
+    // Chain state does not change while one block is validated or one transaction
+    // is accepted to mempool, so every value is read from database once per such scope.
+    // Shared by validation workers of one block.
+    class ConsensusAccountCache
+    {
+    public:
+        int GetUserReputation(const string& address);
+        int GetUserReputation(int addressId);
+        int64_t GetUserBalance(const string& address);
+        int GetUserLikersCount(int addressId);
+
+    private:
+        mutex m_mutex;
+        unordered_map<string, int> m_reputationByAddress;
+        unordered_map<int, int> m_reputationById;
+        unordered_map<string, int64_t> m_balance;
+        unordered_map<int, int> m_likers;
+    };
+
+    typedef shared_ptr<ConsensusAccountCache> ConsensusAccountCacheRef;
+
+    // Makes cache current for calling thread while scope is alive.
+    // Outside of any scope consensus reads account state directly from database.
+    class ConsensusAccountScope
+    {
+    public:
+        explicit ConsensusAccountScope(const ConsensusAccountCacheRef& cache);
+        ~ConsensusAccountScope();
+
+        ConsensusAccountScope(const ConsensusAccountScope&) = delete;
+        ConsensusAccountScope& operator=(const ConsensusAccountScope&) = delete;
+
+        static int GetUserReputation(const string& address);
+        static int GetUserReputation(int addressId);
+        static int64_t GetUserBalance(const string& address);
+        static int GetUserLikersCount(int addressId);
+
+    private:
+        ConsensusAccountCache* m_previous;
+    };
+}
+
+#endif // POCKETCONSENSUS_ACCOUNTCACHE_H
@@ -6,15 +6,55 @@
 
 namespace PocketConsensus
 {
-    BaseConsensus::BaseConsensus() = default;
+    static mutex consensusLimitsMutex;
+    static shared_ptr<const ConsensusLimitValues> consensusLimits;
+    static int consensusLimitsHeight = 0;
+    static NetworkId consensusLimitsNetwork = NetworkMain;
 
-    BaseConsensus::BaseConsensus(int height) : BaseConsensus()
+    static shared_ptr<const ConsensusLimitValues> ResolveConsensusLimits(int height, NetworkId network)
+    {
+        auto values = make_shared<ConsensusLimitValues>();
+        values->fill(0);
+
+        for (const auto& [limit, networks] : m_consensus_limits)
+        {
+            auto byNetwork = networks.find(network);
+            if (byNetwork == networks.end())
+                continue;
+
+            auto it = byNetwork->second.upper_bound(height);
+            if (it != byNetwork->second.begin())
+                (*values)[limit] = (--it)->second;
+        }
+
+        return values;
+    }
+
+    shared_ptr<const ConsensusLimitValues> GetConsensusLimits(int height)
+    {
+        auto network = Params().NetworkID();
+
+        lock_guard<mutex> lock(consensusLimitsMutex);
+        if (!consensusLimits || consensusLimitsHeight != height || consensusLimitsNetwork != network)
+        {
+            consensusLimits = ResolveConsensusLimits(height, network);
+            consensusLimitsHeight = height;
+            consensusLimitsNetwork = network;
+        }
+
+        return consensusLimits;
+    }
+
+    BaseConsensus::BaseConsensus() : BaseConsensus(0)
+    {
+    }
+
+    BaseConsensus::BaseConsensus(int height) : Height(height), m_limits(GetConsensusLimits(height))
     {
-        Height = height;
     }
 
     int64_t BaseConsensus::GetConsensusLimit(ConsensusLimit type) const
     {
-        return (--m_consensus_limits[type][Params().NetworkID()].upper_bound(Height))->second;
+        return (*m_limits)[type];
     }
-}
\ No newline at end of file
+}
@@ -5,6 +5,9 @@
 #ifndef POCKETCONSENSUS_BASE_H
 #define POCKETCONSENSUS_BASE_H
 
+#include <array>
+#include <mutex>
+
 #include "univalue/include/univalue.h"
 
 #include "pocketdb/pocketnet.h"
@@ -210,6 +213,9 @@ namespace PocketConsensus
         ConsensusLimit_lottery_referral_depth,
 
         ConsensusLimit_bad_reputation,
+
+        // Count of limits - not a limit
+        ConsensusLimit_Count
     };
 
     /*********************************************************************************************/
@@ -1079,6 +1085,13 @@ namespace PocketConsensus
         },
     };
 
+    // All limits resolved for one height, indexed by ConsensusLimit
+    typedef array<int64_t, ConsensusLimit_Count> ConsensusLimitValues;
+
+    // Resolve limits for height of current network.
+    // Values of last requested height are kept, so instances of one block share the same array.
+    shared_ptr<const ConsensusLimitValues> GetConsensusLimits(int height);
+
     /*********************************************************************************************/
     class BaseConsensus
     {
@@ -1089,6 +1102,8 @@ namespace PocketConsensus
         int64_t GetConsensusLimit(ConsensusLimit type) const;
     protected:
         int Height = 0;
+    private:
+        shared_ptr<const ConsensusLimitValues> m_limits;
     };
 
     /*********************************************************************************************/
@@ -1111,6 +1126,53 @@ namespace PocketConsensus
         }
     };
 
+    /*********************************************************************************************/
+    // Select actual rules version for height.
+    // Rules instances keep nothing but Height, so the last instance is shared by all
+    // transactions of validated block (and of mempool at the same height) instead of
+    // being created for every transaction. Safe to call from validation workers.
+    template<class T>
+    class BaseConsensusFactory
+    {
+    public:
+        explicit BaseConsensusFactory(vector<ConsensusCheckpoint<T>> rules) : m_rules(move(rules)) {}
+
+        shared_ptr<T> Instance(int height)
+        {
+            auto network = Params().NetworkID();
+
+            lock_guard<mutex> lock(m_mutex);
+            if (!m_instance || m_height != height || m_network != network)
+            {
+                m_instance = create(height);
+                m_height = height;
+                m_network = network;
+            }
+
+            return m_instance;
+        }
+
+    protected:
+        const vector<ConsensusCheckpoint<T>> m_rules;
+
+    private:
+        mutex m_mutex;
+        shared_ptr<T> m_instance;
+        int m_height = 0;
+        NetworkId m_network = NetworkMain;
+
+        shared_ptr<T> create(int height) const
+        {
+            int ruleHeight = (height > 0 ? height : 0);
+            return (--upper_bound(m_rules.begin(), m_rules.end(), ruleHeight,
+                [&](int target, const ConsensusCheckpoint<T>& itm)
+                {
+                    return target < itm.Height(Params().NetworkIDString());
+                }
+            ))->m_func(height);
+        }
+    };
+
     /*********************************************************************************************/
 }
 
@@ -0,0 +1,189 @@
+// Copyright (c) 2018-2022 The Pocketnet developers
+// Distributed under the Apache 2.0 software license, see the accompanying
+// https://www.apache.org/licenses/LICENSE-2.0
+
+#include "pocketdb/consensus/BlockContext.h"
+#include "pocketdb/models/dto/User.h"
+
+#include <algorithm>
+#include <boost/algorithm/string.hpp>
+
+namespace PocketConsensus
+{
+    SocialBlockContext::SocialBlockContext() : m_block(make_shared<PocketBlock>())
+    {
+    }
+
+    SocialBlockContext::SocialBlockContext(const PocketBlockRef& block) : m_block(block ? block : make_shared<PocketBlock>())
+    {
+        m_byHash.reserve(m_block->size());
+        for (size_t i = 0; i < m_block->size(); i++)
+            index(i);
+    }
+
+    void SocialBlockContext::Add(const PTransactionRef& ptx)
+    {
+        m_block->push_back(ptx);
+        index(m_block->size() - 1);
+    }
+
+    void SocialBlockContext::Rollback(size_t size)
+    {
+        while (m_block->size() > size)
+        {
+            unindex(m_block->size() - 1);
+            m_block->pop_back();
+        }
+    }
+
+    void SocialBlockContext::index(size_t position)
+    {
+        const auto& ptx = (*m_block)[position];
+        if (!ptx || !ptx->GetHash())
+            return;
+
+        m_byHash.emplace(*ptx->GetHash(), position);
+
+        const auto& type = ptx->GetType();
+        const auto& string1 = ptx->GetString1();
+        const auto& string2 = ptx->GetString2();
+        if (!type)
+            return;
+
+        if (string1)
+            m_byTypeAddress[(int) *type][*string1].push_back(position);
+
+        if (string2)
+            m_byRoot[*string2].push_back(position);
+
+        if (string1 && string2)
+            m_byAddressTo[*string1 + ' ' + *string2].push_back(position);
+
+        if (*type == ACCOUNT_USER)
+        {
+            if (const auto& name = static_pointer_cast<User>(ptx)->GetPayloadName(); name)
+                m_byUserName[boost::algorithm::to_lower_copy(*name)].push_back(position);
+        }
+    }
+
+    // Position is the last indexed one, so it is the last in every list
+    void SocialBlockContext::unindex(size_t position)
+    {
+        const auto& ptx = (*m_block)[position];
+        if (!ptx || !ptx->GetHash())
+            return;
+
+        auto byHash = m_byHash.find(*ptx->GetHash());
+        if (byHash == m_byHash.end() || byHash->second != position)
+            return;
+
+        m_byHash.erase(byHash);
+
+        auto pop = [position](auto& lists, const auto& key)
+        {
+            auto it = lists.find(key);
+            if (it == lists.end() || it->second.empty() || it->second.back() != position)
+                return;
+
+            it->second.pop_back();
+            if (it->second.empty())
+                lists.erase(it);
+        };
+
+        const auto& type = ptx->GetType();
+        const auto& string1 = ptx->GetString1();
+        const auto& string2 = ptx->GetString2();
+        if (!type)
+            return;
+
+        if (string1)
+            pop(m_byTypeAddress[(int) *type], *string1);
+
+        if (string2)
+            pop(m_byRoot, *string2);
+
+        if (string1 && string2)
+            pop(m_byAddressTo, *string1 + ' ' + *string2);
+
+        if (*type == ACCOUNT_USER)
+        {
+            if (const auto& name = static_pointer_cast<User>(ptx)->GetPayloadName(); name)
+                pop(m_byUserName, boost::algorithm::to_lower_copy(*name));
+        }
+    }
+
+    template<class P>
+    vector<PTransactionRef> SocialBlockContext::select(const P* positions, const vector<TxType>& types) const
+    {
+        vector<PTransactionRef> result;
+        if (!positions)
+            return result;
+
+        for (auto position : *positions)
+        {
+            const auto& ptx = (*m_block)[position];
+            if (types.empty() || TransactionHelper::IsIn(*ptx->GetType(), types))
+                result.push_back(ptx);
+        }
+
+        return result;
+    }
+
+    PTransactionRef SocialBlockContext::Find(const string& hash) const
+    {
+        auto it = m_byHash.find(hash);
+        return it != m_byHash.end() ? (*m_block)[it->second] : nullptr;
+    }
+
+    vector<PTransactionRef> SocialBlockContext::ByAddress(const string& address, const vector<TxType>& types) const
+    {
+        vector<size_t> positions;
+        for (auto type : types)
+        {
+            auto byType = m_byTypeAddress.find((int) type);
+            if (byType == m_byTypeAddress.end())
+                continue;
+
+            auto byAddress = byType->second.find(address);
+            if (byAddress != byType->second.end())
+                positions.insert(positions.end(), byAddress->second.begin(), byAddress->second.end());
+        }
+
+        // Several types - restore block order
+        if (types.size() > 1)
+            sort(positions.begin(), positions.end());
+
+        return select(&positions, {});
+    }
+
+    vector<PTransactionRef> SocialBlockContext::ByRoot(const string& root, const vector<TxType>& types) const
+    {
+        auto it = m_byRoot.find(root);
+        return select(it != m_byRoot.end() ? &it->second : nullptr, types);
+    }
+
+    vector<PTransactionRef> SocialBlockContext::ByAddressTo(const string& address, const string& addressTo, const vector<TxType>& types) const
+    {
+        auto it = m_byAddressTo.find(address + ' ' + addressTo);
+        return select(it != m_byAddressTo.end() ? &it->second : nullptr, types);
+    }
+
+    vector<PTransactionRef> SocialBlockContext::ByUserName(const string& name) const
+    {
+        auto it = m_byUserName.find(boost::algorithm::to_lower_copy(name));
+        return select(it != m_byUserName.end() ? &it->second : nullptr, {});
+    }
+
+    vector<PTransactionRef> SocialBlockContext::Union(const vector<PTransactionRef>& first, const vector<PTransactionRef>& second) const
+    {
+        vector<size_t> positions;
+        for (const auto* txs : {&first, &second})
+            for (const auto& ptx : *txs)
+                positions.push_back(m_byHash.at(*ptx->GetHash()));
+
+        sort(positions.begin(), positions.end());
+        positions.erase(unique(positions.begin(), positions.end()), positions.end());
+
+        return select(&positions, {});
+    }
+}
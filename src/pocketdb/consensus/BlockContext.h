@@ -0,0 +1,79 @@
+// Copyright (c) 2018-2022 The Pocketnet developers
+// Distributed under the Apache 2.0 software license, see the accompanying
+// https://www.apache.org/licenses/LICENSE-2.0
+
+#ifndef POCKETCONSENSUS_BLOCKCONTEXT_H
+#define POCKETCONSENSUS_BLOCKCONTEXT_H
+
+#include "pocketdb/helpers/BlockArena.h"
+#include "pocketdb/helpers/TransactionHelper.h"
+#include "pocketdb/models/base/Transaction.h"
+
+#include <unordered_map>
+
+namespace PocketConsensus
+{
+    using namespace std;
+    using namespace PocketTx;
+    using namespace PocketHelpers;
+
+    // Index of pocket transactions of one block for social consensus.
+    // Built once per block (or extended transaction by transaction while block is assembled),
+    // so validators find related transactions of the block without scanning it for every transaction.
+    // All lookups return transactions in block order - validators stop on first match as before.
+    class SocialBlockContext
+    {
+    public:
+        SocialBlockContext();
+        explicit SocialBlockContext(const PocketBlockRef& block);
+
+        // Append transaction to block and index it
+        void Add(const PTransactionRef& ptx);
+
+        // Drop transactions appended after block had given size - package of block template failed
+        void Rollback(size_t size);
+
+        const PocketBlockRef& Block() const { return m_block; }
+        size_t Size() const { return m_block->size(); }
+
+        PTransactionRef Find(const string& hash) const;
+
+        // Transactions of types with String1 (author address)
+        vector<PTransactionRef> ByAddress(const string& address, const vector<TxType>& types) const;
+
+        // Transactions of types with String2 (root of content or comment, target of score or complain)
+        vector<PTransactionRef> ByRoot(const string& root, const vector<TxType>& types) const;
+
+        // Transactions of types with String1 and String2 (address and addressTo of subscribes and blockings)
+        vector<PTransactionRef> ByAddressTo(const string& address, const string& addressTo, const vector<TxType>& types) const;
+
+        // Account transactions with the same name in lower case
+        vector<PTransactionRef> ByUserName(const string& name) const;
+
+        // Transactions found by several lookups, without repeats and in block order
+        vector<PTransactionRef> Union(const vector<PTransactionRef>& first, const vector<PTransactionRef>& second) const;
+
+    private:
+        // Indexes live as long as the block - placed in block arena if built within its scope
+        template<class K, class V>
+        using ArenaMap = unordered_map<K, V, hash<K>, equal_to<K>, BlockArenaAllocator<pair<const K, V>>>;
+        using Positions = vector<size_t, BlockArenaAllocator<size_t>>;
+
+        PocketBlockRef m_block;
+
+        ArenaMap<string, size_t> m_byHash;
+        ArenaMap<int, ArenaMap<string, Positions>> m_byTypeAddress;
+        ArenaMap<string, Positions> m_byRoot;
+        ArenaMap<string, Positions> m_byAddressTo;
+        ArenaMap<string, Positions> m_byUserName;
+
+        void index(size_t position);
+        void unindex(size_t position);
+        template<class P>
+        vector<PTransactionRef> select(const P* positions, const vector<TxType>& types) const;
+    };
+
+    typedef shared_ptr<SocialBlockContext> SocialBlockContextRef;
+}
+
+#endif // POCKETCONSENSUS_BLOCKCONTEXT_H
@@ -27,36 +27,57 @@ namespace PocketConsensus
 
     tuple<bool, SocialConsensusResult> SocialConsensusHelper::Validate(const CBlock& block, const PocketBlockRef& pBlock, int height)
     {
+        // Index block once - validators look up related transactions instead of scanning whole block
+        auto blockContext = make_shared<SocialBlockContext>(pBlock);
+
+        // We have to verify all transactions using consensus
+        // The presence of data in pBlock is checked in the `check` function
+        // pBlock comes in block order, so walk it along with vtx and look up only on mismatch
+        vector<pair<CTransactionRef, PTransactionRef>> txs;
+        size_t next = 0;
         for (const auto& tx : block.vtx)
         {
-            // We have to verify all transactions using consensus
-            // The presence of data in pBlock is checked in the `check` function
             auto txHash = tx->GetHash().GetHex();
-            auto it = find_if(pBlock->begin(), pBlock->end(), [&](PTransactionRef const& ptx) { return *ptx == txHash; });
+            if (pBlock && next < pBlock->size() && *(*pBlock)[next]->GetHash() == txHash)
+                txs.emplace_back(tx, (*pBlock)[next++]);
+            else if (auto ptx = blockContext->Find(txHash); ptx)
+                txs.emplace_back(tx, ptx);
+        }
 
-            // Validate founded data
-            if (it != pBlock->end())
-            {
-                if (auto[ok, result] = validate(tx, *it, pBlock, height); !ok)
-                {
-                    LogPrint(BCLog::CONSENSUS,
-                        "Warning: SocialConsensus type:%d validate tx:%s blk:%s failed with result:%d at height:%d\n",
-                        (int) *(*it)->GetType(), txHash, block.GetHash().GetHex(), (int) result, height);
-
-                    return {false, result};
-                }
-            }
+        // Transactions are validated against state before block and whole block context,
+        // so they do not depend on each other - validate in parallel and take first failed in block order
+        auto accounts = make_shared<ConsensusAccountCache>();
+        vector<SocialConsensusResult> results(txs.size(), SocialConsensusResult_Success);
+        size_t failed = SocialValidationQueueInst.Run(txs.size(), [&](size_t i)
+        {
+            ConsensusAccountScope accountScope(accounts);
+            auto[ok, result] = validate(txs[i].first, txs[i].second, blockContext, height);
+            results[i] = result;
+            return ok;
+        });
+
+        if (failed < txs.size())
+        {
+            const auto& ptx = txs[failed].second;
+            LogPrint(BCLog::CONSENSUS,
+                "Warning: SocialConsensus type:%d validate tx:%s blk:%s failed with result:%d at height:%d\n",
+                (int) *ptx->GetType(), *ptx->GetHash(), block.GetHash().GetHex(), (int) results[failed], height);
+
+            return {false, results[failed]};
         }
 
         return {true, SocialConsensusResult_Success};
     }
 
-    tuple<bool, SocialConsensusResult> SocialConsensusHelper::Validate(const CTransactionRef& tx, const PTransactionRef& ptx, int height)
+    tuple<bool, SocialConsensusResult> SocialConsensusHelper::Validate(const CTransactionRef& tx, const PTransactionRef& ptx, const SocialMempoolIndex& mempool, int height)
     {
         // Not double validate for already in DB
         if (TransRepoInst.Exists(*ptx->GetHash()))
             return {true, SocialConsensusResult_Success};
 
+        // Mempool limits are counted by index of caller's mempool
+        SocialMempoolScope mempoolScope(mempool);
+        ConsensusAccountScope accountScope(make_shared<ConsensusAccountCache>());
         if (auto[ok, result] = validate(tx, ptx, nullptr, height); !ok)
         {
             LogPrint(BCLog::CONSENSUS, "Warning: SocialConsensus type:%d validate failed with result:%d for tx:%s at height:%d\n",
@@ -68,9 +89,9 @@ namespace PocketConsensus
         return {true, SocialConsensusResult_Success};
     }
 
-    tuple<bool, SocialConsensusResult> SocialConsensusHelper::Validate(const CTransactionRef& tx, const PTransactionRef& ptx, PocketBlockRef& pBlock, int height)
+    tuple<bool, SocialConsensusResult> SocialConsensusHelper::Validate(const CTransactionRef& tx, const PTransactionRef& ptx, const SocialBlockContextRef& blockContext, int height)
     {
-        if (auto[ok, result] = validate(tx, ptx, pBlock, height); !ok)
+        if (auto[ok, result] = validate(tx, ptx, blockContext, height); !ok)
         {
             LogPrint(BCLog::CONSENSUS, "Warning: SocialConsensus type:%d validate tx:%s failed with result:%d for block construction at height:%d\n",
                 (int)*ptx->GetType(), *ptx->GetHash(), (int)result, height);
@@ -98,6 +119,11 @@ namespace PocketConsensus
             return tx->IsCoinStake();
         }) != block.vtx.end();
 
+        unordered_map<string, PTransactionRef> payloads;
+        payloads.reserve(pBlock->size());
+        for (const auto& ptx : *pBlock)
+            payloads.emplace(*ptx->GetHash(), ptx);
+
         // Check all transactions in block and payload block
         for (const auto& tx : block.vtx)
         {
@@ -110,8 +136,8 @@ namespace PocketConsensus
 
             // Maybe payload not exists?
             auto txHash = tx->GetHash().GetHex();
-            auto it = find_if(pBlock->begin(), pBlock->end(), [&](PTransactionRef const& ptx) { return *ptx == txHash; });
-            if (it == pBlock->end())
+            auto it = payloads.find(txHash);
+            if (it == payloads.end())
             {
                 LogPrint(BCLog::CONSENSUS, "Warning: SocialConsensus type:%d check failed with result:%d for tx:%s in blk:%s at height:%d\n",
                     (int)txType, (int)SocialConsensusResult_PocketDataNotFound, tx->GetHash().GetHex(), block.GetHash().GetHex(), height);
@@ -120,7 +146,7 @@ namespace PocketConsensus
             }
 
             // Check founded payload
-            if (auto[ok, result] = check(tx, *it, height); !ok)
+            if (auto[ok, result] = check(tx, it->second, height); !ok)
             {
                 LogPrint(BCLog::CONSENSUS, "Warning: SocialConsensus check type:%d failed with result:%d for tx:%s in blk:%s at height:%d\n",
                     (int)txType, (int)result, tx->GetHash().GetHex(), block.GetHash().GetHex(), height);
@@ -202,7 +228,7 @@ namespace PocketConsensus
         }
     }
 
-    tuple<bool, SocialConsensusResult> SocialConsensusHelper::validate(const CTransactionRef& tx, const PTransactionRef& ptx, const PocketBlockRef& pBlock, int height)
+    tuple<bool, SocialConsensusResult> SocialConsensusHelper::validate(const CTransactionRef& tx, const PTransactionRef& ptx, const SocialBlockContextRef& block, int height)
     {
         if (!isConsensusable(*ptx->GetType()))
             return {true, SocialConsensusResult_Success};
@@ -212,41 +238,41 @@ namespace PocketConsensus
         switch (*ptx->GetType())
         {
             case ACCOUNT_SETTING:
-                return m_accountSettingFactory.Instance(height)->Validate(tx, static_pointer_cast<AccountSetting>(ptx), pBlock);
+                return m_accountSettingFactory.Instance(height)->Validate(tx, static_pointer_cast<AccountSetting>(ptx), block);
             case ACCOUNT_USER:
-                return m_userFactory.Instance(height)->Validate(tx, static_pointer_cast<User>(ptx), pBlock);
+                return m_userFactory.Instance(height)->Validate(tx, static_pointer_cast<User>(ptx), block);
             case CONTENT_POST:
-                return m_postFactory.Instance(height)->Validate(tx, static_pointer_cast<Post>(ptx), pBlock);
+                return m_postFactory.Instance(height)->Validate(tx, static_pointer_cast<Post>(ptx), block);
             case CONTENT_VIDEO:
-                return m_videoFactory.Instance(height)->Validate(tx, static_pointer_cast<Video>(ptx), pBlock);
+                return m_videoFactory.Instance(height)->Validate(tx, static_pointer_cast<Video>(ptx), block);
             case CONTENT_ARTICLE:
-                return m_articleFactory.Instance(height)->Validate(tx, static_pointer_cast<Article>(ptx), pBlock);
+                return m_articleFactory.Instance(height)->Validate(tx, static_pointer_cast<Article>(ptx), block);
             case CONTENT_COMMENT:
-                return m_commentFactory.Instance(height)->Validate(tx, static_pointer_cast<Comment>(ptx), pBlock);
+                return m_commentFactory.Instance(height)->Validate(tx, static_pointer_cast<Comment>(ptx), block);
             case CONTENT_COMMENT_EDIT:
-                return m_commentEditFactory.Instance(height)->Validate(tx, static_pointer_cast<CommentEdit>(ptx), pBlock);
+                return m_commentEditFactory.Instance(height)->Validate(tx, static_pointer_cast<CommentEdit>(ptx), block);
             case CONTENT_COMMENT_DELETE:
-                return m_commentDeleteFactory.Instance(height)->Validate(tx, static_pointer_cast<CommentDelete>(ptx), pBlock);
+                return m_commentDeleteFactory.Instance(height)->Validate(tx, static_pointer_cast<CommentDelete>(ptx), block);
             case CONTENT_DELETE:
-                return m_contentDeleteFactory.Instance(height)->Validate(tx, static_pointer_cast<ContentDelete>(ptx), pBlock);
+                return m_contentDeleteFactory.Instance(height)->Validate(tx, static_pointer_cast<ContentDelete>(ptx), block);
             case BOOST_CONTENT:
-                return m_boostContentFactory.Instance(height)->Validate(tx, static_pointer_cast<BoostContent>(ptx), pBlock);
+                return m_boostContentFactory.Instance(height)->Validate(tx, static_pointer_cast<BoostContent>(ptx), block);
             case ACTION_SCORE_CONTENT:
-                return m_scoreContentFactory.Instance(height)->Validate(tx, static_pointer_cast<ScoreContent>(ptx), pBlock);
+                return m_scoreContentFactory.Instance(height)->Validate(tx, static_pointer_cast<ScoreContent>(ptx), block);
             case ACTION_SCORE_COMMENT:
-                return m_scoreCommentFactory.Instance(height)->Validate(tx, static_pointer_cast<ScoreComment>(ptx), pBlock);
+                return m_scoreCommentFactory.Instance(height)->Validate(tx, static_pointer_cast<ScoreComment>(ptx), block);
             case ACTION_SUBSCRIBE:
-                return m_subscribeFactory.Instance(height)->Validate(tx, static_pointer_cast<Subscribe>(ptx), pBlock);
+                return m_subscribeFactory.Instance(height)->Validate(tx, static_pointer_cast<Subscribe>(ptx), block);
             case ACTION_SUBSCRIBE_PRIVATE:
-                return m_subscribePrivateFactory.Instance(height)->Validate(tx, static_pointer_cast<SubscribePrivate>(ptx), pBlock);
+                return m_subscribePrivateFactory.Instance(height)->Validate(tx, static_pointer_cast<SubscribePrivate>(ptx), block);
             case ACTION_SUBSCRIBE_CANCEL:
-                return m_subscribeCancelFactory.Instance(height)->Validate(tx, static_pointer_cast<SubscribeCancel>(ptx), pBlock);
+                return m_subscribeCancelFactory.Instance(height)->Validate(tx, static_pointer_cast<SubscribeCancel>(ptx), block);
             case ACTION_BLOCKING:
-                return m_blockingFactory.Instance(height)->Validate(tx, static_pointer_cast<Blocking>(ptx), pBlock);
+                return m_blockingFactory.Instance(height)->Validate(tx, static_pointer_cast<Blocking>(ptx), block);
             case ACTION_BLOCKING_CANCEL:
-                return m_blockingCancelFactory.Instance(height)->Validate(tx, static_pointer_cast<BlockingCancel>(ptx), pBlock);
+                return m_blockingCancelFactory.Instance(height)->Validate(tx, static_pointer_cast<BlockingCancel>(ptx), block);
             case ACTION_COMPLAIN:
-                return m_complainFactory.Instance(height)->Validate(tx, static_pointer_cast<Complain>(ptx), pBlock);
+                return m_complainFactory.Instance(height)->Validate(tx, static_pointer_cast<Complain>(ptx), block);
             // TODO (brangr): future realize types
             // case ACCOUNT_VIDEO_SERVER:
             // case ACCOUNT_MESSAGE_SERVER:
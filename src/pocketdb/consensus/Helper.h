@@ -7,7 +7,10 @@
 
 #include "pocketdb/helpers/TransactionHelper.h"
 #include "pocketdb/models/base/Transaction.h"
+#include "pocketdb/consensus/AccountCache.h"
+#include "pocketdb/consensus/MempoolIndex.h"
 #include "pocketdb/consensus/Reputation.h"
+#include "pocketdb/consensus/ValidationQueue.h"
 
 #include "pocketdb/consensus/social/Blocking.hpp"
 #include "pocketdb/consensus/social/BlockingCancel.hpp"
@@ -39,12 +42,13 @@ namespace PocketConsensus
     {
     public:
         static tuple<bool, SocialConsensusResult> Validate(const CBlock& block, const PocketBlockRef& pBlock, int height);
-        static tuple<bool, SocialConsensusResult> Validate(const CTransactionRef& tx, const PTransactionRef& ptx, int height);
-        static tuple<bool, SocialConsensusResult> Validate(const CTransactionRef& tx, const PTransactionRef& ptx, PocketBlockRef& pBlock, int height);
+        static tuple<bool, SocialConsensusResult> Validate(const CTransactionRef& tx, const PTransactionRef& ptx, const SocialMempoolIndex& mempool, int height);
+        // Validate transaction for block template - blockContext holds transactions already accepted to template
+        static tuple<bool, SocialConsensusResult> Validate(const CTransactionRef& tx, const PTransactionRef& ptx, const SocialBlockContextRef& blockContext, int height);
         static tuple<bool, SocialConsensusResult> Check(const CBlock& block, const PocketBlockRef& pBlock, int height);
         static tuple<bool, SocialConsensusResult> Check(const CTransactionRef& tx, const PTransactionRef& ptx, int height);
     protected:
-        static tuple<bool, SocialConsensusResult> validate(const CTransactionRef& tx, const PTransactionRef& ptx, const PocketBlockRef& pBlock, int height);
+        static tuple<bool, SocialConsensusResult> validate(const CTransactionRef& tx, const PTransactionRef& ptx, const SocialBlockContextRef& block, int height);
         static tuple<bool, SocialConsensusResult> check(const CTransactionRef& tx, const PTransactionRef& ptx, int height);
         static bool isConsensusable(TxType txType);
     private:
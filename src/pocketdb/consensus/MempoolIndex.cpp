@@ -0,0 +1,149 @@
+// Copyright (c) 2018-2022 The Pocketnet developers
+// Distributed under the Apache 2.0 software license, see the accompanying
+// https://www.apache.org/licenses/LICENSE-2.0
+
+#include "pocketdb/consensus/MempoolIndex.h"
+
+namespace PocketConsensus
+{
+    void SocialMempoolIndex::Add(const PTransactionRef& ptx)
+    {
+        if (!ptx || !ptx->GetHash())
+            return;
+
+        const auto& hash = *ptx->GetHash();
+        if (m_entries.count(hash))
+            return;
+
+        // Transactions without type or author (money transfers) are kept for block assembling only
+        Entry entry{TxType::NOT_SUPPORTED, "", "", false, false, ptx};
+        if (ptx->GetType() && ptx->GetString1())
+        {
+            entry.Type = *ptx->GetType();
+            entry.Address = *ptx->GetString1();
+            entry.AddressTo = ptx->GetString2() ? *ptx->GetString2() : "";
+            entry.Original = ptx->GetString2() && entry.AddressTo == hash;
+            entry.Counted = true;
+            index(entry, 1);
+        }
+
+        m_entries.emplace(hash, move(entry));
+    }
+
+    void SocialMempoolIndex::Remove(const string& hash)
+    {
+        auto it = m_entries.find(hash);
+        if (it == m_entries.end())
+            return;
+
+        if (it->second.Counted)
+            index(it->second, -1);
+
+        m_entries.erase(it);
+    }
+
+    void SocialMempoolIndex::index(const Entry& entry, int delta)
+    {
+        auto& byAddress = m_byTypeAddress[(int) entry.Type];
+        auto& counter = byAddress[entry.Address];
+        counter.All += delta;
+        counter.Original += entry.Original ? delta : 0;
+        if (counter.All == 0)
+            byAddress.erase(entry.Address);
+        if (byAddress.empty())
+            m_byTypeAddress.erase((int) entry.Type);
+
+        auto& byAddressTo = m_byTypeAddressTo[(int) entry.Type];
+        auto key = addressToKey(entry.Address, entry.AddressTo);
+        if ((byAddressTo[key] += delta) == 0)
+            byAddressTo.erase(key);
+        if (byAddressTo.empty())
+            m_byTypeAddressTo.erase((int) entry.Type);
+    }
+
+    void SocialMempoolIndex::Clear()
+    {
+        m_entries.clear();
+        m_byTypeAddress.clear();
+        m_byTypeAddressTo.clear();
+    }
+
+    PTransactionRef SocialMempoolIndex::Get(const string& hash) const
+    {
+        auto it = m_entries.find(hash);
+        return it != m_entries.end() ? it->second.Tx : nullptr;
+    }
+
+    vector<string> SocialMempoolIndex::Hashes() const
+    {
+        vector<string> result;
+        result.reserve(m_entries.size());
+        for (const auto& entry : m_entries)
+            result.push_back(entry.first);
+
+        return result;
+    }
+
+    int SocialMempoolIndex::CountByAddress(const string& address, const vector<TxType>& types, bool originalOnly) const
+    {
+        int result = 0;
+        for (auto type : types)
+        {
+            auto byAddress = m_byTypeAddress.find((int) type);
+            if (byAddress == m_byTypeAddress.end())
+                continue;
+
+            if (auto counter = byAddress->second.find(address); counter != byAddress->second.end())
+                result += originalOnly ? counter->second.Original : counter->second.All;
+        }
+
+        return result;
+    }
+
+    int SocialMempoolIndex::CountByAddressTo(const string& address, const string& addressTo, const vector<TxType>& types) const
+    {
+        int result = 0;
+        auto key = addressToKey(address, addressTo);
+        for (auto type : types)
+        {
+            auto byAddressTo = m_byTypeAddressTo.find((int) type);
+            if (byAddressTo == m_byTypeAddressTo.end())
+                continue;
+
+            if (auto count = byAddressTo->second.find(key); count != byAddressTo->second.end())
+                result += count->second;
+        }
+
+        return result;
+    }
+
+    bool SocialMempoolIndex::CheckConsistency() const
+    {
+        SocialMempoolIndex rebuilt;
+        for (const auto& [hash, entry] : m_entries)
+            if (entry.Counted)
+                rebuilt.index(entry, 1);
+
+        return rebuilt.m_byTypeAddress == m_byTypeAddress && rebuilt.m_byTypeAddressTo == m_byTypeAddressTo;
+    }
+
+    // ---------------------------------------
+
+    static thread_local const SocialMempoolIndex* currentMempoolIndex = nullptr;
+
+    SocialMempoolScope::SocialMempoolScope(const SocialMempoolIndex& index) : m_previous(currentMempoolIndex)
+    {
+        currentMempoolIndex = &index;
+    }
+
+    SocialMempoolScope::~SocialMempoolScope()
+    {
+        currentMempoolIndex = m_previous;
+    }
+
+    const SocialMempoolIndex& SocialMempool()
+    {
+        static const SocialMempoolIndex empty;
+        return currentMempoolIndex ? *currentMempoolIndex : empty;
+    }
+}
@@ -0,0 +1,95 @@
+// Copyright (c) 2018-2022 The Pocketnet developers
+// Distributed under the Apache 2.0 software license, see the accompanying
+// https://www.apache.org/licenses/LICENSE-2.0
+
+#ifndef POCKETCONSENSUS_MEMPOOLINDEX_H
+#define POCKETCONSENSUS_MEMPOOLINDEX_H
+
+#include "pocketdb/helpers/TransactionHelper.h"
+#include "pocketdb/models/base/Transaction.h"
+
+#include <unordered_map>
+
+namespace PocketConsensus
+{
+    using namespace std;
+    using namespace PocketTx;
+    using namespace PocketHelpers;
+
+    // Pocket transactions of mempool indexed for social consensus limits and block assembling.
+    // Owned by CTxMemPool and maintained under its lock: transactions are added on acceptance
+    // (including re-acceptance after reorg and load of mempool.dat) and removed with any
+    // removal of mempool entry - for block, conflict, reorg, expiry or size limit.
+    // Counts match former "Height is null" queries over String1 (address) and String2
+    // (addressTo or root transaction).
+    class SocialMempoolIndex
+    {
+    public:
+        void Add(const PTransactionRef& ptx);
+        void Remove(const string& hash);
+        void Clear();
+
+        size_t Size() const { return m_entries.size(); }
+        bool Exists(const string& hash) const { return m_entries.count(hash) > 0; }
+
+        // Payload of mempool transaction - block assembler takes it from here instead of sqlite
+        PTransactionRef Get(const string& hash) const;
+        vector<string> Hashes() const;
+
+        // Transactions of types by address, originalOnly - with Hash = String2 (not edits)
+        int CountByAddress(const string& address, const vector<TxType>& types, bool originalOnly = false) const;
+
+        // Transactions of types by address and String2
+        int CountByAddressTo(const string& address, const string& addressTo, const vector<TxType>& types) const;
+
+        // Counters are the same as rebuilt from indexed transactions
+        bool CheckConsistency() const;
+
+    private:
+        struct Entry
+        {
+            TxType Type;
+            string Address;
+            string AddressTo;
+            bool Original;
+            bool Counted;
+            PTransactionRef Tx;
+        };
+
+        struct Counter
+        {
+            int All = 0;
+            int Original = 0;
+
+            bool operator==(const Counter& other) const { return All == other.All && Original == other.Original; }
+        };
+
+        unordered_map<string, Entry> m_entries;
+        unordered_map<int, unordered_map<string, Counter>> m_byTypeAddress;
+        unordered_map<int, unordered_map<string, int>> m_byTypeAddressTo;
+
+        void index(const Entry& entry, int delta);
+
+        static string addressToKey(const string& address, const string& addressTo) { return address + ' ' + addressTo; }
+    };
+
+    // Mempool index for consensus rules of transaction being accepted to mempool.
+    // Installed for calling thread by SocialConsensusHelper::Validate while mempool lock is held,
+    // outside of it rules see empty mempool.
+    class SocialMempoolScope
+    {
+    public:
+        explicit SocialMempoolScope(const SocialMempoolIndex& index);
+        ~SocialMempoolScope();
+
+        SocialMempoolScope(const SocialMempoolScope&) = delete;
+        SocialMempoolScope& operator=(const SocialMempoolScope&) = delete;
+
+    private:
+        const SocialMempoolIndex* m_previous;
+    };
+
+    const SocialMempoolIndex& SocialMempool();
+}
+
+#endif // POCKETCONSENSUS_MEMPOOLINDEX_H
@@ -26,7 +26,7 @@ namespace PocketConsensus
         explicit ReputationConsensus(int height) : BaseConsensus(height) {}
 
         virtual AccountMode GetAccountMode(int reputation, int64_t balance);
-        virtual tuple<AccountMode, int, int64_t> GetAccountMode(string& address);
+        virtual tuple<AccountMode, int, int64_t> GetAccountMode(const string& address);
         virtual bool AllowModifyReputation(shared_ptr<ScoreDataDto>& scoreData, bool lottery);
         virtual bool AllowModifyOldPosts(int64_t scoreTime, int64_t contentTime, TxType contentType);
         virtual void PrepareAccountLikers(map<int, vector<int>>& accountLikersSrc, map<int, vector<int>>& accountLikers);
@@ -72,27 +72,16 @@ namespace PocketConsensus
 
     // ------------------------------------------
     //  Factory for select actual rules version
-    class ReputationConsensusFactory
+    class ReputationConsensusFactory : public BaseConsensusFactory<ReputationConsensus>
     {
-    private:
-        const vector<ConsensusCheckpoint<ReputationConsensus>> m_rules = {
+    public:
+        ReputationConsensusFactory() : BaseConsensusFactory<ReputationConsensus>({
             {0,       -1,    [](int height) { return make_shared<ReputationConsensus>(height); }},
             {151600,  -1,    [](int height) { return make_shared<ReputationConsensus_checkpoint_151600>(height); }},
             {1180000, 0,     [](int height) { return make_shared<ReputationConsensus_checkpoint_1180000>(height); }},
             {1324655, 65000, [](int height) { return make_shared<ReputationConsensus_checkpoint_1324655>(height); }},
             {1324655, 75000, [](int height) { return make_shared<ReputationConsensus_checkpoint_1324655_2>(height); }},
-        };
-    public:
-        shared_ptr<ReputationConsensus> Instance(int height)
-        {
-            int m_height = (height > 0 ? height : 0);
-            return (--upper_bound(m_rules.begin(), m_rules.end(), m_height,
-                [&](int target, const ConsensusCheckpoint<ReputationConsensus>& itm)
-                {
-                    return target < itm.Height(Params().NetworkIDString());
-                }
-            ))->m_func(height);
-        }
+        }) {}
     };
 
     extern ReputationConsensusFactory ReputationConsensusFactoryInst;
@@ -13,6 +13,8 @@
 #include "pocketdb/pocketnet.h"
 #include "pocketdb/models/base/Base.h"
 #include "pocketdb/consensus/Base.h"
+#include "pocketdb/consensus/BlockContext.h"
+#include "pocketdb/consensus/MempoolIndex.h"
 #include "pocketdb/helpers/TransactionHelper.h"
 
 namespace PocketConsensus
@@ -30,9 +32,8 @@ namespace PocketConsensus
         SocialConsensus(int height) : BaseConsensus(height) {}
 
         // Validate transaction in block for miner & network full block sync
-        virtual ConsensusValidateResult Validate(const CTransactionRef& tx, const shared_ptr<T>& ptx, const PocketBlockRef& block)
+        virtual ConsensusValidateResult Validate(const CTransactionRef& tx, const shared_ptr<T>& ptx, const SocialBlockContextRef& block)
         {
-            // TODO (team): optimize algorithm
             // Account must be registered
             vector<string> addressesForCheck;
             vector<string> addresses = GetAddressesForCheckRegistration(ptx);
@@ -43,20 +44,7 @@ namespace PocketConsensus
                 {
                     for (const string& address : addresses)
                     {
-                        bool inBlock = false;
-                        for (auto& blockTx: *block)
-                        {
-                            if (!TransactionHelper::IsIn(*blockTx->GetType(), {ACCOUNT_USER}))
-                                continue;
-
-                            if (*blockTx->GetString1() == address)
-                            {
-                                inBlock = true;
-                                break;
-                            }
-                        }
-
-                        if (!inBlock)
+                        if (block->ByAddress(address, {ACCOUNT_USER}).empty())
                             addressesForCheck.push_back(address);
                     }
                 }
@@ -67,7 +55,7 @@ namespace PocketConsensus
 
                 // Check registrations in DB
                 if (!addressesForCheck.empty() &&
-                    !PocketDb::ConsensusRepoInst.ExistsUserRegistrations(addressesForCheck, false))
+                    !PocketDb::ConsensusRepo().ExistsUserRegistrations(addressesForCheck, false))
                     return {false, SocialConsensusResult_NotRegistered};
             }
 
@@ -87,7 +75,7 @@ namespace PocketConsensus
     protected:
         ConsensusValidateResult Success{true, SocialConsensusResult_Success};
 
-        virtual ConsensusValidateResult ValidateLimits(const shared_ptr<T>& ptx, const PocketBlockRef& block)
+        virtual ConsensusValidateResult ValidateLimits(const shared_ptr<T>& ptx, const SocialBlockContextRef& block)
         {
             if (block)
                 return ValidateBlock(ptx, block);
@@ -95,7 +83,7 @@ namespace PocketConsensus
                 return ValidateMempool(ptx);
         }
 
-        virtual ConsensusValidateResult ValidateBlock(const shared_ptr<T>& ptx, const PocketBlockRef& block) = 0;
+        virtual ConsensusValidateResult ValidateBlock(const shared_ptr<T>& ptx, const SocialBlockContextRef& block) = 0;
 
         virtual ConsensusValidateResult ValidateMempool(const shared_ptr<T>& ptx) = 0;
 
@@ -118,17 +106,17 @@ namespace PocketConsensus
         virtual vector<string> GetAddressesForCheckRegistration(const shared_ptr<T>& tx) = 0;
 
         // Check empty pointer
-        bool IsEmpty(const shared_ptr<string>& ptr) const
+        bool IsEmpty(const optional<string>& ptr) const
         {
             return !ptr || (*ptr).empty();
         }
 
-        bool IsEmpty(const shared_ptr<int>& ptr) const
+        bool IsEmpty(const optional<int>& ptr) const
         {
             return !ptr;
         }
 
-        bool IsEmpty(const shared_ptr<int64_t>& ptr) const
+        bool IsEmpty(const optional<int64_t>& ptr) const
         {
             return !ptr;
         }
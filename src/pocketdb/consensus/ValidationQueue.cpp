@@ -0,0 +1,155 @@
+// Copyright (c) 2018-2022 The Pocketnet developers
+// Distributed under the Apache 2.0 software license, see the accompanying
+// https://www.apache.org/licenses/LICENSE-2.0
+
+#include "pocketdb/consensus/ValidationQueue.h"
+#include "pocketdb/pocketnet.h"
+#include "util.h"
+
+namespace PocketConsensus
+{
+    SocialValidationQueue SocialValidationQueueInst;
+
+    void SocialValidationQueue::Start(int threads)
+    {
+        lock_guard<mutex> runLock(m_runMutex);
+
+        {
+            lock_guard<mutex> lock(m_mutex);
+            m_shutdown = false;
+        }
+
+        for (int i = 0; i < threads; i++)
+            m_threads.emplace_back([this] { Worker(); });
+    }
+
+    void SocialValidationQueue::Stop()
+    {
+        lock_guard<mutex> runLock(m_runMutex);
+
+        {
+            lock_guard<mutex> lock(m_mutex);
+            m_shutdown = true;
+            m_workCond.notify_all();
+        }
+
+        for (auto& thread : m_threads)
+            thread.join();
+
+        m_threads.clear();
+    }
+
+    size_t SocialValidationQueue::Run(size_t count, const function<bool(size_t)>& job)
+    {
+        lock_guard<mutex> runLock(m_runMutex);
+
+        m_job = &job;
+        m_count = count;
+        m_next = 0;
+        m_failed = count;
+        m_errorIndex = count;
+        m_error = nullptr;
+
+        {
+            lock_guard<mutex> lock(m_mutex);
+            m_active = (int) m_threads.size();
+            m_generation += 1;
+            m_workCond.notify_all();
+        }
+
+        // Calling thread validates too - through main connection
+        Process();
+
+        {
+            unique_lock<mutex> lock(m_mutex);
+            m_doneCond.wait(lock, [this] { return m_active == 0; });
+        }
+
+        m_job = nullptr;
+
+        size_t failed = m_failed;
+        if (m_error && m_errorIndex == failed)
+            rethrow_exception(m_error);
+
+        return failed;
+    }
+
+    void SocialValidationQueue::Process()
+    {
+        while (true)
+        {
+            size_t index = m_next.fetch_add(1);
+
+            // Jobs after already failed one do not change result
+            if (index >= m_count || index > m_failed)
+                break;
+
+            bool ok;
+            try
+            {
+                ok = (*m_job)(index);
+            }
+            catch (...)
+            {
+                lock_guard<mutex> lock(m_mutex);
+                if (index < m_errorIndex)
+                {
+                    m_errorIndex = index;
+                    m_error = current_exception();
+                }
+
+                ok = false;
+            }
+
+            if (!ok)
+            {
+                size_t failed = m_failed;
+                while (index < failed && !m_failed.compare_exchange_weak(failed, index)) {}
+            }
+        }
+    }
+
+    void SocialValidationQueue::Worker()
+    {
+        RenameThread("pocketcoin-socialcheck");
+
+        uint64_t generation = 0;
+        while (true)
+        {
+            {
+                unique_lock<mutex> lock(m_mutex);
+                m_workCond.wait(lock, [&] { return m_shutdown || m_generation != generation; });
+
+                if (m_shutdown)
+                    return;
+
+                generation = m_generation;
+            }
+
+            // Connection taken only if something left to validate
+            if (m_next < m_count)
+            {
+                try
+                {
+                    auto connection = PocketDb::SQLiteConsensusPoolInst.Acquire();
+
+                    PocketDb::SetThreadConsensusRepo(connection->ConsensusRepoInst.get());
+                    Process();
+                    PocketDb::SetThreadConsensusRepo(nullptr);
+                }
+                catch (const std::exception& e)
+                {
+                    // Jobs not taken here are validated by other workers and calling thread
+                    PocketDb::SetThreadConsensusRepo(nullptr);
+                    LogPrintf("SocialValidationQueue: worker failed to acquire connection: %s\n", e.what());
+                }
+            }
+
+            {
+                lock_guard<mutex> lock(m_mutex);
+                if (--m_active == 0)
+                    m_doneCond.notify_all();
+            }
+        }
+    }
+}
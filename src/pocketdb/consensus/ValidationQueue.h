@@ -0,0 +1,69 @@
+// Copyright (c) 2018-2022 The Pocketnet developers
+// Distributed under the Apache 2.0 software license, see the accompanying
+// https://www.apache.org/licenses/LICENSE-2.0
+
+#ifndef POCKETCONSENSUS_VALIDATIONQUEUE_H
+#define POCKETCONSENSUS_VALIDATIONQUEUE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace PocketConsensus
+{
+    using namespace std;
+
+    static const int DEFAULT_SOCIAL_CHECK_THREADS = 4;
+    static const int MAX_SOCIAL_CHECK_THREADS = 16;
+
+    // Workers validating social consensus of block transactions in parallel.
+    // Every worker reads chain state through own read-only connection of SQLiteConsensusPoolInst,
+    // calling thread takes part through main connection. Validation thread writes nothing
+    // while block is validated, so all connections see the same state before the block.
+    //
+    // Result is the same as of sequential loop: jobs after the first failed one may be skipped,
+    // but every job before it is completed, so the lowest failed index is always found.
+    class SocialValidationQueue
+    {
+    public:
+        void Start(int threads);
+        void Stop();
+
+        int Threads() const { return (int) m_threads.size(); }
+
+        // Run job(i) for all i in [0, count) and return lowest i with failed job, or count if all succeeded.
+        // Exception thrown by job at that index is rethrown.
+        size_t Run(size_t count, const function<bool(size_t)>& job);
+
+    private:
+        vector<thread> m_threads;
+
+        mutex m_runMutex;
+
+        mutex m_mutex;
+        condition_variable m_workCond;
+        condition_variable m_doneCond;
+        bool m_shutdown = false;
+        uint64_t m_generation = 0;
+        int m_active = 0;
+
+        const function<bool(size_t)>* m_job = nullptr;
+        size_t m_count = 0;
+        atomic<size_t> m_next{0};
+        atomic<size_t> m_failed{0};
+
+        size_t m_errorIndex = 0;
+        exception_ptr m_error;
+
+        void Worker();
+        void Process();
+    };
+
+    extern SocialValidationQueue SocialValidationQueueInst;
+}
+
+#endif // POCKETCONSENSUS_VALIDATIONQUEUE_H
@@ -20,13 +20,13 @@ namespace PocketConsensus
     {
     public:
         BlockingCancelConsensus(int height) : SocialConsensus<BlockingCancel>(height) {}
-        ConsensusValidateResult Validate(const CTransactionRef& tx, const BlockingCancelRef& ptx, const PocketBlockRef& block) override
+        ConsensusValidateResult Validate(const CTransactionRef& tx, const BlockingCancelRef& ptx, const SocialBlockContextRef& block) override
         {
             // Base validation with calling block or mempool check
             if (auto[baseValidate, baseValidateCode] = SocialConsensus::Validate(tx, ptx, block); !baseValidate)
                 return {false, baseValidateCode};
 
-            if (auto[existsBlocking, blockingType] = PocketDb::ConsensusRepoInst.GetLastBlockingType(
+            if (auto[existsBlocking, blockingType] = PocketDb::ConsensusRepo().GetLastBlockingType(
                     *ptx->GetAddress(),
                     *ptx->GetAddressTo()
                 ); !existsBlocking || blockingType != ACTION_BLOCKING)
@@ -54,15 +54,12 @@ namespace PocketConsensus
         }
 
     protected:
-        ConsensusValidateResult ValidateBlock(const BlockingCancelRef& ptx, const PocketBlockRef& block) override
+        ConsensusValidateResult ValidateBlock(const BlockingCancelRef& ptx, const SocialBlockContextRef& block) override
         {
 
             // Only one transaction (address -> addressTo) allowed in block
-            for (auto& blockTx : *block)
+            for (auto& blockTx : block->ByAddressTo(*ptx->GetAddress(), *ptx->GetAddressTo(), {ACTION_BLOCKING, ACTION_BLOCKING_CANCEL}))
             {
-                if (!TransactionHelper::IsIn(*blockTx->GetType(), {ACTION_BLOCKING, ACTION_BLOCKING_CANCEL}))
-                    continue;
-
                 if (*blockTx->GetHash() == *ptx->GetHash())
                     continue;
 
@@ -75,7 +72,7 @@ namespace PocketConsensus
         }
         ConsensusValidateResult ValidateMempool(const BlockingCancelRef& ptx) override
         {
-            if (ConsensusRepoInst.CountMempoolBlocking(*ptx->GetAddress(), *ptx->GetAddressTo()) > 0)
+            if (SocialMempool().CountByAddressTo(*ptx->GetAddress(), *ptx->GetAddressTo(), {ACTION_BLOCKING, ACTION_BLOCKING_CANCEL}) > 0)
                 return {false, SocialConsensusResult_ManyTransactions};
 
             return Success;
@@ -89,23 +86,12 @@ namespace PocketConsensus
     /*******************************************************************************************************************
     *  Factory for select actual rules version
     *******************************************************************************************************************/
-    class BlockingCancelConsensusFactory
+    class BlockingCancelConsensusFactory : public BaseConsensusFactory<BlockingCancelConsensus>
     {
-    protected:
-        const vector<ConsensusCheckpoint < BlockingCancelConsensus>> m_rules = {
-            { 0, 0, [](int height) { return make_shared<BlockingCancelConsensus>(height); }},
-        };
     public:
-        shared_ptr<BlockingCancelConsensus> Instance(int height)
-        {
-            int m_height = (height > 0 ? height : 0);
-            return (--upper_bound(m_rules.begin(), m_rules.end(), m_height,
-                [&](int target, const ConsensusCheckpoint<BlockingCancelConsensus>& itm)
-                {
-                    return target < itm.Height(Params().NetworkIDString());
-                }
-            ))->m_func(height);
-        }
+        BlockingCancelConsensusFactory() : BaseConsensusFactory<BlockingCancelConsensus>({
+            { 0, 0, [](int height) { return make_shared<BlockingCancelConsensus>(height); }},
+        }) {}
     };
 }
 
@@ -22,14 +22,14 @@ namespace PocketConsensus
     {
     public:
         CommentEditConsensus(int height) : SocialConsensus<CommentEdit>(height) {}
-        ConsensusValidateResult Validate(const CTransactionRef& tx, const CommentEditRef& ptx, const PocketBlockRef& block) override
+        ConsensusValidateResult Validate(const CTransactionRef& tx, const CommentEditRef& ptx, const SocialBlockContextRef& block) override
         {
             // Base validation with calling block or mempool check
             if (auto[baseValidate, baseValidateCode] = SocialConsensus::Validate(tx, ptx, block); !baseValidate)
                 return {false, baseValidateCode};
 
             // Actual comment not deleted
-            auto[actuallTxOk, actuallTx] = ConsensusRepoInst.GetLastContent(
+            auto[actuallTxOk, actuallTx] = ConsensusRepo().GetLastContent(
                 *ptx->GetRootTxHash(),
                 { CONTENT_COMMENT, CONTENT_COMMENT_EDIT, CONTENT_COMMENT_DELETE }
             );
@@ -37,7 +37,7 @@ namespace PocketConsensus
                 return {false, SocialConsensusResult_CommentDeletedEdit};
 
             // Original comment exists
-            auto[originalTxOk, originalTx] = PocketDb::ConsensusRepoInst.GetFirstContent(*ptx->GetRootTxHash());
+            auto[originalTxOk, originalTx] = PocketDb::ConsensusRepo().GetFirstContent(*ptx->GetRootTxHash());
             if (!actuallTxOk || !originalTxOk)
                 return {false, SocialConsensusResult_NotFound};
 
@@ -54,7 +54,7 @@ namespace PocketConsensus
                 if (!origParentTxHash.empty())
                 {
                     // TODO (brangr): replace to check exists not deleted comment
-                    if (auto[ok, origParentTx] = ConsensusRepoInst.GetLastContent(
+                    if (auto[ok, origParentTx] = ConsensusRepo().GetLastContent(
                         origParentTxHash, { CONTENT_COMMENT, CONTENT_COMMENT_EDIT }); !ok)
                         return {false, SocialConsensusResult_InvalidParentComment};
                 }
@@ -71,7 +71,7 @@ namespace PocketConsensus
                 if (!origAnswerTxHash.empty())
                 {
                     // TODO (brangr): replace to check exists not deleted comment
-                    if (auto[ok, origAnswerTx] = ConsensusRepoInst.GetLastContent(
+                    if (auto[ok, origAnswerTx] = ConsensusRepo().GetLastContent(
                         origAnswerTxHash, { CONTENT_COMMENT, CONTENT_COMMENT_EDIT }); !ok)
                         return {false, SocialConsensusResult_InvalidAnswerComment};
                 }
@@ -82,7 +82,7 @@ namespace PocketConsensus
                 return {false, SocialConsensusResult_CommentEditLimit};
 
             // Check exists content transaction
-            auto[contentOk, contentTx] = PocketDb::ConsensusRepoInst.GetLastContent(
+            auto[contentOk, contentTx] = PocketDb::ConsensusRepo().GetLastContent(
                 *ptx->GetPostTxHash(), { CONTENT_POST, CONTENT_VIDEO, CONTENT_ARTICLE, CONTENT_DELETE });
 
             if (!contentOk)
@@ -95,7 +95,7 @@ namespace PocketConsensus
 
             
             // Check Blocking
-            if (auto[existsBlocking, blockingType] = PocketDb::ConsensusRepoInst.GetLastBlockingType(
+            if (auto[existsBlocking, blockingType] = PocketDb::ConsensusRepo().GetLastBlockingType(
                     *contentTx->GetString1(), *ptx->GetAddress()
                 ); existsBlocking && blockingType == ACTION_BLOCKING)
                 return {false, SocialConsensusResult_Blocking};
@@ -128,13 +128,10 @@ namespace PocketConsensus
 
     protected:
 
-        ConsensusValidateResult ValidateBlock(const CommentEditRef& ptx, const PocketBlockRef& block) override
+        ConsensusValidateResult ValidateBlock(const CommentEditRef& ptx, const SocialBlockContextRef& block) override
         {
-            for (auto& blockTx : *block)
+            for (auto& blockTx : block->ByRoot(*ptx->GetRootTxHash(), {CONTENT_COMMENT, CONTENT_COMMENT_EDIT, CONTENT_COMMENT_DELETE}))
             {
-                if (!TransactionHelper::IsIn(*blockTx->GetType(), {CONTENT_COMMENT, CONTENT_COMMENT_EDIT, CONTENT_COMMENT_DELETE}))
-                    continue;
-
                 if (*blockTx->GetHash() == *ptx->GetHash())
                     continue;
 
@@ -147,7 +144,7 @@ namespace PocketConsensus
         }
         ConsensusValidateResult ValidateMempool(const CommentEditRef& ptx) override
         {
-            if (ConsensusRepoInst.CountMempoolCommentEdit(*ptx->GetAddress(), *ptx->GetRootTxHash()) > 0)
+            if (SocialMempool().CountByAddressTo(*ptx->GetAddress(), *ptx->GetRootTxHash(), {CONTENT_COMMENT, CONTENT_COMMENT_EDIT, CONTENT_COMMENT_DELETE}) > 0)
                 return {false, SocialConsensusResult_DoubleCommentEdit};
 
             return Success;
@@ -163,7 +160,7 @@ namespace PocketConsensus
         }
         virtual ConsensusValidateResult ValidateEditOneLimit(const CommentEditRef& ptx)
         {
-            int count = ConsensusRepoInst.CountChainCommentEdit(*ptx->GetAddress(), *ptx->GetRootTxHash());
+            int count = ConsensusRepo().CountChainCommentEdit(*ptx->GetAddress(), *ptx->GetRootTxHash());
             if (count >= GetConsensusLimit(ConsensusLimit_comment_edit_count))
                 return {false, SocialConsensusResult_CommentEditLimit};
 
@@ -190,7 +187,7 @@ namespace PocketConsensus
     protected:
         bool AllowEditWindow(const CommentEditRef& ptx, const CommentEditRef& originalTx) override
         {
-            auto[ok, originalTxHeight] = ConsensusRepoInst.GetTransactionHeight(*originalTx->GetHash());
+            auto[ok, originalTxHeight] = ConsensusRepo().GetTransactionHeight(*originalTx->GetHash());
             if (!ok) return false;
             return (Height - originalTxHeight) <= GetConsensusLimit(ConsensusLimit_edit_comment_depth);
         }
@@ -199,24 +196,13 @@ namespace PocketConsensus
     /*******************************************************************************************************************
     *  Factory for select actual rules version
     *******************************************************************************************************************/
-    class CommentEditConsensusFactory
+    class CommentEditConsensusFactory : public BaseConsensusFactory<CommentEditConsensus>
     {
-    private:
-        const vector<ConsensusCheckpoint < CommentEditConsensus>> m_rules = {
+    public:
+        CommentEditConsensusFactory() : BaseConsensusFactory<CommentEditConsensus>({
             { 0, -1, [](int height) { return make_shared<CommentEditConsensus>(height); }},
             { 1180000, 0, [](int height) { return make_shared<CommentEditConsensus_checkpoint_1180000>(height); }},
-        };
-    public:
-        shared_ptr<CommentEditConsensus> Instance(int height)
-        {
-            int m_height = (height > 0 ? height : 0);
-            return (--upper_bound(m_rules.begin(), m_rules.end(), m_height,
-                [&](int target, const ConsensusCheckpoint<CommentEditConsensus>& itm)
-                {
-                    return target < itm.Height(Params().NetworkIDString());
-                }
-            ))->m_func(height);
-        }
+        }) {}
     };
 }
 
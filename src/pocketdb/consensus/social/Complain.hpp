@@ -21,14 +21,14 @@ namespace PocketConsensus
     {
     public:
         ComplainConsensus(int height) : SocialConsensus<Complain>(height) {}
-        ConsensusValidateResult Validate(const CTransactionRef& tx, const ComplainRef& ptx, const PocketBlockRef& block) override
+        ConsensusValidateResult Validate(const CTransactionRef& tx, const ComplainRef& ptx, const SocialBlockContextRef& block) override
         {
             // Base validation with calling block or mempool check
             if (auto[baseValidate, baseValidateCode] = SocialConsensus::Validate(tx, ptx, block); !baseValidate)
                 return {false, baseValidateCode};
 
             // Author or post must be exists
-            auto[lastContentOk, lastContent] = PocketDb::ConsensusRepoInst.GetLastContent(
+            auto[lastContentOk, lastContent] = PocketDb::ConsensusRepo().GetLastContent(
                 *ptx->GetPostTxHash(),
                 {CONTENT_POST, CONTENT_VIDEO, CONTENT_ARTICLE, CONTENT_DELETE}
             );
@@ -36,18 +36,9 @@ namespace PocketConsensus
             if (!lastContentOk && block)
             {
                 // ... or in block
-                for (auto& blockTx : *block)
-                {
-                    if (!TransactionHelper::IsIn(*blockTx->GetType(), {CONTENT_POST, CONTENT_VIDEO, CONTENT_ARTICLE, CONTENT_DELETE}))
-                        continue;
-
-                    // TODO (brangr): convert to Content base class
-                    if (*blockTx->GetString2() == *ptx->GetPostTxHash())
-                    {
-                        lastContent = blockTx;
-                        break;
-                    }
-                }
+                auto blockContents = block->ByRoot(*ptx->GetPostTxHash(), {CONTENT_POST, CONTENT_VIDEO, CONTENT_ARTICLE, CONTENT_DELETE});
+                if (!blockContents.empty())
+                    lastContent = blockContents.front();
             }
             if (!lastContent)
                 return {false, SocialConsensusResult_NotFound};
@@ -60,7 +51,7 @@ namespace PocketConsensus
                 return {false, SocialConsensusResult_ComplainDeletedContent};
 
             // Check double complain
-            if (PocketDb::ConsensusRepoInst.ExistsComplain(*ptx->GetPostTxHash(), *ptx->GetAddress()))
+            if (PocketDb::ConsensusRepo().ExistsComplain(*ptx->GetPostTxHash(), *ptx->GetAddress()))
                 return {false, SocialConsensusResult_DoubleComplain};
 
             return Success;
@@ -79,15 +70,12 @@ namespace PocketConsensus
         }
 
     protected:
-        ConsensusValidateResult ValidateBlock(const ComplainRef& ptx, const PocketBlockRef& block) override
+        ConsensusValidateResult ValidateBlock(const ComplainRef& ptx, const SocialBlockContextRef& block) override
         {
             int count = GetChainCount(ptx);
 
-            for (auto& blockTx : *block)
+            for (auto& blockTx : block->ByAddress(*ptx->GetAddress(), {ACTION_COMPLAIN}))
             {
-                if (!TransactionHelper::IsIn(*blockTx->GetType(), {ACTION_COMPLAIN}))
-                    continue;
-
                 if (*blockTx->GetHash() == *ptx->GetHash())
                     continue;
 
@@ -111,7 +99,7 @@ namespace PocketConsensus
         ConsensusValidateResult ValidateMempool(const ComplainRef& ptx) override
         {
             int count = GetChainCount(ptx);
-            count += ConsensusRepoInst.CountMempoolComplain(*ptx->GetAddress());
+            count += SocialMempool().CountByAddress(*ptx->GetAddress(), {ACTION_COMPLAIN}, true);
             return ValidateLimit(ptx, count);
         }
         vector<string> GetAddressesForCheckRegistration(const ComplainRef& ptx) override
@@ -144,7 +132,7 @@ namespace PocketConsensus
         }
         virtual int GetChainCount(const ComplainRef& ptx)
         {
-            return ConsensusRepoInst.CountChainComplainTime(
+            return ConsensusRepo().CountChainComplainTime(
                 *ptx->GetAddress(),
                 *ptx->GetTime() - GetConsensusLimit(ConsensusLimit_depth)
             );
@@ -175,7 +163,7 @@ namespace PocketConsensus
     protected:
         int GetChainCount(const ComplainRef& ptx) override
         {
-            return ConsensusRepoInst.CountChainComplainHeight(*ptx->GetAddress(), Height - (int) GetConsensusLimit(ConsensusLimit_depth));
+            return ConsensusRepo().CountChainComplainHeight(*ptx->GetAddress(), Height - (int) GetConsensusLimit(ConsensusLimit_depth));
         }
     };
 
@@ -183,25 +171,14 @@ namespace PocketConsensus
     /*******************************************************************************************************************
     *  Factory for select actual rules version
     *******************************************************************************************************************/
-    class ComplainConsensusFactory
+    class ComplainConsensusFactory : public BaseConsensusFactory<ComplainConsensus>
     {
-    private:
-        const vector<ConsensusCheckpoint < ComplainConsensus>> m_rules = {
+    public:
+        ComplainConsensusFactory() : BaseConsensusFactory<ComplainConsensus>({
             { 0, -1, [](int height) { return make_shared<ComplainConsensus>(height); }},
             { 1124000, -1, [](int height) { return make_shared<ComplainConsensus_checkpoint_1124000>(height); }},
             { 1180000, 0, [](int height) { return make_shared<ComplainConsensus_checkpoint_1180000>(height); }},
-        };
-    public:
-        shared_ptr<ComplainConsensus> Instance(int height)
-        {
-            int m_height = (height > 0 ? height : 0);
-            return (--upper_bound(m_rules.begin(), m_rules.end(), m_height,
-                [&](int target, const ConsensusCheckpoint<ComplainConsensus>& itm)
-                {
-                    return target < itm.Height(Params().NetworkIDString());
-                }
-            ))->m_func(height);
-        }
+        }) {}
     };
 }
 
@@ -20,14 +20,14 @@ namespace PocketConsensus
     {
     public:
         ContentDeleteConsensus(int height) : SocialConsensus<ContentDelete>(height) {}
-        ConsensusValidateResult Validate(const CTransactionRef& tx, const ContentDeleteRef& ptx, const PocketBlockRef& block) override
+        ConsensusValidateResult Validate(const CTransactionRef& tx, const ContentDeleteRef& ptx, const SocialBlockContextRef& block) override
         {
             // Base validation with calling block or mempool check
             if (auto[baseValidate, baseValidateCode] = SocialConsensus::Validate(tx, ptx, block); !baseValidate)
                 return {false, baseValidateCode};
 
             // Actual content not deleted
-            auto[ok, actuallTx] = ConsensusRepoInst.GetLastContent(
+            auto[ok, actuallTx] = ConsensusRepo().GetLastContent(
                 *ptx->GetRootTxHash(),
                 { CONTENT_POST, CONTENT_VIDEO, CONTENT_ARTICLE, CONTENT_DELETE }
             );
@@ -58,26 +58,21 @@ namespace PocketConsensus
         }
 
     protected:
-        ConsensusValidateResult ValidateBlock(const ContentDeleteRef& ptx, const PocketBlockRef& block) override
+        ConsensusValidateResult ValidateBlock(const ContentDeleteRef& ptx, const SocialBlockContextRef& block) override
         {
-            for (auto& blockTx : *block)
+            for (auto& blockTx : block->ByRoot(*ptx->GetRootTxHash(), {CONTENT_POST, CONTENT_VIDEO, CONTENT_ARTICLE, CONTENT_DELETE}))
             {
-                if (!TransactionHelper::IsIn(*blockTx->GetType(), {CONTENT_POST, CONTENT_VIDEO, CONTENT_ARTICLE, CONTENT_DELETE}))
-                    continue;
-
                 if (*blockTx->GetHash() == *ptx->GetHash())
                     continue;
 
-                // TODO (brangr): convert to content base class
-                if (*ptx->GetRootTxHash() == *blockTx->GetString2())
-                    return {false, SocialConsensusResult_ContentDeleteDouble};
+                return {false, SocialConsensusResult_ContentDeleteDouble};
             }
 
             return Success;
         }
         ConsensusValidateResult ValidateMempool(const ContentDeleteRef& ptx) override
         {
-            if (ConsensusRepoInst.CountMempoolContentDelete(*ptx->GetAddress(), *ptx->GetRootTxHash()) > 0)
+            if (SocialMempool().CountByAddressTo(*ptx->GetAddress(), *ptx->GetRootTxHash(), {CONTENT_POST, CONTENT_VIDEO, CONTENT_ARTICLE, CONTENT_DELETE}) > 0)
                 return {false, SocialConsensusResult_ContentDeleteDouble};
 
             return Success;
@@ -91,23 +86,12 @@ namespace PocketConsensus
     /*******************************************************************************************************************
     *  Factory for select actual rules version
     *******************************************************************************************************************/
-    class ContentDeleteConsensusFactory
+    class ContentDeleteConsensusFactory : public BaseConsensusFactory<ContentDeleteConsensus>
     {
-    private:
-        const vector<ConsensusCheckpoint < ContentDeleteConsensus>> m_rules = {
-            { 0, 0, [](int height) { return make_shared<ContentDeleteConsensus>(height); }},
-        };
     public:
-        shared_ptr<ContentDeleteConsensus> Instance(int height)
-        {
-            int m_height = (height > 0 ? height : 0);
-            return (--upper_bound(m_rules.begin(), m_rules.end(), m_height,
-                [&](int target, const ConsensusCheckpoint<ContentDeleteConsensus>& itm)
-                {
-                    return target < itm.Height(Params().NetworkIDString());
-                }
-            ))->m_func(height);
-        }
+        ContentDeleteConsensusFactory() : BaseConsensusFactory<ContentDeleteConsensus>({
+            { 0, 0, [](int height) { return make_shared<ContentDeleteConsensus>(height); }},
+        }) {}
     };
 }
 
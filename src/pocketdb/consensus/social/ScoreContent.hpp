@@ -22,18 +22,18 @@ namespace PocketConsensus
     public:
         ScoreContentConsensus(int height) : SocialConsensus<ScoreContent>(height) {}
 
-        ConsensusValidateResult Validate(const CTransactionRef& tx, const ScoreContentRef& ptx, const PocketBlockRef& block) override
+        ConsensusValidateResult Validate(const CTransactionRef& tx, const ScoreContentRef& ptx, const SocialBlockContextRef& block) override
         {
             // Base validation with calling block or mempool check
             if (auto[baseValidate, baseValidateCode] = SocialConsensus::Validate(tx, ptx, block); !baseValidate)
                 return {false, baseValidateCode};
 
             // Check already scored content
-            if (PocketDb::ConsensusRepoInst.ExistsScore(*ptx->GetAddress(), *ptx->GetContentTxHash(), ACTION_SCORE_CONTENT, false))
+            if (PocketDb::ConsensusRepo().ExistsScore(*ptx->GetAddress(), *ptx->GetContentTxHash(), ACTION_SCORE_CONTENT, false))
                 return {false, SocialConsensusResult_DoubleScore};
 
             // Content should be exists in chain
-            auto[lastContentOk, lastContent] = PocketDb::ConsensusRepoInst.GetLastContent(
+            auto[lastContentOk, lastContent] = PocketDb::ConsensusRepo().GetLastContent(
                 *ptx->GetContentTxHash(),
                 { CONTENT_POST, CONTENT_VIDEO, CONTENT_ARTICLE, CONTENT_DELETE }
             );
@@ -41,18 +41,9 @@ namespace PocketConsensus
             if (!lastContentOk && block)
             {
                 // ... or in block
-                for (auto& blockTx : *block)
-                {
-                    if (!TransactionHelper::IsIn(*blockTx->GetType(), {CONTENT_POST, CONTENT_VIDEO, CONTENT_ARTICLE, CONTENT_DELETE}))
-                        continue;
-
-                    // TODO (brangr): convert to Content base class
-                    if (*blockTx->GetString2() == *ptx->GetContentTxHash())
-                    {
-                        lastContent = blockTx;
-                        break;
-                    }
-                }
+                auto blockContents = block->ByRoot(*ptx->GetContentTxHash(), {CONTENT_POST, CONTENT_VIDEO, CONTENT_ARTICLE, CONTENT_DELETE});
+                if (!blockContents.empty())
+                    lastContent = blockContents.front();
             }
             if (!lastContent)
                 return {false, SocialConsensusResult_NotFound};
@@ -100,17 +91,14 @@ namespace PocketConsensus
         }
 
     protected:
-        ConsensusValidateResult ValidateBlock(const ScoreContentRef& ptx, const PocketBlockRef& block) override
+        ConsensusValidateResult ValidateBlock(const ScoreContentRef& ptx, const SocialBlockContextRef& block) override
         {
             // Get count from chain
             int count = GetChainCount(ptx);
 
             // Get count from block
-            for (auto& blockTx : *block)
+            for (auto& blockTx : block->ByAddress(*ptx->GetAddress(), {ACTION_SCORE_CONTENT}))
             {
-                if (!TransactionHelper::IsIn(*blockTx->GetType(), {ACTION_SCORE_CONTENT}))
-                    continue;
-
                 if (*blockTx->GetHash() == *ptx->GetHash())
                     continue;
 
@@ -132,7 +120,7 @@ namespace PocketConsensus
         ConsensusValidateResult ValidateMempool(const ScoreContentRef& ptx) override
         {
             // Check already scored content
-            if (PocketDb::ConsensusRepoInst.ExistsScore(
+            if (PocketDb::ConsensusRepo().ExistsScore(
                 *ptx->GetAddress(), *ptx->GetContentTxHash(), ACTION_SCORE_CONTENT, true))
                 return {false, SocialConsensusResult_DoubleScore};
 
@@ -140,7 +128,7 @@ namespace PocketConsensus
             int count = GetChainCount(ptx);
 
             // Get count from mempool
-            count += ConsensusRepoInst.CountMempoolScoreContent(*ptx->GetAddress());
+            count += SocialMempool().CountByAddress(*ptx->GetAddress(), {ACTION_SCORE_CONTENT});
 
             // Check count
             return ValidateLimit(ptx, count);
@@ -180,7 +168,7 @@ namespace PocketConsensus
         }
         virtual int GetChainCount(const ScoreContentRef& ptx)
         {
-            return ConsensusRepoInst.CountChainScoreContentTime(
+            return ConsensusRepo().CountChainScoreContentTime(
                 *ptx->GetAddress(),
                 *ptx->GetTime() - GetConsensusLimit(ConsensusLimit_depth)
             );
@@ -199,7 +187,7 @@ namespace PocketConsensus
     protected:
         ConsensusValidateResult ValidateBlocking(const string& contentAddress, const ScoreContentRef& ptx) override
         {
-            auto[existsBlocking, blockingType] = PocketDb::ConsensusRepoInst.GetLastBlockingType(
+            auto[existsBlocking, blockingType] = PocketDb::ConsensusRepo().GetLastBlockingType(
                 contentAddress,
                 *ptx->GetAddress()
             );
@@ -249,7 +237,7 @@ namespace PocketConsensus
     protected:
         int GetChainCount(const ScoreContentRef& ptx) override
         {
-            return ConsensusRepoInst.CountChainScoreContentHeight(
+            return ConsensusRepo().CountChainScoreContentHeight(
                 *ptx->GetAddress(),
                 Height - (int) GetConsensusLimit(ConsensusLimit_depth)
             );
@@ -273,28 +261,17 @@ namespace PocketConsensus
     /*******************************************************************************************************************
     *  Factory for select actual rules version
     *******************************************************************************************************************/
-    class ScoreContentConsensusFactory
+    class ScoreContentConsensusFactory : public BaseConsensusFactory<ScoreContentConsensus>
     {
-    private:
-        const vector<ConsensusCheckpoint < ScoreContentConsensus>> m_rules = {
+    public:
+        ScoreContentConsensusFactory() : BaseConsensusFactory<ScoreContentConsensus>({
             { 0,          -1, [](int height) { return make_shared<ScoreContentConsensus>(height); }},
             { 430000,     -1, [](int height) { return make_shared<ScoreContentConsensus_checkpoint_430000>(height); }},
             { 514184,     -1, [](int height) { return make_shared<ScoreContentConsensus_checkpoint_514184>(height); }},
             { 1124000,    -1, [](int height) { return make_shared<ScoreContentConsensus_checkpoint_1124000>(height); }},
             { 1180000,     0, [](int height) { return make_shared<ScoreContentConsensus_checkpoint_1180000>(height); }},
             { 1324655, 65000, [](int height) { return make_shared<ScoreContentConsensus_checkpoint_1324655>(height); }},
-        };
-    public:
-        shared_ptr<ScoreContentConsensus> Instance(int height)
-        {
-            int m_height = (height > 0 ? height : 0);
-            return (--upper_bound(m_rules.begin(), m_rules.end(), m_height,
-                [&](int target, const ConsensusCheckpoint<ScoreContentConsensus>& itm)
-                {
-                    return target < itm.Height(Params().NetworkIDString());
-                }
-            ))->m_func(height);
-        }
+        }) {}
     };
 }
 
@@ -21,13 +21,13 @@ namespace PocketConsensus
     {
     public:
         SubscribeConsensus(int height) : SocialConsensus<Subscribe>(height) {}
-        ConsensusValidateResult Validate(const CTransactionRef& tx, const SubscribeRef& ptx, const PocketBlockRef& block) override
+        ConsensusValidateResult Validate(const CTransactionRef& tx, const SubscribeRef& ptx, const SocialBlockContextRef& block) override
         {
             // Base validation with calling block or mempool check
             if (auto[baseValidate, baseValidateCode] = SocialConsensus::Validate(tx, ptx, block); !baseValidate)
                 return {false, baseValidateCode};
 
-            auto[subscribeExists, subscribeType] = PocketDb::ConsensusRepoInst.GetLastSubscribeType(
+            auto[subscribeExists, subscribeType] = PocketDb::ConsensusRepo().GetLastSubscribeType(
                 *ptx->GetAddress(),
                 *ptx->GetAddressTo());
 
@@ -56,14 +56,11 @@ namespace PocketConsensus
         }
 
     protected:
-        ConsensusValidateResult ValidateBlock(const SubscribeRef& ptx, const PocketBlockRef& block) override
+        ConsensusValidateResult ValidateBlock(const SubscribeRef& ptx, const SocialBlockContextRef& block) override
         {
             // Only one transaction (address -> addressTo) allowed in block
-            for (auto& blockTx : *block)
+            for (auto& blockTx : block->ByAddressTo(*ptx->GetAddress(), *ptx->GetAddressTo(), {ACTION_SUBSCRIBE, ACTION_SUBSCRIBE_PRIVATE, ACTION_SUBSCRIBE_CANCEL}))
             {
-                if (!TransactionHelper::IsIn(*blockTx->GetType(), {ACTION_SUBSCRIBE, ACTION_SUBSCRIBE_PRIVATE, ACTION_SUBSCRIBE_CANCEL}))
-                    continue;
-
                 auto blockPtx = static_pointer_cast<Subscribe>(blockTx);
 
                 if (*blockPtx->GetHash() == *ptx->GetHash())
@@ -80,9 +77,10 @@ namespace PocketConsensus
         }
         ConsensusValidateResult ValidateMempool(const SubscribeRef& ptx) override
         {
-            int mempoolCount = ConsensusRepoInst.CountMempoolSubscribe(
+            int mempoolCount = SocialMempool().CountByAddressTo(
                 *ptx->GetAddress(),
-                *ptx->GetAddressTo()
+                *ptx->GetAddressTo(),
+                {ACTION_SUBSCRIBE, ACTION_SUBSCRIBE_PRIVATE, ACTION_SUBSCRIBE_CANCEL}
             );
 
             if (mempoolCount > 0)
@@ -99,23 +97,12 @@ namespace PocketConsensus
     /*******************************************************************************************************************
     *  Factory for select actual rules version
     *******************************************************************************************************************/
-    class SubscribeConsensusFactory
+    class SubscribeConsensusFactory : public BaseConsensusFactory<SubscribeConsensus>
     {
-    private:
-        const vector<ConsensusCheckpoint < SubscribeConsensus>> m_rules = {
-            { 0, 0, [](int height) { return make_shared<SubscribeConsensus>(height); }},
-        };
     public:
-        shared_ptr<SubscribeConsensus> Instance(int height)
-        {
-            int m_height = (height > 0 ? height : 0);
-            return (--upper_bound(m_rules.begin(), m_rules.end(), m_height,
-                [&](int target, const ConsensusCheckpoint<SubscribeConsensus>& itm)
-                {
-                    return target < itm.Height(Params().NetworkIDString());
-                }
-            ))->m_func(height);
-        }
+        SubscribeConsensusFactory() : BaseConsensusFactory<SubscribeConsensus>({
+            { 0, 0, [](int height) { return make_shared<SubscribeConsensus>(height); }},
+        }) {}
     };
 }
 
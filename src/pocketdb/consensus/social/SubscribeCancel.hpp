@@ -21,14 +21,14 @@ namespace PocketConsensus
     {
     public:
         SubscribeCancelConsensus(int height) : SocialConsensus<SubscribeCancel>(height) {}
-        ConsensusValidateResult Validate(const CTransactionRef& tx, const SubscribeCancelRef& ptx, const PocketBlockRef& block) override
+        ConsensusValidateResult Validate(const CTransactionRef& tx, const SubscribeCancelRef& ptx, const SocialBlockContextRef& block) override
         {
             // Base validation with calling block or mempool check
             if (auto[baseValidate, baseValidateCode] = SocialConsensus::Validate(tx, ptx, block); !baseValidate)
                 return {false, baseValidateCode};
 
             // Last record not valid subscribe
-            auto[subscribeExists, subscribeType] = PocketDb::ConsensusRepoInst.GetLastSubscribeType(
+            auto[subscribeExists, subscribeType] = PocketDb::ConsensusRepo().GetLastSubscribeType(
                 *ptx->GetAddress(),
                 *ptx->GetAddressTo());
 
@@ -57,14 +57,11 @@ namespace PocketConsensus
         }
 
     protected:
-        ConsensusValidateResult ValidateBlock(const SubscribeCancelRef& ptx, const PocketBlockRef& block) override
+        ConsensusValidateResult ValidateBlock(const SubscribeCancelRef& ptx, const SocialBlockContextRef& block) override
         {
             // Only one transaction (address -> addressTo) allowed in block
-            for (auto& blockTx : *block)
+            for (auto& blockTx : block->ByAddressTo(*ptx->GetAddress(), *ptx->GetAddressTo(), {ACTION_SUBSCRIBE, ACTION_SUBSCRIBE_PRIVATE, ACTION_SUBSCRIBE_CANCEL}))
             {
-                if (!TransactionHelper::IsIn(*blockTx->GetType(), {ACTION_SUBSCRIBE, ACTION_SUBSCRIBE_PRIVATE, ACTION_SUBSCRIBE_CANCEL}))
-                    continue;
-
                 auto blockPtx = static_pointer_cast<SubscribeCancel>(blockTx);
 
                 if (*blockPtx->GetHash() == *ptx->GetHash())
@@ -81,9 +78,10 @@ namespace PocketConsensus
         }
         ConsensusValidateResult ValidateMempool(const SubscribeCancelRef& ptx) override
         {
-            int mempoolCount = ConsensusRepoInst.CountMempoolSubscribe(
+            int mempoolCount = SocialMempool().CountByAddressTo(
                 *ptx->GetAddress(),
-                *ptx->GetAddressTo()
+                *ptx->GetAddressTo(),
+                {ACTION_SUBSCRIBE, ACTION_SUBSCRIBE_PRIVATE, ACTION_SUBSCRIBE_CANCEL}
             );
 
             if (mempoolCount > 0)
@@ -100,23 +98,12 @@ namespace PocketConsensus
     /*******************************************************************************************************************
     *  Factory for select actual rules version
     *******************************************************************************************************************/
-    class SubscribeCancelConsensusFactory
+    class SubscribeCancelConsensusFactory : public BaseConsensusFactory<SubscribeCancelConsensus>
     {
-    private:
-        const vector<ConsensusCheckpoint<SubscribeCancelConsensus>> m_rules = {
-            {0, 0, [](int height) { return make_shared<SubscribeCancelConsensus>(height); }},
-        };
     public:
-        shared_ptr<SubscribeCancelConsensus> Instance(int height)
-        {
-            int m_height = (height > 0 ? height : 0);
-            return (--upper_bound(m_rules.begin(), m_rules.end(), m_height,
-                [&](int target, const ConsensusCheckpoint<SubscribeCancelConsensus>& itm)
-                {
-                    return target < itm.Height(Params().NetworkIDString());
-                }
-            ))->m_func(height);
-        }
+        SubscribeCancelConsensusFactory() : BaseConsensusFactory<SubscribeCancelConsensus>({
+            {0, 0, [](int height) { return make_shared<SubscribeCancelConsensus>(height); }},
+        }) {}
     };
 }
 
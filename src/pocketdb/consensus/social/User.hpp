@@ -22,14 +22,14 @@ namespace PocketConsensus
     {
     public:
         UserConsensus(int height) : SocialConsensus<User>(height) {}
-        ConsensusValidateResult Validate(const CTransactionRef& tx, const UserRef& ptx, const PocketBlockRef& block) override
+        ConsensusValidateResult Validate(const CTransactionRef& tx, const UserRef& ptx, const SocialBlockContextRef& block) override
         {
             // Base validation with calling block or mempool check
             if (auto[baseValidate, baseValidateCode] = SocialConsensus::Validate(tx, ptx, block); !baseValidate)
                 return {false, baseValidateCode};
 
             // Duplicate name
-            if (ConsensusRepoInst.ExistsAnotherByName(*ptx->GetAddress(), *ptx->GetPayloadName()))
+            if (ConsensusRepo().ExistsAnotherByName(*ptx->GetAddress(), *ptx->GetPayloadName()))
             {
                 if (!CheckpointRepoInst.IsSocialCheckpoint(*ptx->GetHash(), *ptx->GetType(), SocialConsensusResult_NicknameDouble))
                     return {false, SocialConsensusResult_NicknameDouble};
@@ -68,14 +68,16 @@ namespace PocketConsensus
         }
 
     protected:
-        ConsensusValidateResult ValidateBlock(const UserRef& ptx, const PocketBlockRef& block) override
+        ConsensusValidateResult ValidateBlock(const UserRef& ptx, const SocialBlockContextRef& block) override
         {
-            // Only one transaction allowed in block
-            for (auto& blockTx: *block)
-            {
-                if (!TransactionHelper::IsIn(*blockTx->GetType(), {ACCOUNT_USER}))
-                    continue;
+            // Only one transaction allowed in block.
+            // Other accounts of block can conflict only by name
+            auto blockTxs = block->ByAddress(*ptx->GetAddress(), {ACCOUNT_USER});
+            if (const auto& name = ptx->GetPayloadName(); name)
+                blockTxs = block->Union(blockTxs, block->ByUserName(*name));
 
+            for (auto& blockTx : blockTxs)
+            {
                 if (*blockTx->GetHash() == *ptx->GetHash())
                     continue;
 
@@ -97,7 +99,7 @@ namespace PocketConsensus
         }
         ConsensusValidateResult ValidateMempool(const UserRef& ptx) override
         {
-            if (ConsensusRepoInst.CountMempoolUser(*ptx->GetAddress()) > 0)
+            if (SocialMempool().CountByAddress(*ptx->GetAddress(), {ACCOUNT_USER}) > 0)
                 return {false, SocialConsensusResult_ChangeInfoDoubleInMempool};
 
             if (GetChainCount(ptx) > GetConsensusLimit(ConsensusLimit_edit_user_daily_count))
@@ -113,7 +115,7 @@ namespace PocketConsensus
         virtual ConsensusValidateResult ValidateEdit(const UserRef& ptx)
         {
             // First user account transaction allowed without next checks
-            if (auto[ok, prevTxHeight] = ConsensusRepoInst.GetLastAccountHeight(*ptx->GetAddress()); !ok)
+            if (auto[ok, prevTxHeight] = ConsensusRepo().GetLastAccountHeight(*ptx->GetAddress()); !ok)
                 return Success;
 
             // Check editing limits
@@ -126,7 +128,7 @@ namespace PocketConsensus
         virtual ConsensusValidateResult ValidateEditLimit(const UserRef& ptx)
         {
             // First user account transaction allowed without next checks
-            auto[prevOk, prevTime] = ConsensusRepoInst.GetLastAccountTime(*ptx->GetAddress());
+            auto[prevOk, prevTime] = ConsensusRepo().GetLastAccountTime(*ptx->GetAddress());
             if (!prevOk)
                 return Success;
 
@@ -192,7 +194,7 @@ namespace PocketConsensus
         ConsensusValidateResult ValidateEditLimit(const UserRef& ptx) override
         {
             // First user account transaction allowed without next checks
-            auto[ok, prevTxHeight] = ConsensusRepoInst.GetLastAccountHeight(*ptx->GetAddress());
+            auto[ok, prevTxHeight] = ConsensusRepo().GetLastAccountHeight(*ptx->GetAddress());
             if (!ok) return Success;
 
             // We allow edit profile only with delay
@@ -217,7 +219,7 @@ namespace PocketConsensus
         }
         int GetChainCount(const UserRef& ptx) override
         {
-            return ConsensusRepoInst.CountChainAccount(
+            return ConsensusRepo().CountChainAccount(
                 *ptx->GetType(),
                 *ptx->GetAddress(),
                 Height - (int)GetConsensusLimit(ConsensusLimit_depth)
@@ -283,26 +285,15 @@ namespace PocketConsensus
     /*******************************************************************************************************************
     *  Factory for select actual rules version
     *******************************************************************************************************************/
-    class UserConsensusFactory
+    class UserConsensusFactory : public BaseConsensusFactory<UserConsensus>
     {
-    private:
-        const vector<ConsensusCheckpoint<UserConsensus>> m_rules = {
+    public:
+        UserConsensusFactory() : BaseConsensusFactory<UserConsensus>({
             {       0,     -1, [](int height) { return make_shared<UserConsensus>(height); }},
             { 1180000,      0, [](int height) { return make_shared<UserConsensus_checkpoint_1180000>(height); }},
             { 1381841, 162000, [](int height) { return make_shared<UserConsensus_checkpoint_1381841>(height); }},
             { 1647000, 650000, [](int height) { return make_shared<UserConsensus_checkpoint_login_limitation>(height); }}, // ~ 03/25/2022
-        };
-    public:
-        shared_ptr<UserConsensus> Instance(int height)
-        {
-            int m_height = (height > 0 ? height : 0);
-            return (--upper_bound(m_rules.begin(), m_rules.end(), m_height,
-                [&](int target, const ConsensusCheckpoint<UserConsensus>& itm)
-                {
-                    return target < itm.Height(Params().NetworkIDString());
-                }
-            ))->m_func(height);
-        }
+        }) {}
     };
 
 } // namespace PocketConsensus
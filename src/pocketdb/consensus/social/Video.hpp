@@ -21,7 +21,7 @@ namespace PocketConsensus
     {
     public:
         VideoConsensus(int height) : SocialConsensus<Video>(height) {}
-        ConsensusValidateResult Validate(const CTransactionRef& tx, const VideoRef& ptx, const PocketBlockRef& block) override
+        ConsensusValidateResult Validate(const CTransactionRef& tx, const VideoRef& ptx, const SocialBlockContextRef& block) override
         {
             // Base validation with calling block or mempool check
             if (auto[baseValidate, baseValidateCode] = SocialConsensus::Validate(tx, ptx, block); !baseValidate)
@@ -60,7 +60,7 @@ namespace PocketConsensus
                      : GetConsensusLimit(ConsensusLimit_trial_video);
         }
 
-        ConsensusValidateResult ValidateBlock(const VideoRef& ptx, const PocketBlockRef& block) override
+        ConsensusValidateResult ValidateBlock(const VideoRef& ptx, const SocialBlockContextRef& block) override
         {
             // Edit
             if (ptx->IsEdit())
@@ -73,11 +73,8 @@ namespace PocketConsensus
             int count = GetChainCount(ptx);
 
             // Get count from block
-            for (auto& blockTx : *block)
+            for (auto& blockTx : block->ByAddress(*ptx->GetAddress(), {CONTENT_VIDEO}))
             {
-                if (!TransactionHelper::IsIn(*blockTx->GetType(), {CONTENT_VIDEO}))
-                    continue;
-
                 auto blockPtx = static_pointer_cast<Video>(blockTx);
 
                 if (*ptx->GetAddress() != *blockPtx->GetAddress())
@@ -108,7 +105,7 @@ namespace PocketConsensus
             int count = GetChainCount(ptx);
 
             // and from mempool
-            count += ConsensusRepoInst.CountMempoolVideo(*ptx->GetAddress());
+            count += SocialMempool().CountByAddress(*ptx->GetAddress(), {CONTENT_VIDEO}, true);
 
             return ValidateLimit(ptx, count);
         }
@@ -120,7 +117,7 @@ namespace PocketConsensus
         virtual ConsensusValidateResult ValidateEdit(const VideoRef& ptx)
         {
             // TODO (brangr): change with check deleted content
-            auto[lastContentOk, lastContent] = PocketDb::ConsensusRepoInst.GetLastContent(
+            auto[lastContentOk, lastContent] = PocketDb::ConsensusRepo().GetLastContent(
                 *ptx->GetRootTxHash(),
                 { CONTENT_POST, CONTENT_VIDEO, CONTENT_DELETE }
             );
@@ -128,7 +125,7 @@ namespace PocketConsensus
                 return {false, SocialConsensusResult_NotAllowed};
 
             // First get original post transaction
-            auto[originalTxOk, originalTx] = PocketDb::ConsensusRepoInst.GetFirstContent(*ptx->GetRootTxHash());
+            auto[originalTxOk, originalTx] = PocketDb::ConsensusRepo().GetFirstContent(*ptx->GetRootTxHash());
             if (!lastContentOk || !originalTxOk)
                 return {false, SocialConsensusResult_NotFound};
 
@@ -163,20 +160,17 @@ namespace PocketConsensus
         virtual int GetChainCount(const VideoRef& ptx)
         {
 
-            return ConsensusRepoInst.CountChainVideo(
+            return ConsensusRepo().CountChainVideo(
                 *ptx->GetAddress(),
                 Height - (int)GetConsensusLimit(ConsensusLimit_depth)
             );
         }
-        virtual ConsensusValidateResult ValidateEditBlock(const VideoRef& ptx, const PocketBlockRef& block)
+        virtual ConsensusValidateResult ValidateEditBlock(const VideoRef& ptx, const SocialBlockContextRef& block)
         {
 
             // Double edit in block not allowed
-            for (auto& blockTx : *block)
+            for (auto& blockTx : block->ByRoot(*ptx->GetRootTxHash(), {CONTENT_VIDEO, CONTENT_DELETE}))
             {
-                if (!TransactionHelper::IsIn(*blockTx->GetType(), {CONTENT_VIDEO, CONTENT_DELETE}))
-                    continue;
-
                 auto blockPtx = static_pointer_cast<Video>(blockTx);
 
                 if (*blockPtx->GetHash() == *ptx->GetHash())
@@ -192,7 +186,7 @@ namespace PocketConsensus
         virtual ConsensusValidateResult ValidateEditMempool(const VideoRef& ptx)
         {
 
-            if (ConsensusRepoInst.CountMempoolVideoEdit(*ptx->GetAddress(), *ptx->GetRootTxHash()) > 0)
+            if (SocialMempool().CountByAddressTo(*ptx->GetAddress(), *ptx->GetRootTxHash(), {CONTENT_VIDEO, CONTENT_DELETE}) > 0)
                 return {false, SocialConsensusResult_DoubleContentEdit};
 
             // Check edit limit
@@ -201,7 +195,7 @@ namespace PocketConsensus
         virtual ConsensusValidateResult ValidateEditOneLimit(const VideoRef& ptx)
         {
 
-            int count = ConsensusRepoInst.CountChainVideoEdit(*ptx->GetAddress(), *ptx->GetRootTxHash());
+            int count = ConsensusRepo().CountChainVideoEdit(*ptx->GetAddress(), *ptx->GetRootTxHash());
             if (count >= GetConsensusLimit(ConsensusLimit_video_edit_count))
                 return {false, SocialConsensusResult_ContentEditLimit};
 
@@ -209,7 +203,7 @@ namespace PocketConsensus
         }
         virtual bool AllowEditWindow(const VideoRef& ptx, const VideoRef& originalTx)
         {
-            auto[ok, originalTxHeight] = ConsensusRepoInst.GetTransactionHeight(*originalTx->GetHash());
+            auto[ok, originalTxHeight] = ConsensusRepo().GetTransactionHeight(*originalTx->GetHash());
             if (!ok)
                 return false;
 
@@ -254,23 +248,12 @@ namespace PocketConsensus
     /*******************************************************************************************************************
     *  Factory for select actual rules version
     *******************************************************************************************************************/
-    class VideoConsensusFactory
+    class VideoConsensusFactory : public BaseConsensusFactory<VideoConsensus>
     {
-    private:
-        const vector<ConsensusCheckpoint < VideoConsensus>> m_rules = {
-            { 0, -1, [](int height) { return make_shared<VideoConsensus>(height); }},
-        };
     public:
-        shared_ptr<VideoConsensus> Instance(int height)
-        {
-            int m_height = (height > 0 ? height : 0);
-            return (--upper_bound(m_rules.begin(), m_rules.end(), m_height,
-                [&](int target, const ConsensusCheckpoint<VideoConsensus>& itm)
-                {
-                    return target < itm.Height(Params().NetworkIDString());
-                }
-            ))->m_func(height);
-        }
+        VideoConsensusFactory() : BaseConsensusFactory<VideoConsensus>({
+            { 0, -1, [](int height) { return make_shared<VideoConsensus>(height); }},
+        }) {}
     };
 }
 
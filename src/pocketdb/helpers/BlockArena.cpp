@@ -0,0 +1,105 @@
+// Copyright (c) 2018-2022 The Pocketnet developers
+// Distributed under the Apache 2.0 software license, see the accompanying
+// https://www.apache.org/licenses/LICENSE-2.0
+
+#include "pocketdb/helpers/BlockArena.h"
+
+#include <atomic>
+
+#ifndef WIN32
+#include <sys/resource.h>
+#endif
+
+namespace PocketHelpers
+{
+    static atomic<uint64_t> totalArenas{0};
+    static atomic<uint64_t> totalAllocations{0};
+    static atomic<uint64_t> totalBytes{0};
+
+    BlockArena::~BlockArena()
+    {
+        totalArenas += 1;
+        totalAllocations += m_allocations;
+        totalBytes += m_bytes;
+    }
+
+    void* BlockArena::Allocate(size_t size, size_t align)
+    {
+        lock_guard<mutex> lock(m_mutex);
+
+        m_allocations += 1;
+
+        size_t padding = m_current ? (align - (reinterpret_cast<uintptr_t>(m_current) % align)) % align : 0;
+        if (!m_current || padding + size > m_left)
+        {
+            // Chunk memory is aligned for any type, large objects get own chunk
+            size_t chunkSize = max(size, CHUNK_SIZE);
+            m_chunks.emplace_back(new char[chunkSize]);
+            m_bytes += chunkSize;
+
+            if (chunkSize > CHUNK_SIZE)
+                return m_chunks.back().get();
+
+            m_current = m_chunks.back().get();
+            m_left = chunkSize;
+            padding = 0;
+        }
+
+        void* result = m_current + padding;
+        m_current += padding + size;
+        m_left -= padding + size;
+
+        return result;
+    }
+
+    BlockArenaStats GetBlockArenaStats()
+    {
+        BlockArenaStats stats;
+        stats.Arenas = totalArenas;
+        stats.Allocations = totalAllocations;
+        stats.Bytes = totalBytes;
+        return stats;
+    }
+
+    size_t GetPeakRss()
+    {
+#ifndef WIN32
+        struct rusage usage{};
+        if (getrusage(RUSAGE_SELF, &usage) != 0)
+            return 0;
+
+#ifdef __APPLE__
+        return (size_t) usage.ru_maxrss;
+#else
+        return (size_t) usage.ru_maxrss * 1024;
+#endif
+#else
+        return 0;
+#endif
+    }
+
+    // ---------------------------------------
+
+    static bool arenaEnabled = DEFAULT_BLOCK_ARENA;
+    static thread_local BlockArenaScope* currentArenaScope = nullptr;
+
+    BlockArenaScope::BlockArenaScope() : m_arena(arenaEnabled ? make_shared<BlockArena>() : nullptr), m_previous(currentArenaScope)
+    {
+        currentArenaScope = this;
+    }
+
+    BlockArenaScope::~BlockArenaScope()
+    {
+        currentArenaScope = m_previous;
+    }
+
+    BlockArenaRef BlockArenaScope::Current()
+    {
+        return currentArenaScope ? currentArenaScope->m_arena : nullptr;
+    }
+
+    void BlockArenaScope::SetEnabled(bool enabled)
+    {
+        arenaEnabled = enabled;
+    }
+}
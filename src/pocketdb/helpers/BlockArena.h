@@ -0,0 +1,140 @@
+// Copyright (c) 2018-2022 The Pocketnet developers
+// Distributed under the Apache 2.0 software license, see the accompanying
+// https://www.apache.org/licenses/LICENSE-2.0
+
+#ifndef POCKETHELPERS_BLOCKARENA_H
+#define POCKETHELPERS_BLOCKARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace PocketHelpers
+{
+    using namespace std;
+
+    static const bool DEFAULT_BLOCK_ARENA = false;
+
+    // Monotonic memory of one block. Pocket models of the block with their control blocks,
+    // scores and indexes of social consensus are placed one after another in large chunks.
+    // Freed objects do not return memory - the arena is released in one step when the last
+    // allocator referring to it is destroyed, i.e. when the last transaction of the block is gone.
+    class BlockArena
+    {
+    public:
+        static constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+        BlockArena() = default;
+        ~BlockArena();
+
+        BlockArena(const BlockArena&) = delete;
+        BlockArena& operator=(const BlockArena&) = delete;
+
+        void* Allocate(size_t size, size_t align);
+
+        size_t Allocations() const { return m_allocations; }
+        size_t Bytes() const { return m_bytes; }
+
+    private:
+        mutex m_mutex;
+        vector<unique_ptr<char[]>> m_chunks;
+        char* m_current = nullptr;
+        size_t m_left = 0;
+        size_t m_allocations = 0;
+        size_t m_bytes = 0;
+    };
+
+    typedef shared_ptr<BlockArena> BlockArenaRef;
+
+    // Totals of all arenas since start - reported with -debug=bench and after reindex
+    struct BlockArenaStats
+    {
+        uint64_t Arenas = 0;
+        uint64_t Allocations = 0;
+        uint64_t Bytes = 0;
+    };
+
+    BlockArenaStats GetBlockArenaStats();
+
+    // Peak resident set size of the process in bytes, 0 if not supported by platform
+    size_t GetPeakRss();
+
+    // Makes new arena current for calling thread while scope is alive.
+    // Outside of any scope, or with arenas disabled (-blockarena), models and indexes
+    // are allocated on heap as usual.
+    class BlockArenaScope
+    {
+    public:
+        BlockArenaScope();
+        ~BlockArenaScope();
+
+        BlockArenaScope(const BlockArenaScope&) = delete;
+        BlockArenaScope& operator=(const BlockArenaScope&) = delete;
+
+        // Null if arenas are disabled
+        const BlockArenaRef& Arena() const { return m_arena; }
+
+        static BlockArenaRef Current();
+
+        // Set once on startup before any scope is created
+        static void SetEnabled(bool enabled);
+
+    private:
+        BlockArenaRef m_arena;
+        BlockArenaScope* m_previous;
+    };
+
+    // Allocator of standard containers and allocate_shared - takes current arena when constructed
+    template<class T>
+    class BlockArenaAllocator
+    {
+    public:
+        using value_type = T;
+
+        BlockArenaAllocator() : m_arena(BlockArenaScope::Current()) {}
+        explicit BlockArenaAllocator(BlockArenaRef arena) : m_arena(move(arena)) {}
+
+        template<class U>
+        BlockArenaAllocator(const BlockArenaAllocator<U>& other) : m_arena(other.Arena()) {}
+
+        T* allocate(size_t n)
+        {
+            if (!m_arena)
+                return static_cast<T*>(::operator new(n * sizeof(T)));
+
+            return static_cast<T*>(m_arena->Allocate(n * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T* p, size_t)
+        {
+            if (!m_arena)
+                ::operator delete(p);
+        }
+
+        const BlockArenaRef& Arena() const { return m_arena; }
+
+        template<class U>
+        bool operator==(const BlockArenaAllocator<U>& other) const { return m_arena == other.Arena(); }
+
+        template<class U>
+        bool operator!=(const BlockArenaAllocator<U>& other) const { return m_arena != other.Arena(); }
+
+    private:
+        BlockArenaRef m_arena;
+    };
+
+    // make_shared placing object in current arena if any
+    template<class T, class... Args>
+    shared_ptr<T> MakeBlockShared(Args&&... args)
+    {
+        if (auto arena = BlockArenaScope::Current())
+            return allocate_shared<T>(BlockArenaAllocator<T>(move(arena)), forward<Args>(args)...);
+
+        return make_shared<T>(forward<Args>(args)...);
+    }
+}
+
+#endif // POCKETHELPERS_BLOCKARENA_H
@@ -0,0 +1,128 @@
+// Copyright (c) 2018-2022 The Pocketnet developers
+// Distributed under the Apache 2.0 software license, see the accompanying
+// https://www.apache.org/licenses/LICENSE-2.0
+
+#include "pocketdb/helpers/FeedRanking.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace PocketHelpers
+{
+    DecayTable::DecayTable(double base, int size) : m_base(base)
+    {
+        m_powers.reserve(max(0, size));
+        for (int i = 0; i < size; i++)
+            m_powers.push_back(pow(base, i));
+    }
+
+    double DecayTable::operator()(int distance) const
+    {
+        if (distance >= 0 && distance < (int) m_powers.size())
+            return m_powers[distance];
+
+        return pow(m_base, distance);
+    }
+
+    // Number of values strictly lower than value
+    static double CountLower(const vector<double>& sorted, double value)
+    {
+        return (double) (lower_bound(sorted.begin(), sorted.end(), value) - sorted.begin());
+    }
+
+    void RankHierarchicalRecords(vector<HierarchicalRecord>& records)
+    {
+        int nElements = records.size();
+
+        vector<double> last5, urep, prep;
+        if (nElements > 1)
+        {
+            last5.reserve(nElements);
+            urep.reserve(nElements);
+            prep.reserve(nElements);
+
+            for (const auto& record : records)
+            {
+                last5.push_back(record.LAST5);
+                urep.push_back(record.UREP);
+                prep.push_back(record.PREP);
+            }
+
+            sort(last5.begin(), last5.end());
+            sort(urep.begin(), urep.end());
+            sort(prep.begin(), prep.end());
+        }
+
+        for (auto& record : records)
+        {
+            double boost = 0;
+            if (nElements > 1)
+            {
+                record.LAST5R = 1.0 * (CountLower(last5, record.LAST5) * 100) / (nElements - 1);
+                record.UREPR = min(record.UREP, 1.0 * (CountLower(urep, record.UREP) * 100) / (nElements - 1)) * (record.UREP < 0 ? 2.0 : 1.0);
+                record.PREPR = min(record.PREP, 1.0 * (CountLower(prep, record.PREP) * 100) / (nElements - 1)) * (record.PREP < 0 ? 2.0 : 1.0);
+            }
+            else
+            {
+                record.LAST5R = 100;
+                record.UREPR = 100;
+                record.PREPR = 100;
+            }
+
+            record.POSTRF = 0.4 * (0.75 * (record.LAST5R + boost) + 0.25 * record.UREPR) * record.DREP + 0.6 * record.PREPR * record.DPOST;
+        }
+    }
+
+    vector<HierarchicalRecord> FilterHierarchicalCandidates(const vector<HierarchicalCandidate>& candidates,
+        const HierarchicalFilter& filter)
+    {
+        vector<HierarchicalRecord> records;
+        records.reserve(candidates.size());
+
+        for (const auto& candidate : candidates)
+        {
+            if (filter.FilterTags && filter.TaggedIds.count(candidate.Record.Id) == 0)
+                continue;
+
+            if (filter.ExcludedTaggedIds.count(candidate.Record.Id) > 0)
+                continue;
+
+            if (filter.TxIdsExcluded.count(candidate.RootTxHash) > 0)
+                continue;
+
+            if (filter.AddressesExcluded.count(candidate.Address) > 0)
+                continue;
+
+            records.push_back(candidate.Record);
+        }
+
+        return records;
+    }
+
+    vector<int64_t> PageHierarchicalRecords(const vector<HierarchicalRecord>& records, int countOut,
+        int64_t topContentId, int64_t& minContentId)
+    {
+        bool found = false;
+        minContentId = topContentId;
+
+        vector<int64_t> ids;
+        for (auto iter = records.begin(); iter < records.end() && (int) ids.size() < countOut; iter++)
+        {
+            if (iter->Id < minContentId || minContentId == 0)
+                minContentId = iter->Id;
+
+            // Find start position
+            if (!found && topContentId > 0)
+            {
+                if (iter->Id == topContentId)
+                    found = true;
+
+                continue;
+            }
+
+            ids.push_back(iter->Id);
+        }
+
+        return ids;
+    }
+}
@@ -0,0 +1,90 @@
+// Copyright (c) 2018-2022 The Pocketnet developers
+// Distributed under the Apache 2.0 software license, see the accompanying
+// https://www.apache.org/licenses/LICENSE-2.0
+
+#ifndef POCKETHELPERS_FEEDRANKING_H
+#define POCKETHELPERS_FEEDRANKING_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace PocketHelpers
+{
+    using namespace std;
+
+    struct HierarchicalRecord
+    {
+        int64_t Id;
+        double LAST5;
+        double LAST5R;
+        double BOOST;
+        double UREP;
+        double UREPR;
+        double DREP;
+        double PREP;
+        double PREPR;
+        double DPOST;
+        double POSTRF;
+
+        bool operator > (const HierarchicalRecord& b) const
+        {
+            return (POSTRF > b.POSTRF);
+        }
+
+        bool operator < (const HierarchicalRecord& b) const
+        {
+            return (POSTRF < b.POSTRF);
+        }
+    };
+
+    // Record of hierarchical feed before ranking, with attributes checked by request filters
+    struct HierarchicalCandidate
+    {
+        HierarchicalRecord Record;
+        string RootTxHash;
+        string Address;
+    };
+
+    // Request filters of hierarchical feed resolved for set of candidates. Tags are resolved
+    // to ids of tagged contents, because tags of content can be processed after it was selected.
+    struct HierarchicalFilter
+    {
+        bool FilterTags = false;
+        unordered_set<int64_t> TaggedIds;
+        unordered_set<int64_t> ExcludedTaggedIds;
+        unordered_set<string> TxIdsExcluded;
+        unordered_set<string> AddressesExcluded;
+    };
+
+    // Powers of decay factor by distance in blocks. Values are computed with pow() itself,
+    // so they are bit-identical to calling pow() per record; distances out of table fall back to it.
+    class DecayTable
+    {
+    public:
+        DecayTable(double base, int size);
+
+        double operator()(int distance) const;
+
+    private:
+        double m_base;
+        vector<double> m_powers;
+    };
+
+    // Fill LAST5R, UREPR, PREPR and POSTRF of every record. Percentile of a value is the share of records
+    // with a strictly lower value - found by binary search in sorted values instead of comparing all pairs,
+    // O(n log n) with exactly the same result.
+    void RankHierarchicalRecords(vector<HierarchicalRecord>& records);
+
+    // Records of candidates passed filter, in order of candidates
+    vector<HierarchicalRecord> FilterHierarchicalCandidates(const vector<HierarchicalCandidate>& candidates,
+        const HierarchicalFilter& filter);
+
+    // Page of records sorted by rank: up to countOut ids following topContentId (from start if 0).
+    // minContentId receives lowest id of records passed - historical feed continues below it.
+    vector<int64_t> PageHierarchicalRecords(const vector<HierarchicalRecord>& records, int countOut,
+        int64_t topContentId, int64_t& minContentId);
+}
+
+#endif // POCKETHELPERS_FEEDRANKING_H
@@ -196,7 +196,7 @@ namespace PocketHelpers
         return IsPocketSupportedTransaction(txRef);
     }
 
-    bool TransactionHelper::IsPocketTransaction(TxType& txType)
+    bool TransactionHelper::IsPocketTransaction(TxType txType)
     {
         return txType != NOT_SUPPORTED &&
                txType != TX_COINBASE &&
@@ -224,7 +224,7 @@ namespace PocketHelpers
 
     tuple<bool, shared_ptr<ScoreDataDto>> TransactionHelper::ParseScore(const CTransactionRef& tx)
     {
-        shared_ptr<ScoreDataDto> scoreData = make_shared<ScoreDataDto>();
+        shared_ptr<ScoreDataDto> scoreData = MakeBlockShared<ScoreDataDto>();
 
         vector<string> vasm;
         scoreData->ScoreType = ParseType(tx, vasm);
@@ -263,67 +263,67 @@ namespace PocketHelpers
         switch (txType)
         {
             case TX_COINBASE:
-                ptx = make_shared<Coinbase>(tx);
+                ptx = MakeBlockShared<Coinbase>(tx);
                 break;
             case TX_COINSTAKE:
-                ptx = make_shared<Coinstake>(tx);
+                ptx = MakeBlockShared<Coinstake>(tx);
                 break;
             case TX_DEFAULT:
-                ptx = make_shared<Default>(tx);
+                ptx = MakeBlockShared<Default>(tx);
                 break;
             case ACCOUNT_SETTING:
-                ptx = make_shared<AccountSetting>(tx);
+                ptx = MakeBlockShared<AccountSetting>(tx);
                 break;
             case ACCOUNT_USER:
-                ptx = make_shared<User>(tx);
+                ptx = MakeBlockShared<User>(tx);
                 break;
             case CONTENT_POST:
-                ptx = make_shared<Post>(tx);
+                ptx = MakeBlockShared<Post>(tx);
                 break;
             case CONTENT_VIDEO:
-                ptx = make_shared<Video>(tx);
+                ptx = MakeBlockShared<Video>(tx);
                 break;
             case CONTENT_ARTICLE:
-                ptx = make_shared<Article>(tx);
+                ptx = MakeBlockShared<Article>(tx);
                 break;
             case CONTENT_DELETE:
-                ptx = make_shared<ContentDelete>(tx);
+                ptx = MakeBlockShared<ContentDelete>(tx);
                 break;
             case BOOST_CONTENT:
-                ptx = make_shared<BoostContent>(tx);
+                ptx = MakeBlockShared<BoostContent>(tx);
                 break;
             case CONTENT_COMMENT:
-                ptx = make_shared<Comment>(tx);
+                ptx = MakeBlockShared<Comment>(tx);
                 break;
             case CONTENT_COMMENT_EDIT:
-                ptx = make_shared<CommentEdit>(tx);
+                ptx = MakeBlockShared<CommentEdit>(tx);
                 break;
             case CONTENT_COMMENT_DELETE:
-                ptx = make_shared<CommentDelete>(tx);
+                ptx = MakeBlockShared<CommentDelete>(tx);
                 break;
             case ACTION_SCORE_CONTENT:
-                ptx = make_shared<ScoreContent>(tx);
+                ptx = MakeBlockShared<ScoreContent>(tx);
                 break;
             case ACTION_SCORE_COMMENT:
-                ptx = make_shared<ScoreComment>(tx);
+                ptx = MakeBlockShared<ScoreComment>(tx);
                 break;
             case ACTION_SUBSCRIBE:
-                ptx = make_shared<Subscribe>(tx);
+                ptx = MakeBlockShared<Subscribe>(tx);
                 break;
             case ACTION_SUBSCRIBE_PRIVATE:
-                ptx = make_shared<SubscribePrivate>(tx);
+                ptx = MakeBlockShared<SubscribePrivate>(tx);
                 break;
             case ACTION_SUBSCRIBE_CANCEL:
-                ptx = make_shared<SubscribeCancel>(tx);
+                ptx = MakeBlockShared<SubscribeCancel>(tx);
                 break;
             case ACTION_BLOCKING:
-                ptx = make_shared<Blocking>(tx);
+                ptx = MakeBlockShared<Blocking>(tx);
                 break;
             case ACTION_BLOCKING_CANCEL:
-                ptx = make_shared<BlockingCancel>(tx);
+                ptx = MakeBlockShared<BlockingCancel>(tx);
                 break;
             case ACTION_COMPLAIN:
-                ptx = make_shared<Complain>(tx);
+                ptx = MakeBlockShared<Complain>(tx);
                 break;
             default:
                 return nullptr;
@@ -338,67 +338,67 @@ namespace PocketHelpers
         switch (txType)
         {
             case TX_COINBASE:
-                ptx = make_shared<Coinbase>();
+                ptx = MakeBlockShared<Coinbase>();
                 break;
             case TX_COINSTAKE:
-                ptx = make_shared<Coinstake>();
+                ptx = MakeBlockShared<Coinstake>();
                 break;
             case TX_DEFAULT:
-                ptx = make_shared<Default>();
+                ptx = MakeBlockShared<Default>();
                 break;
             case ACCOUNT_SETTING:
-                ptx = make_shared<AccountSetting>();
+                ptx = MakeBlockShared<AccountSetting>();
                 break;
             case ACCOUNT_USER:
-                ptx = make_shared<User>();
+                ptx = MakeBlockShared<User>();
                 break;
             case CONTENT_POST:
-                ptx = make_shared<Post>();
+                ptx = MakeBlockShared<Post>();
                 break;
             case CONTENT_VIDEO:
-                ptx = make_shared<Video>();
+                ptx = MakeBlockShared<Video>();
                 break;
             case CONTENT_ARTICLE:
-                ptx = make_shared<Article>();
+                ptx = MakeBlockShared<Article>();
                 break;
             case CONTENT_DELETE:
-                ptx = make_shared<ContentDelete>();
+                ptx = MakeBlockShared<ContentDelete>();
                 break;
             case BOOST_CONTENT:
-                ptx = make_shared<BoostContent>();
+                ptx = MakeBlockShared<BoostContent>();
                 break;
             case CONTENT_COMMENT:
-                ptx = make_shared<Comment>();
+                ptx = MakeBlockShared<Comment>();
                 break;
             case CONTENT_COMMENT_EDIT:
-                ptx = make_shared<CommentEdit>();
+                ptx = MakeBlockShared<CommentEdit>();
                 break;
             case CONTENT_COMMENT_DELETE:
-                ptx = make_shared<CommentDelete>();
+                ptx = MakeBlockShared<CommentDelete>();
                 break;
             case ACTION_SCORE_CONTENT:
-                ptx = make_shared<ScoreContent>();
+                ptx = MakeBlockShared<ScoreContent>();
                 break;
             case ACTION_SCORE_COMMENT:
-                ptx = make_shared<ScoreComment>();
+                ptx = MakeBlockShared<ScoreComment>();
                 break;
             case ACTION_SUBSCRIBE:
-                ptx = make_shared<Subscribe>();
+                ptx = MakeBlockShared<Subscribe>();
                 break;
             case ACTION_SUBSCRIBE_PRIVATE:
-                ptx = make_shared<SubscribePrivate>();
+                ptx = MakeBlockShared<SubscribePrivate>();
                 break;
             case ACTION_SUBSCRIBE_CANCEL:
-                ptx = make_shared<SubscribeCancel>();
+                ptx = MakeBlockShared<SubscribeCancel>();
                 break;
             case ACTION_BLOCKING:
-                ptx = make_shared<Blocking>();
+                ptx = MakeBlockShared<Blocking>();
                 break;
             case ACTION_BLOCKING_CANCEL:
-                ptx = make_shared<BlockingCancel>();
+                ptx = MakeBlockShared<BlockingCancel>();
                 break;
             case ACTION_COMPLAIN:
-                ptx = make_shared<Complain>();
+                ptx = MakeBlockShared<Complain>();
                 break;
             default:
                 return nullptr;
@@ -13,6 +13,7 @@
 #include "primitives/transaction.h"
 #include "utilstrencodings.h"
 
+#include "pocketdb/helpers/BlockArena.h"
 #include "pocketdb/models/base/ReturnDtoModels.h"
 #include "pocketdb/models/base/PocketTypes.h"
 
@@ -67,7 +68,7 @@ namespace PocketHelpers
         static bool IsPocketSupportedTransaction(const CTransactionRef& tx, TxType& txType);
         static bool IsPocketSupportedTransaction(const CTransactionRef& tx);
         static bool IsPocketSupportedTransaction(const CTransaction& tx);
-        static bool IsPocketTransaction(TxType& txType);
+        static bool IsPocketTransaction(TxType txType);
         static bool IsPocketTransaction(const CTransactionRef& tx, TxType& txType);
         static bool IsPocketTransaction(const CTransactionRef& tx);
         static bool IsPocketTransaction(const CTransaction& tx);
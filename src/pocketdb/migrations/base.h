@@ -20,6 +20,7 @@ namespace PocketDb
         vector<string> _views;
         string _preProcessing;
         string _indexes;
+        string _deferredIndexes;
         string _postProcessing;
 
     public:
@@ -30,6 +31,8 @@ namespace PocketDb
         vector<string>& Views() { return _views; }
         string& PreProcessing() { return _preProcessing; }
         string& Indexes() { return _indexes; }
+        // Indexes not read while blocks are indexed - built after bulk load of full reindex
+        string& DeferredIndexes() { return _deferredIndexes; }
         string& PostProcessing() { return _postProcessing; }
     };
 
@@ -162,6 +162,30 @@ namespace PocketDb
             );
         )sql");
 
+        _tables.emplace_back(R"sql(
+            create table if not exists AccountStats
+            (
+                Address     text not null primary key,
+                Posts       int  not null,
+                Subscribes  int  not null,
+                Subscribers int  not null,
+                Blockings   int  not null,
+                Likers      int  not null,
+                Referrals   int  not null
+            );
+        )sql");
+
+        _tables.emplace_back(R"sql(
+            create table if not exists ContentStats
+            (
+                ContentId   int not null primary key,
+                ScoresCount int not null,
+                ScoresSum   int not null,
+                Reposted    int not null,
+                Comments    int not null
+            );
+        )sql");
+
         _tables.emplace_back(R"sql(
             create table if not exists Balances
             (
@@ -204,28 +228,21 @@ namespace PocketDb
             create index if not exists Transactions_Id on Transactions (Id);
             create index if not exists Transactions_Id_Last on Transactions (Id, Last);
             create index if not exists Transactions_Hash_Height on Transactions (Hash, Height);
-            create index if not exists Transactions_Height_Type on Transactions (Height, Type);
             create index if not exists Transactions_Type_Last_String1_Height_Id on Transactions (Type, Last, String1, Height, Id);
             create index if not exists Transactions_Type_Last_String2_Height on Transactions (Type, Last, String2, Height);
             create index if not exists Transactions_Type_Last_String3_Height on Transactions (Type, Last, String3, Height);
-            create index if not exists Transactions_Type_Last_String4_Height on Transactions (Type, Last, String4, Height);
             create index if not exists Transactions_Type_Last_String1_String2_Height on Transactions (Type, Last, String1, String2, Height);
-            create index if not exists Transactions_Type_Last_Height_String5_String1 on Transactions (Type, Last, Height, String5, String1);
             create index if not exists Transactions_Type_Last_Height_Id on Transactions (Type, Last, Height, Id);
             create index if not exists Transactions_Type_String1_String2_Height on Transactions (Type, String1, String2, Height);
             create index if not exists Transactions_Type_String1_Height_Time_Int1 on Transactions (Type, String1, Height, Time, Int1);
-            create index if not exists Transactions_String1_Last_Height on Transactions (String1, Last, Height);
             create index if not exists Transactions_Last_Id_Height on Transactions (Last, Id, Height);
             create index if not exists Transactions_BlockHash on Transactions (BlockHash);
             create index if not exists Transactions_Height_Id on Transactions (Height, Id);
-            create index if not exists Transactions_Type_HeightByDay on Transactions (Type, (Height / 1440));
-            create index if not exists Transactions_Type_HeightByHour on Transactions (Type, (Height / 60));
 
             create index if not exists TxOutputs_SpentHeight_AddressHash on TxOutputs (SpentHeight, AddressHash);
             create index if not exists TxOutputs_TxHeight_AddressHash on TxOutputs (TxHeight, AddressHash);
             create index if not exists TxOutputs_SpentTxHash on TxOutputs (SpentTxHash);
             create index if not exists TxOutputs_TxHash_AddressHash_Value on TxOutputs (TxHash, AddressHash, Value);
-            create index if not exists TxOutputs_AddressHash_TxHeight_SpentHeight on TxOutputs (AddressHash, TxHeight, SpentHeight);
 
             create unique index if not exists TxInputs_SpentTxHash_TxHash_Number on TxInputs (SpentTxHash, TxHash, Number);
 
@@ -233,20 +250,39 @@ namespace PocketDb
             create index if not exists Ratings_Height_Last on Ratings (Height, Last);
             create index if not exists Ratings_Type_Id_Value on Ratings (Type, Id, Value);
             create index if not exists Ratings_Type_Id_Last_Height on Ratings (Type, Id, Last, Height);
-            create index if not exists Ratings_Type_Id_Last_Value on Ratings (Type, Id, Last, Value);
             create index if not exists Ratings_Type_Id_Height_Value on Ratings (Type, Id, Height, Value);
 
             create index if not exists Payload_String2_nocase_TxHash on Payload (String2 collate nocase, TxHash);
-            create index if not exists Payload_String7 on Payload (String7);
-            create index if not exists Payload_String1_TxHash on Payload (String1, TxHash);
 
             create index if not exists Balances_Height on Balances (Height);
             create index if not exists Balances_AddressHash_Last_Height on Balances (AddressHash, Last, Height);
-            create index if not exists Balances_Last_Value on Balances (Last, Value);
             create index if not exists Balances_AddressHash_Last on Balances (AddressHash, Last);
 
         )sql";
 
+
+        // Indexes of RPC, feeds and explorer only - every index named with `indexed by`
+        // in chain, consensus, ratings or notifier queries must stay in _indexes
+        _deferredIndexes = R"sql(
+
+            create index if not exists Transactions_Height_Type on Transactions (Height, Type);
+            create index if not exists Transactions_Type_Last_String4_Height on Transactions (Type, Last, String4, Height);
+            create index if not exists Transactions_Type_Last_Height_String5_String1 on Transactions (Type, Last, Height, String5, String1);
+            create index if not exists Transactions_String1_Last_Height on Transactions (String1, Last, Height);
+            create index if not exists Transactions_Type_HeightByDay on Transactions (Type, (Height / 1440));
+            create index if not exists Transactions_Type_HeightByHour on Transactions (Type, (Height / 60));
+
+            create index if not exists TxOutputs_AddressHash_TxHeight_SpentHeight on TxOutputs (AddressHash, TxHeight, SpentHeight);
+
+            create index if not exists Ratings_Type_Id_Last_Value on Ratings (Type, Id, Last, Value);
+
+            create index if not exists Payload_String7 on Payload (String7);
+            create index if not exists Payload_String1_TxHash on Payload (String1, TxHash);
+
+            create index if not exists Balances_Last_Value on Balances (Last, Value);
+
+        )sql";
+
         _postProcessing = R"sql(
 
         )sql";
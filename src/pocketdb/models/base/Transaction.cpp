@@ -7,6 +7,7 @@
 
 namespace PocketTx
 {
+    const optional<string> Transaction::m_none;
 
     Transaction::Transaction() : Base()
     {
@@ -39,52 +40,55 @@ namespace PocketTx
         GeneratePayload();
     }
 
-    shared_ptr <string> Transaction::GetHash() const { return m_hash; }
-    void Transaction::SetHash(string value) { m_hash = make_shared<string>(value); }
+    const optional<string>& Transaction::GetHash() const { return m_hash; }
+    void Transaction::SetHash(string value) { m_hash = move(value); }
     bool Transaction::operator==(const string& hash) const { return *m_hash == hash; }
 
-    shared_ptr <TxType> Transaction::GetType() const { return m_type; }
-    void Transaction::SetType(TxType value) { m_type = make_shared<TxType>(value); }
+    const optional<TxType>& Transaction::GetType() const { return m_type; }
+    void Transaction::SetType(TxType value) { m_type = value; }
 
-    shared_ptr <int64_t> Transaction::GetTime() const { return m_time; }
-    void Transaction::SetTime(int64_t value) { m_time = make_shared<int64_t>(value); }
+    const optional<int64_t>& Transaction::GetTime() const { return m_time; }
+    void Transaction::SetTime(int64_t value) { m_time = value; }
 
-    shared_ptr<int64_t> Transaction::GetHeight() const { return m_height; }
-    void Transaction::SetHeight(int64_t value) { m_height = make_shared<int64_t>(value); }
+    const optional<int64_t>& Transaction::GetHeight() const { return m_height; }
+    void Transaction::SetHeight(int64_t value) { m_height = value; }
 
-    shared_ptr<string> Transaction::GetBlockHash() const { return m_blockhash; }
-    void Transaction::SetBlockHash(string value) { m_blockhash = make_shared<string>(value); }
+    const optional<string>& Transaction::GetBlockHash() const { return m_blockhash; }
+    void Transaction::SetBlockHash(string value) { m_blockhash = move(value); }
 
-    shared_ptr<bool> Transaction::GetLast() const { return m_last; }
-    void Transaction::SetLast(bool value) { m_last = make_shared<bool>(value); }
+    const optional<bool>& Transaction::GetLast() const { return m_last; }
+    void Transaction::SetLast(bool value) { m_last = value; }
 
-    shared_ptr <string> Transaction::GetString1() const { return m_string1; }
-    void Transaction::SetString1(string value) { m_string1 = make_shared<string>(value); }
+    const optional<string>& Transaction::GetString1() const { return m_string1; }
+    void Transaction::SetString1(string value) { m_string1 = move(value); }
 
-    shared_ptr <string> Transaction::GetString2() const { return m_string2; }
-    void Transaction::SetString2(string value) { m_string2 = make_shared<string>(value); }
+    const optional<string>& Transaction::GetString2() const { return m_string2; }
+    void Transaction::SetString2(string value) { m_string2 = move(value); }
 
-    shared_ptr <string> Transaction::GetString3() const { return m_string3; }
-    void Transaction::SetString3(string value) { m_string3 = make_shared<string>(value); }
+    const optional<string>& Transaction::GetString3() const { return m_string3; }
+    void Transaction::SetString3(string value) { m_string3 = move(value); }
 
-    shared_ptr <string> Transaction::GetString4() const { return m_string4; }
-    void Transaction::SetString4(string value) { m_string4 = make_shared<string>(value); }
+    const optional<string>& Transaction::GetString4() const { return m_string4; }
+    void Transaction::SetString4(string value) { m_string4 = move(value); }
 
-    shared_ptr <string> Transaction::GetString5() const { return m_string5; }
-    void Transaction::SetString5(string value) { m_string5 = make_shared<string>(value); }
+    const optional<string>& Transaction::GetString5() const { return m_string5; }
+    void Transaction::SetString5(string value) { m_string5 = move(value); }
 
-    shared_ptr <int64_t> Transaction::GetInt1() const { return m_int1; }
-    void Transaction::SetInt1(int64_t value) { m_int1 = make_shared<int64_t>(value); }
+    const optional<int64_t>& Transaction::GetInt1() const { return m_int1; }
+    void Transaction::SetInt1(int64_t value) { m_int1 = value; }
 
-    shared_ptr <int64_t> Transaction::GetId() const { return m_id; }
-    void Transaction::SetId(int64_t value) { m_id = make_shared<int64_t>(value); }
+    const optional<int64_t>& Transaction::GetId() const { return m_id; }
+    void Transaction::SetId(int64_t value) { m_id = value; }
 
-    vector <shared_ptr<TransactionInput>>& Transaction::Inputs() { return m_inputs; }
-    vector <shared_ptr<TransactionOutput>>& Transaction::Outputs() { return m_outputs; }
+    vector<TransactionInput>& Transaction::Inputs() { return m_inputs; }
+    const vector<TransactionInput>& Transaction::Inputs() const { return m_inputs; }
+    vector<TransactionOutput>& Transaction::Outputs() { return m_outputs; }
+    const vector<TransactionOutput>& Transaction::Outputs() const { return m_outputs; }
 
-    shared_ptr <Payload> Transaction::GetPayload() const { return m_payload; }
-    void Transaction::SetPayload(Payload value) { m_payload = make_shared<Payload>(value); }
-    bool Transaction::HasPayload() const { return m_payload != nullptr; };
+    Payload* Transaction::GetPayload() { return m_payload ? &*m_payload : nullptr; }
+    const Payload* Transaction::GetPayload() const { return m_payload ? &*m_payload : nullptr; }
+    void Transaction::SetPayload(Payload value) { m_payload = move(value); }
+    bool Transaction::HasPayload() const { return m_payload.has_value(); };
 
     string Transaction::GenerateHash(const string& data) const
     {
@@ -98,13 +102,13 @@ namespace PocketTx
 
     void Transaction::GeneratePayload()
     {
-        m_payload = make_shared<Payload>();
+        m_payload.emplace();
         m_payload->SetTxHash(*GetHash());
     }
 
     void Transaction::ClearPayload()
     {
-        m_payload = nullptr;
+        m_payload.reset();
     }
 
 } // namespace PocketTx
\ No newline at end of file
@@ -5,6 +5,7 @@
 #ifndef POCKETTX_TRANSACTION_H
 #define POCKETTX_TRANSACTION_H
 
+#include <optional>
 #include <string>
 #include <univalue/include/univalue.h>
 #include <utility>
@@ -19,6 +20,8 @@ namespace PocketTx
 {
     using namespace std;
 
+    // Fields, payload, inputs and outputs are stored by value in the object itself:
+    // building a transaction costs only allocations of its long strings and two arrays.
     class Transaction : public Base
     {
     public:
@@ -35,50 +38,53 @@ namespace PocketTx
         virtual string BuildHash() = 0;
         virtual void SetAddress(const string& value) {}
 
-        shared_ptr<string> GetHash() const;
+        const optional<string>& GetHash() const;
         void SetHash(string value);
         bool operator==(const string& hash) const;
 
-        shared_ptr<TxType> GetType() const;
+        const optional<TxType>& GetType() const;
         void SetType(TxType value);
 
-        shared_ptr<int64_t> GetTime() const;
+        const optional<int64_t>& GetTime() const;
         void SetTime(int64_t value);
 
-        shared_ptr<int64_t> GetHeight() const;
+        const optional<int64_t>& GetHeight() const;
         void SetHeight(int64_t value);
 
-        shared_ptr<string> GetBlockHash() const;
+        const optional<string>& GetBlockHash() const;
         void SetBlockHash(string value);
 
-        shared_ptr<bool> GetLast() const;
+        const optional<bool>& GetLast() const;
         void SetLast(bool value);
 
-        shared_ptr<int64_t> GetId() const;
+        const optional<int64_t>& GetId() const;
         void SetId(int64_t value);
 
-        shared_ptr<string> GetString1() const;
+        const optional<string>& GetString1() const;
         void SetString1(string value);
 
-        shared_ptr<string> GetString2() const;
+        const optional<string>& GetString2() const;
         void SetString2(string value);
 
-        shared_ptr<string> GetString3() const;
+        const optional<string>& GetString3() const;
         void SetString3(string value);
 
-        shared_ptr<string> GetString4() const;
+        const optional<string>& GetString4() const;
         void SetString4(string value);
 
-        shared_ptr<string> GetString5() const;
+        const optional<string>& GetString5() const;
         void SetString5(string value);
 
-        shared_ptr<int64_t> GetInt1() const;
+        const optional<int64_t>& GetInt1() const;
         void SetInt1(int64_t value);
 
-        vector<shared_ptr<TransactionInput>>& Inputs();
-        vector<shared_ptr<TransactionOutput>>& Outputs();
+        vector<TransactionInput>& Inputs();
+        const vector<TransactionInput>& Inputs() const;
+        vector<TransactionOutput>& Outputs();
+        const vector<TransactionOutput>& Outputs() const;
 
-        shared_ptr<Payload> GetPayload() const;
+        Payload* GetPayload();
+        const Payload* GetPayload() const;
         void SetPayload(Payload value);
         bool HasPayload() const;
         
@@ -86,22 +92,25 @@ namespace PocketTx
         void ClearPayload();
 
     protected:
-        shared_ptr<TxType> m_type = nullptr;
-        shared_ptr<string> m_hash = nullptr;
-        shared_ptr<int64_t> m_time = nullptr;
-        shared_ptr<int64_t> m_height = nullptr;
-        shared_ptr<string> m_blockhash = nullptr;
-        shared_ptr<bool> m_last = nullptr;
-        shared_ptr<int64_t> m_id = nullptr;
-        shared_ptr<string> m_string1 = nullptr;
-        shared_ptr<string> m_string2 = nullptr;
-        shared_ptr<string> m_string3 = nullptr;
-        shared_ptr<string> m_string4 = nullptr;
-        shared_ptr<string> m_string5 = nullptr;
-        shared_ptr<int64_t> m_int1 = nullptr;
-        shared_ptr<Payload> m_payload = nullptr;
-        vector<shared_ptr<TransactionInput>> m_inputs;
-        vector<shared_ptr<TransactionOutput>> m_outputs;
+        optional<TxType> m_type;
+        optional<string> m_hash;
+        optional<int64_t> m_time;
+        optional<int64_t> m_height;
+        optional<string> m_blockhash;
+        optional<bool> m_last;
+        optional<int64_t> m_id;
+        optional<string> m_string1;
+        optional<string> m_string2;
+        optional<string> m_string3;
+        optional<string> m_string4;
+        optional<string> m_string5;
+        optional<int64_t> m_int1;
+        optional<Payload> m_payload;
+        vector<TransactionInput> m_inputs;
+        vector<TransactionOutput> m_outputs;
+
+        // Field of absent payload, so payload getters of models can return a reference
+        static const optional<string> m_none;
 
         string GenerateHash(const string& data) const;
     };
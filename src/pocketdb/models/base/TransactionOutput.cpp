@@ -6,25 +6,25 @@
 
 namespace PocketTx
 {
-    shared_ptr <string> TransactionOutput::GetTxHash() const { return m_txHash; }
-    void TransactionOutput::SetTxHash(string value) { m_txHash = make_shared<string>(value); }
+    const optional<string>& TransactionOutput::GetTxHash() const { return m_txHash; }
+    void TransactionOutput::SetTxHash(string value) { m_txHash = move(value); }
 
-    shared_ptr <int64_t> TransactionOutput::GetNumber() const { return m_number; }
-    void TransactionOutput::SetNumber(int64_t value) { m_number = make_shared<int64_t>(value); }
+    const optional<int64_t>& TransactionOutput::GetNumber() const { return m_number; }
+    void TransactionOutput::SetNumber(int64_t value) { m_number = value; }
 
-    shared_ptr <string> TransactionOutput::GetAddressHash() const { return m_addressHash; }
-    void TransactionOutput::SetAddressHash(string value) { m_addressHash = make_shared<string>(value); }
+    const optional<string>& TransactionOutput::GetAddressHash() const { return m_addressHash; }
+    void TransactionOutput::SetAddressHash(string value) { m_addressHash = move(value); }
 
-    shared_ptr <int64_t> TransactionOutput::GetValue() const { return m_value; }
-    void TransactionOutput::SetValue(int64_t value) { m_value = make_shared<int64_t>(value); }
+    const optional<int64_t>& TransactionOutput::GetValue() const { return m_value; }
+    void TransactionOutput::SetValue(int64_t value) { m_value = value; }
     
-    shared_ptr <string> TransactionOutput::GetScriptPubKey() const { return m_scriptPubKey; }
-    void TransactionOutput::SetScriptPubKey(string value) { m_scriptPubKey = make_shared<string>(value); }
+    const optional<string>& TransactionOutput::GetScriptPubKey() const { return m_scriptPubKey; }
+    void TransactionOutput::SetScriptPubKey(string value) { m_scriptPubKey = move(value); }
         
-    shared_ptr<string> TransactionOutput::GetSpentTxHash() const { return m_spentTxHash; }
-    void TransactionOutput::SetSpentTxHash(string value) { m_spentTxHash = make_shared<string>(value); }
+    const optional<string>& TransactionOutput::GetSpentTxHash() const { return m_spentTxHash; }
+    void TransactionOutput::SetSpentTxHash(string value) { m_spentTxHash = move(value); }
 
-    shared_ptr<int64_t> TransactionOutput::GetSpentHeight() const { return m_spentHeight; }
-    void TransactionOutput::SetSpentHeight(int64_t value) { m_spentHeight = make_shared<int64_t>(value); }
+    const optional<int64_t>& TransactionOutput::GetSpentHeight() const { return m_spentHeight; }
+    void TransactionOutput::SetSpentHeight(int64_t value) { m_spentHeight = value; }
 
 } // namespace PocketTx
\ No newline at end of file
@@ -45,11 +45,11 @@ namespace PocketTx
     }
     
 
-    shared_ptr <string> BoostContent::GetAddress() const { return m_string1; }
-    void BoostContent::SetAddress(const string& value) { m_string1 = make_shared<string>(value); }
+    const optional<string>& BoostContent::GetAddress() const { return m_string1; }
+    void BoostContent::SetAddress(const string& value) { m_string1 = value; }
 
-    shared_ptr <string> BoostContent::GetContentTxHash() const { return m_string2; }
-    void BoostContent::SetContentTxHash(const string& value) { m_string2 = make_shared<string>(value); }
+    const optional<string>& BoostContent::GetContentTxHash() const { return m_string2; }
+    void BoostContent::SetContentTxHash(const string& value) { m_string2 = value; }
 
 
     string BoostContent::BuildHash()
@@ -22,10 +22,10 @@ namespace PocketTx
         void DeserializeRpc(const UniValue& src) override;
         void DeserializePayload(const UniValue& src) override;
 
-        shared_ptr <string> GetAddress() const;
+        const optional<string>& GetAddress() const;
         void SetAddress(const string& value) override;
 
-        shared_ptr<string> GetContentTxHash() const;
+        const optional<string>& GetContentTxHash() const;
         void SetContentTxHash(const string& value);
 
         string BuildHash() override;
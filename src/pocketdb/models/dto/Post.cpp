@@ -101,16 +101,16 @@ namespace PocketTx
         if (auto[ok, val] = TryGetStr(src, "settings"); ok) m_payload->SetString6(val);
     }
     
-    shared_ptr<string> Post::GetRelayTxHash() const { return m_string3; }
-    void Post::SetRelayTxHash(const string& value) { m_string3 = make_shared<string>(value); }
-
-    shared_ptr<string> Post::GetPayloadLang() const { return GetPayload() ? GetPayload()->GetString1() : nullptr; }
-    shared_ptr<string> Post::GetPayloadCaption() const { return GetPayload() ? GetPayload()->GetString2() : nullptr; }
-    shared_ptr<string> Post::GetPayloadMessage() const { return GetPayload() ? GetPayload()->GetString3() : nullptr; }
-    shared_ptr<string> Post::GetPayloadTags() const { return GetPayload() ? GetPayload()->GetString4() : nullptr; }
-    shared_ptr<string> Post::GetPayloadUrl() const { return GetPayload() ? GetPayload()->GetString7() : nullptr; }
-    shared_ptr<string> Post::GetPayloadImages() const { return GetPayload() ? GetPayload()->GetString5() : nullptr; }
-    shared_ptr<string> Post::GetPayloadSettings() const { return GetPayload() ? GetPayload()->GetString6() : nullptr; }
+    const optional<string>& Post::GetRelayTxHash() const { return m_string3; }
+    void Post::SetRelayTxHash(const string& value) { m_string3 = value; }
+
+    const optional<string>& Post::GetPayloadLang() const { return GetPayload() ? GetPayload()->GetString1() : m_none; }
+    const optional<string>& Post::GetPayloadCaption() const { return GetPayload() ? GetPayload()->GetString2() : m_none; }
+    const optional<string>& Post::GetPayloadMessage() const { return GetPayload() ? GetPayload()->GetString3() : m_none; }
+    const optional<string>& Post::GetPayloadTags() const { return GetPayload() ? GetPayload()->GetString4() : m_none; }
+    const optional<string>& Post::GetPayloadUrl() const { return GetPayload() ? GetPayload()->GetString7() : m_none; }
+    const optional<string>& Post::GetPayloadImages() const { return GetPayload() ? GetPayload()->GetString5() : m_none; }
+    const optional<string>& Post::GetPayloadSettings() const { return GetPayload() ? GetPayload()->GetString6() : m_none; }
 
     string Post::BuildHash()
     {
@@ -22,16 +22,16 @@ namespace PocketTx
         void DeserializeRpc(const UniValue& src) override;
         void DeserializePayload(const UniValue& src) override;
 
-        shared_ptr<string> GetRelayTxHash() const;
+        const optional<string>& GetRelayTxHash() const;
         void SetRelayTxHash(const string& value);
 
-        shared_ptr<string> GetPayloadLang() const;
-        shared_ptr<string> GetPayloadCaption() const;
-        shared_ptr<string> GetPayloadMessage() const;
-        shared_ptr<string> GetPayloadTags() const;
-        shared_ptr<string> GetPayloadUrl() const;
-        shared_ptr<string> GetPayloadImages() const;
-        shared_ptr<string> GetPayloadSettings() const;
+        const optional<string>& GetPayloadLang() const;
+        const optional<string>& GetPayloadCaption() const;
+        const optional<string>& GetPayloadMessage() const;
+        const optional<string>& GetPayloadTags() const;
+        const optional<string>& GetPayloadUrl() const;
+        const optional<string>& GetPayloadImages() const;
+        const optional<string>& GetPayloadSettings() const;
 
         string BuildHash() override;
     };
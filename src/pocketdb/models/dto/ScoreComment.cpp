@@ -42,14 +42,14 @@ namespace PocketTx
         if (auto[ok, val] = TryGetInt64(src, "value"); ok) SetValue(val);
     }
 
-    shared_ptr <string> ScoreComment::GetAddress() const { return m_string1; }
-    void ScoreComment::SetAddress(const string& value) { m_string1 = make_shared<string>(value); }
+    const optional<string>& ScoreComment::GetAddress() const { return m_string1; }
+    void ScoreComment::SetAddress(const string& value) { m_string1 = value; }
 
-    shared_ptr <string> ScoreComment::GetCommentTxHash() const { return m_string2; }
-    void ScoreComment::SetCommentTxHash(const string& value) { m_string2 = make_shared<string>(value); }
+    const optional<string>& ScoreComment::GetCommentTxHash() const { return m_string2; }
+    void ScoreComment::SetCommentTxHash(const string& value) { m_string2 = value; }
 
-    shared_ptr <int64_t> ScoreComment::GetValue() const { return m_int1; }
-    void ScoreComment::SetValue(int64_t value) { m_int1 = make_shared<int64_t>(value); }
+    const optional<int64_t>& ScoreComment::GetValue() const { return m_int1; }
+    void ScoreComment::SetValue(int64_t value) { m_int1 = value; }
 
     void ScoreComment::DeserializePayload(const UniValue& src)
     {
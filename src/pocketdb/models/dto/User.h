@@ -21,20 +21,20 @@ namespace PocketTx
         void DeserializeRpc(const UniValue& src) override;
         void DeserializePayload(const UniValue& src) override;
 
-        shared_ptr <string> GetAddress() const;
+        const optional<string>& GetAddress() const;
         void SetAddress(const string& value) override;
 
-        shared_ptr <string> GetReferrerAddress() const;
+        const optional<string>& GetReferrerAddress() const;
         void SetReferrerAddress(const string& value);
 
         // Payload getters
-        shared_ptr <string> GetPayloadName() const;
-        shared_ptr <string> GetPayloadAvatar() const;
-        shared_ptr <string> GetPayloadUrl() const;
-        shared_ptr <string> GetPayloadLang() const;
-        shared_ptr <string> GetPayloadAbout() const;
-        shared_ptr <string> GetPayloadDonations() const;
-        shared_ptr <string> GetPayloadPubkey() const;
+        const optional<string>& GetPayloadName() const;
+        const optional<string>& GetPayloadAvatar() const;
+        const optional<string>& GetPayloadUrl() const;
+        const optional<string>& GetPayloadLang() const;
+        const optional<string>& GetPayloadAbout() const;
+        const optional<string>& GetPayloadDonations() const;
+        const optional<string>& GetPayloadPubkey() const;
 
         string BuildHash() override;
         string BuildHash(bool includeReferrer);
@@ -11,9 +11,23 @@ namespace PocketDb
     ChainRepository ChainRepoInst(SQLiteDbInst);
     RatingsRepository RatingsRepoInst(SQLiteDbInst);
     ConsensusRepository ConsensusRepoInst(SQLiteDbInst);
-    NotifierRepository NotifierRepoInst(SQLiteDbInst);
     ExplorerRepository ExplorerRepoInst(SQLiteDbInst);
 
+    SQLiteConnectionPool SQLiteConnectionPoolInst;
+    SQLiteConnectionPool SQLiteConsensusPoolInst;
+
+    static thread_local ConsensusRepository* threadConsensusRepo = nullptr;
+
+    ConsensusRepository& ConsensusRepo()
+    {
+        return threadConsensusRepo ? *threadConsensusRepo : ConsensusRepoInst;
+    }
+
+    void SetThreadConsensusRepo(ConsensusRepository* repository)
+    {
+        threadConsensusRepo = repository;
+    }
+
     SQLiteDatabase SQLiteDbCheckpointInst(true);
     CheckpointRepository CheckpointRepoInst(SQLiteDbCheckpointInst);
 } // PocketDb
@@ -26,4 +40,7 @@ namespace PocketWeb
 namespace PocketServices
 {
     WebPostProcessor WebPostProcessorInst;
+    BlockPayloadCache BlockPayloadCacheInst;
+    WalCheckpointer WalCheckpointerInst;
+    FeedMaterializer FeedMaterializerInst;
 } // namespace PocketServices
\ No newline at end of file
@@ -13,6 +13,7 @@
 
 #include "logging.h"
 
+#include "pocketdb/SQLiteConnectionPool.h"
 #include "pocketdb/repositories/ChainRepository.h"
 #include "pocketdb/repositories/RatingsRepository.h"
 #include "pocketdb/repositories/TransactionRepository.h"
@@ -20,9 +21,11 @@
 #include "pocketdb/repositories/CheckpointRepository.h"
 #include "pocketdb/repositories/web/WebRpcRepository.h"
 #include "pocketdb/repositories/web/ExplorerRepository.h"
-#include "pocketdb/repositories/web/NotifierRepository.h"
 #include "pocketdb/web/PocketFrontend.h"
 #include "pocketdb/services/WebPostProcessing.h"
+#include "pocketdb/services/BlockPayloadCache.h"
+#include "pocketdb/services/WalCheckpointer.h"
+#include "pocketdb/services/FeedMaterializer.h"
 
 namespace PocketDb
 {
@@ -31,9 +34,16 @@ namespace PocketDb
     extern ChainRepository ChainRepoInst;
     extern RatingsRepository RatingsRepoInst;
     extern ConsensusRepository ConsensusRepoInst;
-    extern NotifierRepository NotifierRepoInst;
     extern ExplorerRepository ExplorerRepoInst;
 
+    extern SQLiteConnectionPool SQLiteConnectionPoolInst;
+    extern SQLiteConnectionPool SQLiteConsensusPoolInst;
+
+    // Consensus reads of calling thread. Workers of parallel block validation read
+    // through own read-only connections, all other threads through main connection.
+    ConsensusRepository& ConsensusRepo();
+    void SetThreadConsensusRepo(ConsensusRepository* repository);
+
     extern SQLiteDatabase SQLiteDbCheckpointInst;
     extern CheckpointRepository CheckpointRepoInst;
 } // namespace PocketDb
@@ -41,6 +51,9 @@ namespace PocketDb
 namespace PocketServices
 {
     extern WebPostProcessor WebPostProcessorInst;
+    extern BlockPayloadCache BlockPayloadCacheInst;
+    extern WalCheckpointer WalCheckpointerInst;
+    extern FeedMaterializer FeedMaterializerInst;
 } // namespace PocketServices
 
 namespace PocketWeb
@@ -5,6 +5,7 @@
 #ifndef POCKETDB_BASEREPOSITORY_H
 #define POCKETDB_BASEREPOSITORY_H
 
+#include <optional>
 #include <utility>
 #include <util.h>
 #include "shutdown.h"
@@ -99,8 +100,8 @@ namespace PocketDb
             {
                 int64_t nTime1 = GetTimeMicros();
 
-                // We are running SQL logic with timeout only for read-only connections
-                if (m_database.IsReadOnly())
+                // We are running SQL logic with timeout only for read-only connections serving requests
+                if (m_database.IsQueryTimeout())
                     TryTransactionStepTimeoutSince(func, sql);
                 else
                     TryTransactionStepSince(func, sql);
@@ -129,7 +130,7 @@ namespace PocketDb
         {
             sqlite3_stmt* stmt;
 
-            int res = sqlite3_prepare_v2(m_database.m_db, sql.c_str(), (int) sql.size(), &stmt, nullptr);
+            int res = m_database.PrepareStatement(sql, &stmt);
             if (res != SQLITE_OK)
                 throw std::runtime_error(strprintf("SQLiteDatabase: Failed to setup SQL statements: %s\nSql: %s",
                     sqlite3_errstr(res), sql));
@@ -150,7 +151,7 @@ namespace PocketDb
 
         int FinalizeSqlStatement(sqlite3_stmt* stmt)
         {
-            return sqlite3_finalize(stmt);
+            return m_database.ReleaseStatement(stmt);
         }
 
         // --------------------------------
@@ -168,6 +169,14 @@ namespace PocketDb
             return true;
         }
 
+        bool TryBindStatementText(shared_ptr<sqlite3_stmt*>& stmt, int index, const optional<std::string>& value)
+        {
+            if (!value) return true;
+
+            TryBindStatementText(stmt, index, *value);
+            return true;
+        }
+
         void TryBindStatementText(shared_ptr<sqlite3_stmt*>& stmt, int index, const std::string& value)
         {
             int res = sqlite3_bind_text(*stmt, index, value.c_str(), (int) value.size(), SQLITE_STATIC);
@@ -184,6 +193,14 @@ namespace PocketDb
             return true;
         }
 
+        bool TryBindStatementInt(shared_ptr<sqlite3_stmt*>& stmt, int index, const optional<int>& value)
+        {
+            if (!value) return true;
+
+            TryBindStatementInt(stmt, index, *value);
+            return true;
+        }
+
         void TryBindStatementInt(shared_ptr<sqlite3_stmt*>& stmt, int index, int value)
         {
             int res = sqlite3_bind_int(*stmt, index, value);
@@ -200,6 +217,14 @@ namespace PocketDb
             return true;
         }
 
+        bool TryBindStatementInt64(shared_ptr<sqlite3_stmt*>& stmt, int index, const optional<int64_t>& value)
+        {
+            if (!value) return true;
+
+            TryBindStatementInt64(stmt, index, *value);
+            return true;
+        }
+
         void TryBindStatementInt64(shared_ptr<sqlite3_stmt*>& stmt, int index, int64_t value)
         {
             int res = sqlite3_bind_int64(*stmt, index, value);
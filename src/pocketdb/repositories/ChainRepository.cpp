@@ -7,6 +7,14 @@
 namespace PocketDb
 {
     void ChainRepository::IndexBlock(const string& blockHash, int height, vector<TransactionIndexingInfo>& txs)
+    {
+        if (gArgs.GetBoolArg("-sqlbatchindex", DEFAULT_SQL_BATCH_INDEX))
+            IndexBlockBatch(blockHash, height, txs);
+        else
+            IndexBlockSequential(blockHash, height, txs);
+    }
+
+    void ChainRepository::IndexBlockSequential(const string& blockHash, int height, vector<TransactionIndexingInfo>& txs)
     {
         TryTransactionStep(__func__, [&]()
         {
@@ -19,7 +27,6 @@ namespace PocketDb
                 UpdateTransactionHeight(blockHash, txInfo.BlockNumber, height, txInfo.Hash);
 
                 // The outputs are needed for the explorer
-                // TODO (brangr) (v0.20.19+): replace with update inputs spent with TxInputs table over loop
                 UpdateTransactionOutputs(txInfo, height);
 
                 // Account and Content must have unique ID
@@ -51,7 +58,7 @@ namespace PocketDb
 
             int64_t nTime3 = GetTimeMicros();
 
-            LogPrint(BCLog::BENCH, "    - IndexBlock: %.2fms + %.2fms = %.2fms\n",
+            LogPrint(BCLog::BENCH, "    - IndexBlock (sequential): %.2fms + %.2fms = %.2fms\n",
                 0.001 * double(nTime2 - nTime1),
                 0.001 * double(nTime3 - nTime2),
                 0.001 * double(nTime3 - nTime1)
@@ -59,6 +66,48 @@ namespace PocketDb
         });
     }
 
+    void ChainRepository::IndexBlockBatch(const string& blockHash, int height, vector<TransactionIndexingInfo>& txs)
+    {
+        TryTransactionStep(__func__, [&]()
+        {
+            int64_t nTime1 = GetTimeMicros();
+
+            // Copy block transactions and inputs to temporary tables
+            StageBlockTransactions(txs);
+
+            int64_t nTime2 = GetTimeMicros();
+
+            // All transactions must have a blockHash & height relation
+            // Also outputs and spent inputs needed for the explorer and balances
+            UpdateTransactionsHeight(blockHash, height);
+            UpdateTransactionsOutputs(height);
+
+            int64_t nTime3 = GetTimeMicros();
+
+            // Account, Content, Comment, Blocking and Subscribe must have unique ID
+            // and all edited transactions must have Last=(0/1) field
+            IndexIds();
+
+            // Calculate and save fee for future selects
+            IndexBoostContents();
+
+            int64_t nTime4 = GetTimeMicros();
+
+            // After set height and mark inputs as spent we need recalculcate balances
+            IndexBalances(height);
+
+            int64_t nTime5 = GetTimeMicros();
+
+            LogPrint(BCLog::BENCH, "    - IndexBlock (batch): %.2fms + %.2fms + %.2fms + %.2fms = %.2fms\n",
+                0.001 * double(nTime2 - nTime1),
+                0.001 * double(nTime3 - nTime2),
+                0.001 * double(nTime4 - nTime3),
+                0.001 * double(nTime5 - nTime4),
+                0.001 * double(nTime5 - nTime1)
+            );
+        });
+    }
+
     bool ChainRepository::ClearDatabase()
     {
         LogPrintf("Full reindexing database. This can take several days.\n");
@@ -69,7 +118,17 @@ namespace PocketDb
         LogPrintf("Rollback to first block..\n");
         RollbackHeight(0);
 
-        m_database.CreateStructure();
+        auto stmt = SetupSqlStatement(R"sql(
+            delete from AccountStats
+        )sql");
+        TryStepStatement(stmt);
+
+        auto stmtContents = SetupSqlStatement(R"sql(
+            delete from ContentStats
+        )sql");
+        TryStepStatement(stmtContents);
+
+        m_database.CreateStructure(IsSQLiteBulkLoad());
 
         return true;
     }
@@ -81,8 +140,15 @@ namespace PocketDb
             // Update transactions
             TryTransactionStep(__func__, [&]()
             {
+                // Accounts and contents must be collected while transactions still have height
+                QueueAccountStats(height);
+                QueueContentStats(height);
+
                 RestoreOldLast(height);
                 RollbackHeight(height);
+
+                RefreshAccountStats();
+                RefreshContentStats();
             });
 
             return true;
@@ -453,6 +519,304 @@ namespace PocketDb
     }
 
 
+    void ChainRepository::StageBlockTransactions(const vector<TransactionIndexingInfo>& txs)
+    {
+        // Kind of Id & Last indexing for transaction
+        // 1 - Account, 2 - Content, 3 - Comment, 4 - Blocking, 5 - Subscribe, 6 - Boost
+        UniValue txsJson(UniValue::VARR);
+        UniValue inputsJson(UniValue::VARR);
+        for (const auto& txInfo : txs)
+        {
+            int kind = 0;
+            if (txInfo.IsAccount()) kind = 1;
+            else if (txInfo.IsContent()) kind = 2;
+            else if (txInfo.IsComment()) kind = 3;
+            else if (txInfo.IsBlocking()) kind = 4;
+            else if (txInfo.IsSubscribe()) kind = 5;
+            else if (txInfo.IsBoostContent()) kind = 6;
+
+            UniValue txJson(UniValue::VARR);
+            txJson.push_back(txInfo.Hash);
+            txJson.push_back(txInfo.BlockNumber);
+            txJson.push_back(kind);
+            txsJson.push_back(txJson);
+
+            for (const auto& input : txInfo.Inputs)
+            {
+                UniValue inputJson(UniValue::VARR);
+                inputJson.push_back(txInfo.Hash);
+                inputJson.push_back(input.first);
+                inputJson.push_back(input.second);
+                inputsJson.push_back(inputJson);
+            }
+        }
+
+        auto stmtTxsTable = SetupSqlStatement(R"sql(
+            create temp table if not exists IndexingTxs
+            (
+                Hash      text not null primary key,
+                BlockNum  int  not null,
+                Kind      int  not null,
+                KeyType   int  not null,
+                Key1      text not null,
+                Key2      text not null
+            )
+        )sql");
+        TryStepStatement(stmtTxsTable);
+
+        auto stmtInputsTable = SetupSqlStatement(R"sql(
+            create temp table if not exists IndexingInputs
+            (
+                SpentTxHash text not null,
+                TxHash      text not null,
+                Number      int  not null,
+                primary key (TxHash, Number)
+            )
+        )sql");
+        TryStepStatement(stmtInputsTable);
+
+        auto stmtIdsTable = SetupSqlStatement(R"sql(
+            create temp table if not exists IndexingIds
+            (
+                Kind      int  not null,
+                KeyType   int  not null,
+                Key1      text not null,
+                Key2      text not null,
+                FirstNum  int  not null,
+                LastNum   int  not null,
+                Id        int  null,
+                primary key (Kind, KeyType, Key1, Key2)
+            )
+        )sql");
+        TryStepStatement(stmtIdsTable);
+
+        auto stmtClearTxs = SetupSqlStatement(R"sql(
+            delete from temp.IndexingTxs
+        )sql");
+        TryStepStatement(stmtClearTxs);
+
+        auto stmtClearInputs = SetupSqlStatement(R"sql(
+            delete from temp.IndexingInputs
+        )sql");
+        TryStepStatement(stmtClearInputs);
+
+        auto stmtClearIds = SetupSqlStatement(R"sql(
+            delete from temp.IndexingIds
+        )sql");
+        TryStepStatement(stmtClearIds);
+
+        // Key of transaction chain for Id & Last:
+        // Account - Type + String1 (AddressHash)
+        // Content & Comment - String2 (RootTxHash)
+        // Blocking & Subscribe - String1 (AddressHash) + String2 (AddressToHash)
+        auto stmtTxs = SetupSqlStatement(R"sql(
+            insert into temp.IndexingTxs (Hash, BlockNum, Kind, KeyType, Key1, Key2)
+            select
+                js.Hash,
+                js.BlockNum,
+                js.Kind,
+                (case js.Kind when 1 then ifnull(t.Type, 0) else 0 end),
+                (case when js.Kind in (1, 4, 5) then ifnull(t.String1, '') else '' end),
+                (case when js.Kind in (2, 3, 4, 5) then ifnull(t.String2, '') else '' end)
+            from (
+                select
+                    json_extract(j.value, '$[0]')Hash,
+                    json_extract(j.value, '$[1]')BlockNum,
+                    json_extract(j.value, '$[2]')Kind
+                from json_each(?) j
+            ) js
+            left join Transactions t on t.Hash = js.Hash
+        )sql");
+        auto txsJsonStr = txsJson.write();
+        TryBindStatementText(stmtTxs, 1, txsJsonStr);
+        TryStepStatement(stmtTxs);
+
+        auto stmtInputs = SetupSqlStatement(R"sql(
+            insert or ignore into temp.IndexingInputs (SpentTxHash, TxHash, Number)
+            select
+                json_extract(j.value, '$[0]'),
+                json_extract(j.value, '$[1]'),
+                json_extract(j.value, '$[2]')
+            from json_each(?) j
+        )sql");
+        auto inputsJsonStr = inputsJson.write();
+        TryBindStatementText(stmtInputs, 1, inputsJsonStr);
+        TryStepStatement(stmtInputs);
+    }
+
+    void ChainRepository::UpdateTransactionsHeight(const string& blockHash, int height)
+    {
+        auto stmt = SetupSqlStatement(R"sql(
+            UPDATE Transactions SET
+                BlockHash = ?,
+                BlockNum = b.BlockNum,
+                Height = ?
+            FROM temp.IndexingTxs b
+            WHERE Transactions.Hash = b.Hash
+        )sql");
+        TryBindStatementText(stmt, 1, blockHash);
+        TryBindStatementInt(stmt, 2, height);
+        TryStepStatement(stmt);
+
+        auto stmtOuts = SetupSqlStatement(R"sql(
+            UPDATE TxOutputs SET
+                TxHeight = ?
+            WHERE TxHash in (select b.Hash from temp.IndexingTxs b)
+        )sql");
+        TryBindStatementInt(stmtOuts, 1, height);
+        TryStepStatement(stmtOuts);
+    }
+
+    void ChainRepository::UpdateTransactionsOutputs(int height)
+    {
+        auto stmt = SetupSqlStatement(R"sql(
+            UPDATE TxOutputs SET
+                SpentHeight = ?,
+                SpentTxHash = i.SpentTxHash
+            FROM temp.IndexingInputs i
+            WHERE TxOutputs.TxHash = i.TxHash and TxOutputs.Number = i.Number
+        )sql");
+        TryBindStatementInt(stmt, 1, height);
+        TryStepStatement(stmt);
+    }
+
+    void ChainRepository::IndexIds()
+    {
+        // Group block transactions by chain key
+        // Only last transaction of chain in block will be marked as Last
+        auto stmtKeys = SetupSqlStatement(R"sql(
+            insert into temp.IndexingIds (Kind, KeyType, Key1, Key2, FirstNum, LastNum)
+            select b.Kind, b.KeyType, b.Key1, b.Key2, min(b.BlockNum), max(b.BlockNum)
+            from temp.IndexingTxs b
+            where b.Kind between 1 and 5
+            group by b.Kind, b.KeyType, b.Key1, b.Key2
+        )sql");
+        TryStepStatement(stmtKeys);
+
+        // Copy Id from previous Last record of chain
+        auto stmtExists = SetupSqlStatement(R"sql(
+            update temp.IndexingIds set
+                Id = (case Kind
+                    when 1 then (
+                        select a.Id
+                        from Transactions a indexed by Transactions_Type_Last_String1_Height_Id
+                        where a.Type = IndexingIds.KeyType
+                            and a.Last = 1
+                            and a.String1 = IndexingIds.Key1
+                            and a.Height is not null
+                        limit 1
+                    )
+                    when 2 then (
+                        select c.Id
+                        from Transactions c indexed by Transactions_Type_Last_String2_Height
+                        where c.Type in (200,201,202,207)
+                            and c.Last = 1
+                            and c.String2 = IndexingIds.Key2
+                            and c.Height is not null
+                        limit 1
+                    )
+                    when 3 then (
+                        select max( c.Id )
+                        from Transactions c indexed by Transactions_Type_Last_String2_Height
+                        where c.Type in (204, 205, 206)
+                            and c.Last = 1
+                            and c.String2 = IndexingIds.Key2
+                            and c.Height is not null
+                    )
+                    when 4 then (
+                        select a.Id
+                        from Transactions a indexed by Transactions_Type_Last_String1_String2_Height
+                        where a.Type in (305, 306)
+                            and a.Last = 1
+                            and a.String1 = IndexingIds.Key1
+                            and a.String2 = IndexingIds.Key2
+                            and a.Height is not null
+                        limit 1
+                    )
+                    when 5 then (
+                        select a.Id
+                        from Transactions a indexed by Transactions_Type_Last_String1_String2_Height
+                        where a.Type in (302, 303, 304)
+                            and a.Last = 1
+                            and a.String1 = IndexingIds.Key1
+                            and a.String2 = IndexingIds.Key2
+                            and a.Height is not null
+                        limit 1
+                    )
+                end)
+        )sql");
+        TryStepStatement(stmtExists);
+
+        // New chains get sequential Ids in order of first transaction in block
+        auto stmtNew = SetupSqlStatement(R"sql(
+            update temp.IndexingIds set
+                Id = n.Id
+            from (
+                select
+                    i.rowid,
+                    ifnull(
+                        (
+                            select max( t.Id )
+                            from Transactions t indexed by Transactions_Id
+                        ),
+                        -1 -- for first record
+                    ) + row_number() over (order by i.FirstNum) Id
+                from temp.IndexingIds i
+                where i.Id is null
+            ) n
+            where IndexingIds.rowid = n.rowid
+        )sql");
+        TryStepStatement(stmtNew);
+
+        // Clear old last records for set new last
+        auto stmtOld = SetupSqlStatement(R"sql(
+            UPDATE Transactions indexed by Transactions_Id_Last SET
+                Last = 0
+            WHERE Transactions.Id in (select i.Id from temp.IndexingIds i)
+                and Transactions.Last = 1
+        )sql");
+        TryStepStatement(stmtOld);
+
+        // Set Id and Last for block transactions
+        auto stmtSet = SetupSqlStatement(R"sql(
+            UPDATE Transactions SET
+                Id = m.Id,
+                Last = m.Last
+            FROM (
+                select
+                    b.Hash,
+                    i.Id,
+                    (case when b.BlockNum = i.LastNum then 1 else 0 end)Last
+                from temp.IndexingTxs b
+                join temp.IndexingIds i on i.Kind = b.Kind and i.KeyType = b.KeyType and i.Key1 = b.Key1 and i.Key2 = b.Key2
+            ) m
+            WHERE Transactions.Hash = m.Hash
+        )sql");
+        TryStepStatement(stmtSet);
+    }
+
+    void ChainRepository::IndexBoostContents()
+    {
+        auto stmt = SetupSqlStatement(R"sql(
+            update Transactions
+            set Int1 =
+              (
+                (
+                  select sum(i.Value)
+                  from TxOutputs i indexed by TxOutputs_SpentTxHash
+                  where i.SpentTxHash = Transactions.Hash
+                ) - (
+                  select sum(o.Value)
+                  from TxOutputs o indexed by TxOutputs_TxHash_AddressHash_Value
+                  where TxHash = Transactions.Hash
+                )
+              )
+            where Transactions.Hash in (select b.Hash from temp.IndexingTxs b where b.Kind = 6)
+              and Transactions.Type in (208)
+        )sql");
+        TryStepStatement(stmt);
+    }
+
     void ChainRepository::RestoreOldLast(int height)
     {
         int64_t nTime1 = GetTimeMicros();
@@ -598,4 +962,339 @@ namespace PocketDb
     }
 
 
+    void ChainRepository::IndexAccountStats(int height)
+    {
+        TryTransactionStep(__func__, [&]()
+        {
+            int64_t nTime1 = GetTimeMicros();
+
+            QueueAccountStats(height);
+            RefreshAccountStats();
+
+            int64_t nTime2 = GetTimeMicros();
+            LogPrint(BCLog::BENCH, "    - IndexAccountStats: %.2fms\n", 0.001 * double(nTime2 - nTime1));
+        });
+    }
+
+    void ChainRepository::BuildAccountStats()
+    {
+        bool empty = true;
+        bool accounts = false;
+
+        TryTransactionStep(__func__, [&]()
+        {
+            auto stmt = SetupSqlStatement(R"sql(
+                select
+                    exists (select 1 from AccountStats),
+                    exists (select 1 from Transactions indexed by Transactions_Type_Last_String1_Height_Id
+                        where Type in (100,101,102) and Last = 1 and String1 is not null and Height is not null)
+            )sql");
+
+            if (sqlite3_step(*stmt) == SQLITE_ROW)
+            {
+                if (auto[ok, value] = TryGetColumnInt(*stmt, 0); ok) empty = (value == 0);
+                if (auto[ok, value] = TryGetColumnInt(*stmt, 1); ok) accounts = (value == 1);
+            }
+
+            FinalizeSqlStatement(*stmt);
+        });
+
+        if (!empty || !accounts)
+            return;
+
+        LogPrintf("Building account statistics. This can take a few minutes..\n");
+        int64_t nTime1 = GetTimeMicros();
+
+        TryTransactionStep(__func__, [&]()
+        {
+            auto stmt = SetupSqlStatement(R"sql(
+                insert into AccountStats (Address, Posts, Subscribes, Subscribers, Blockings, Likers, Referrals)
+            )sql" + AccountStatsSql(""));
+            TryStepStatement(stmt);
+        });
+
+        int64_t nTime2 = GetTimeMicros();
+        LogPrintf("Account statistics built in %.2fs\n", 0.000001 * double(nTime2 - nTime1));
+    }
+
+    string ChainRepository::AccountStatsSql(const string& filter)
+    {
+        return R"sql(
+            select
+                u.String1 as Address,
+
+                (select count(1) from Transactions po indexed by Transactions_Type_Last_String1_Height_Id
+                    where po.Type in (200,201,202) and po.Last = 1 and po.Height is not null and po.String1 = u.String1) as Posts,
+
+                (select count(1) from Transactions subs indexed by Transactions_Type_Last_String1_Height_Id
+                    where subs.Type in (302,303) and subs.Last = 1 and subs.Height is not null and subs.String1 = u.String1) as Subscribes,
+
+                (select count(1) from Transactions subs indexed by Transactions_Type_Last_String2_Height
+                    where subs.Type in (302,303) and subs.Last = 1 and subs.Height is not null and subs.String2 = u.String1) as Subscribers,
+
+                (select count(1) from Transactions blck indexed by Transactions_Type_Last_String1_Height_Id
+                    where blck.Type in (305) and blck.Last = 1 and blck.Height is not null and blck.String1 = u.String1) as Blockings,
+
+                (select count(1) from Ratings lkr indexed by Ratings_Type_Id_Last_Height
+                    where lkr.Type = 1 and lkr.Id = u.Id) as Likers,
+
+                (select count(1) from Transactions ru indexed by Transactions_Type_Last_String2_Height
+                    where ru.Type in (100) and ru.Last in (0,1) and ru.Height > 0 and ru.String2 = u.String1
+                      and ru.ROWID = (select min(ru1.ROWID) from Transactions ru1 indexed by Transactions_Id where ru1.Id = ru.Id limit 1)) as Referrals
+
+            from Transactions u indexed by Transactions_Type_Last_String1_Height_Id
+            where u.Type in (100,101,102)
+              and u.Last = 1
+              and u.Height is not null
+              and u.String1 is not null
+        )sql" + filter;
+    }
+
+    void ChainRepository::QueueAccountStats(int height)
+    {
+        auto stmtTable = SetupSqlStatement(R"sql(
+            create temp table if not exists AccountStatsQueue
+            (
+                Address text not null primary key
+            )
+        )sql");
+        TryStepStatement(stmtTable);
+
+        // Authors of accounts, contents, subscribes and blockings; targets of subscribes and referrers;
+        // accounts received new likers
+        auto stmt = SetupSqlStatement(R"sql(
+            insert or ignore into temp.AccountStatsQueue (Address)
+            select t.String1
+            from Transactions t indexed by Transactions_Height_Id
+            where t.Height >= ?
+              and t.Type in (100,101,102,200,201,202,207,302,303,304,305,306)
+              and t.String1 is not null
+
+            union
+
+            select t.String2
+            from Transactions t indexed by Transactions_Height_Id
+            where t.Height >= ?
+              and t.Type in (100,302,303,304)
+              and t.String2 is not null
+
+            union
+
+            select u.String1
+            from Ratings r indexed by Ratings_Height_Last
+            cross join Transactions u indexed by Transactions_Id_Last
+                on u.Id = r.Id and u.Last = 1 and u.Type in (100,101,102)
+            where r.Height >= ?
+              and r.Type = 1
+              and u.String1 is not null
+        )sql");
+        TryBindStatementInt(stmt, 1, height);
+        TryBindStatementInt(stmt, 2, height);
+        TryBindStatementInt(stmt, 3, height);
+        TryStepStatement(stmt);
+    }
+
+    void ChainRepository::RefreshAccountStats()
+    {
+        auto stmtDelete = SetupSqlStatement(R"sql(
+            delete from AccountStats
+            where Address in (select q.Address from temp.AccountStatsQueue q)
+        )sql");
+        TryStepStatement(stmtDelete);
+
+        // Accounts removed by rollback are not selected and stay deleted
+        auto stmtInsert = SetupSqlStatement(R"sql(
+            insert into AccountStats (Address, Posts, Subscribes, Subscribers, Blockings, Likers, Referrals)
+        )sql" + AccountStatsSql(R"sql(
+              and u.String1 in (select q.Address from temp.AccountStatsQueue q)
+        )sql"));
+        TryStepStatement(stmtInsert);
+
+        auto stmtClear = SetupSqlStatement(R"sql(
+            delete from temp.AccountStatsQueue
+        )sql");
+        TryStepStatement(stmtClear);
+    }
+
+    void ChainRepository::IndexContentStats(int height)
+    {
+        TryTransactionStep(__func__, [&]()
+        {
+            int64_t nTime1 = GetTimeMicros();
+
+            QueueContentStats(height);
+            RefreshContentStats();
+
+            int64_t nTime2 = GetTimeMicros();
+            LogPrint(BCLog::BENCH, "    - IndexContentStats: %.2fms\n", 0.001 * double(nTime2 - nTime1));
+        });
+    }
+
+    void ChainRepository::BuildContentStats()
+    {
+        bool empty = true;
+        bool contents = false;
+
+        TryTransactionStep(__func__, [&]()
+        {
+            auto stmt = SetupSqlStatement(R"sql(
+                select
+                    exists (select 1 from ContentStats),
+                    exists (select 1 from Transactions indexed by Transactions_Type_Last_Height_Id
+                        where Type in (200,201,202,207) and Last = 1 and Height is not null)
+            )sql");
+
+            if (sqlite3_step(*stmt) == SQLITE_ROW)
+            {
+                if (auto[ok, value] = TryGetColumnInt(*stmt, 0); ok) empty = (value == 0);
+                if (auto[ok, value] = TryGetColumnInt(*stmt, 1); ok) contents = (value == 1);
+            }
+
+            FinalizeSqlStatement(*stmt);
+        });
+
+        if (!empty || !contents)
+            return;
+
+        LogPrintf("Building content statistics. This can take a few minutes..\n");
+        int64_t nTime1 = GetTimeMicros();
+
+        TryTransactionStep(__func__, [&]()
+        {
+            auto stmt = SetupSqlStatement(R"sql(
+                insert into ContentStats (ContentId, ScoresCount, ScoresSum, Reposted, Comments)
+            )sql" + ContentStatsSql(""));
+            TryStepStatement(stmt);
+        });
+
+        int64_t nTime2 = GetTimeMicros();
+        LogPrintf("Content statistics built in %.2fs\n", 0.000001 * double(nTime2 - nTime1));
+    }
+
+    string ChainRepository::ContentStatsSql(const string& filter)
+    {
+        return R"sql(
+            select
+                c.Id as ContentId,
+
+                (select count() from Transactions scr indexed by Transactions_Type_Last_String2_Height
+                    where scr.Type = 300 and scr.Last in (0,1) and scr.Height is not null and scr.String2 = c.String2) as ScoresCount,
+
+                ifnull((select sum(scr.Int1) from Transactions scr indexed by Transactions_Type_Last_String2_Height
+                    where scr.Type = 300 and scr.Last in (0,1) and scr.Height is not null and scr.String2 = c.String2),0) as ScoresSum,
+
+                (select count() from Transactions rep indexed by Transactions_Type_Last_String3_Height
+                    where rep.Type in (200,201,202) and rep.Last = 1 and rep.Height is not null and rep.String3 = c.String2) as Reposted,
+
+                (
+                    select count()
+                    from Transactions s indexed by Transactions_Type_Last_String3_Height
+                    where s.Type in (204, 205)
+                      and s.Height is not null
+                      and s.String3 = c.String2
+                      and s.Last = 1
+                      -- exclude commenters blocked by the author of the post
+                      and not exists (
+                        select 1
+                        from Transactions b indexed by Transactions_Type_Last_String1_Height_Id
+                        where b.Type in (305)
+                            and b.Last = 1
+                            and b.Height > 0
+                            and b.String1 = c.String1
+                            and b.String2 = s.String1
+                      )
+                ) as Comments
+
+            from Transactions c indexed by Transactions_Last_Id_Height
+            where c.Type in (200,201,202,207)
+              and c.Last = 1
+              and c.Height is not null
+        )sql" + filter;
+    }
+
+    void ChainRepository::QueueContentStats(int height)
+    {
+        auto stmtTable = SetupSqlStatement(R"sql(
+            create temp table if not exists ContentStatsQueue
+            (
+                Id int not null primary key
+            )
+        )sql");
+        TryStepStatement(stmtTable);
+
+        // Contents created, edited, scored, reposted or commented; originals of deleted reposts - delete
+        // has no relay hash, it is taken from previous version; all contents of authors changed their
+        // blockings - comments of blocked accounts are not counted
+        auto stmt = SetupSqlStatement(R"sql(
+            insert or ignore into temp.ContentStatsQueue (Id)
+            select c.Id
+            from Transactions c indexed by Transactions_Type_Last_String2_Height
+            where c.Type in (200,201,202,207)
+              and c.Last = 1
+              and c.Height is not null
+              and c.String2 in (
+                select t.String2
+                from Transactions t indexed by Transactions_Height_Id
+                where t.Height >= ?
+                  and t.Type in (200,201,202,207,300)
+                  and t.String2 is not null
+
+                union
+
+                select t.String3
+                from Transactions t indexed by Transactions_Height_Id
+                where t.Height >= ?
+                  and t.Type in (200,201,202,204,205,206,207)
+                  and t.String3 is not null
+
+                union
+
+                select p.String3
+                from Transactions t indexed by Transactions_Height_Id
+                cross join Transactions p indexed by Transactions_Last_Id_Height
+                    on p.Last = 0 and p.Id = t.Id and p.Height < t.Height
+                where t.Height >= ?
+                  and t.Type in (207)
+                  and p.Type in (200,201,202)
+                  and p.String3 is not null
+              )
+
+            union
+
+            select c.Id
+            from Transactions b indexed by Transactions_Height_Id
+            cross join Transactions c indexed by Transactions_Type_Last_String1_Height_Id
+                on c.Type in (200,201,202,207) and c.Last = 1 and c.String1 = b.String1 and c.Height is not null
+            where b.Height >= ?
+              and b.Type in (305,306)
+        )sql");
+        TryBindStatementInt(stmt, 1, height);
+        TryBindStatementInt(stmt, 2, height);
+        TryBindStatementInt(stmt, 3, height);
+        TryBindStatementInt(stmt, 4, height);
+        TryStepStatement(stmt);
+    }
+
+    void ChainRepository::RefreshContentStats()
+    {
+        auto stmtDelete = SetupSqlStatement(R"sql(
+            delete from ContentStats
+            where ContentId in (select q.Id from temp.ContentStatsQueue q)
+        )sql");
+        TryStepStatement(stmtDelete);
+
+        // Contents removed by rollback are not selected and stay deleted
+        auto stmtInsert = SetupSqlStatement(R"sql(
+            insert into ContentStats (ContentId, ScoresCount, ScoresSum, Reposted, Comments)
+        )sql" + ContentStatsSql(R"sql(
+              and c.Id in (select q.Id from temp.ContentStatsQueue q)
+        )sql"));
+        TryStepStatement(stmtInsert);
+
+        auto stmtClear = SetupSqlStatement(R"sql(
+            delete from temp.ContentStatsQueue
+        )sql");
+        TryStepStatement(stmtClear);
+    }
+
 } // namespace PocketDb
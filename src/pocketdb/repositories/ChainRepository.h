@@ -24,6 +24,8 @@ namespace PocketDb
 
     using namespace PocketTx;
 
+    static const bool DEFAULT_SQL_BATCH_INDEX = true;
+
     class ChainRepository : public BaseRepository
     {
     public:
@@ -48,8 +50,31 @@ namespace PocketDb
         // Check block exist in db
         tuple<bool, bool> ExistsBlock(const string& blockHash, int height);
 
+        // Recalculate AccountStats counters of accounts affected by block
+        void IndexAccountStats(int height);
+
+        // Fill AccountStats for database indexed before counters existed
+        void BuildAccountStats();
+
+        // Select of counters calculated from scratch - columns in order of AccountStats table.
+        // Filter appended to where clause over account transaction `u`.
+        static string AccountStatsSql(const string& filter);
+
+        // Recalculate ContentStats counters of contents affected by block
+        void IndexContentStats(int height);
+
+        // Fill ContentStats for database indexed before counters existed
+        void BuildContentStats();
+
+        // Select of content counters calculated from scratch - columns in order of ContentStats table.
+        // Filter appended to where clause over last content transaction `c`.
+        static string ContentStatsSql(const string& filter);
+
     private:
 
+        void IndexBlockSequential(const string& blockHash, int height, vector<TransactionIndexingInfo>& txs);
+        void IndexBlockBatch(const string& blockHash, int height, vector<TransactionIndexingInfo>& txs);
+
         void RollbackHeight(int height);
         void RestoreOldLast(int height);
 
@@ -65,6 +90,21 @@ namespace PocketDb
 
         void ClearOldLast(const string& txHash);
 
+        // Set-based block indexing over temporary tables
+        void StageBlockTransactions(const vector<TransactionIndexingInfo>& txs);
+        void UpdateTransactionsHeight(const string& blockHash, int height);
+        void UpdateTransactionsOutputs(int height);
+        void IndexIds();
+        void IndexBoostContents();
+
+        // Queue accounts affected by blocks great or equals height and recalculate their counters
+        void QueueAccountStats(int height);
+        void RefreshAccountStats();
+
+        // Queue contents affected by blocks great or equals height and recalculate their counters
+        void QueueContentStats(int height);
+        void RefreshContentStats();
+
     };
 
 } // namespace PocketDb
@@ -835,89 +835,8 @@ namespace PocketDb
     }
 
 
-    // Mempool counts
+    // Chain counts
 
-    int ConsensusRepository::CountMempoolBlocking(const string& address, const string& addressTo)
-    {
-        int result = 0;
-
-        TryTransactionStep(__func__, [&]()
-        {
-            auto stmt = SetupSqlStatement(R"sql(
-                select count(*)
-                from Transactions
-                where Type in (305, 306)
-                  and Height is null
-                  and String1 = ?
-                  and String2 = ?
-            )sql");
-
-            TryBindStatementText(stmt, 1, address);
-            TryBindStatementText(stmt, 2, addressTo);
-
-            if (sqlite3_step(*stmt) == SQLITE_ROW)
-                if (auto[ok, value] = TryGetColumnInt(*stmt, 0); ok)
-                    result = value;
-
-            FinalizeSqlStatement(*stmt);
-        });
-
-        return result;
-    }
-    int ConsensusRepository::CountMempoolSubscribe(const string& address, const string& addressTo)
-    {
-        int result = 0;
-
-        TryTransactionStep(__func__, [&]()
-        {
-            auto stmt = SetupSqlStatement(R"sql(
-                select count(*)
-                from Transactions
-                where Type in (302, 303, 304)
-                  and Height is null
-                  and String1 = ?
-                  and String2 = ?
-            )sql");
-
-            TryBindStatementText(stmt, 1, address);
-            TryBindStatementText(stmt, 2, addressTo);
-
-            if (sqlite3_step(*stmt) == SQLITE_ROW)
-                if (auto[ok, value] = TryGetColumnInt(*stmt, 0); ok)
-                    result = value;
-
-            FinalizeSqlStatement(*stmt);
-        });
-
-        return result;
-    }
-
-    int ConsensusRepository::CountMempoolComment(const string& address)
-    {
-        int result = 0;
-
-        TryTransactionStep(__func__, [&]()
-        {
-            auto stmt = SetupSqlStatement(R"sql(
-                select count(*)
-                from Transactions indexed by Transactions_Type_String1_Height_Time_Int1
-                where Type in (204)
-                  and Height is null
-                  and String1 = ?
-                  and Hash = String2
-            )sql");
-
-            TryBindStatementText(stmt, 1, address);
-
-            if (sqlite3_step(*stmt) == SQLITE_ROW)
-                if (auto[ok, value] = TryGetColumnInt(*stmt, 0); ok)
-                    result = value;
-
-            FinalizeSqlStatement(*stmt);
-        });
-
-        return result;
-    }
     int ConsensusRepository::CountChainCommentTime(const string& address, int64_t time)
     {
         int result = 0;
@@ -975,32 +894,6 @@ namespace PocketDb
         return result;
     }
 
-    int ConsensusRepository::CountMempoolComplain(const string& address)
-    {
-        int result = 0;
-
-        TryTransactionStep(__func__, [&]()
-        {
-            auto stmt = SetupSqlStatement(R"sql(
-                select count(*)
-                from Transactions
-                where Type in (307)
-                  and Height is null
-                  and String1 = ?
-                  and Hash = String2
-            )sql");
-
-            TryBindStatementText(stmt, 1, address);
-
-            if (sqlite3_step(*stmt) == SQLITE_ROW)
-                if (auto[ok, value] = TryGetColumnInt(*stmt, 0); ok)
-                    result = value;
-
-            FinalizeSqlStatement(*stmt);
-        });
-
-        return result;
-    }
     int ConsensusRepository::CountChainComplainTime(const string& address, int64_t time)
     {
         int result = 0;
@@ -1058,32 +951,6 @@ namespace PocketDb
         return result;
     }
 
-    int ConsensusRepository::CountMempoolPost(const string& address)
-    {
-        int result = 0;
-
-        TryTransactionStep(__func__, [&]()
-        {
-            auto stmt = SetupSqlStatement(R"sql(
-                select count(*)
-                from Transactions indexed by Transactions_Type_String1_Height_Time_Int1
-                where Type in (200)
-                  and Height is null
-                  and String1 = ?
-                  and Hash = String2
-            )sql");
-
-            TryBindStatementText(stmt, 1, address);
-
-            if (sqlite3_step(*stmt) == SQLITE_ROW)
-                if (auto[ok, value] = TryGetColumnInt(*stmt, 0); ok)
-                    result = value;
-
-            FinalizeSqlStatement(*stmt);
-        });
-
-        return result;
-    }
     int ConsensusRepository::CountChainPostTime(const string& address, int64_t time)
     {
         int result = 0;
@@ -1140,32 +1007,6 @@ namespace PocketDb
         return result;
     }
 
-    int ConsensusRepository::CountMempoolVideo(const string& address)
-    {
-        int result = 0;
-
-        TryTransactionStep(__func__, [&]()
-        {
-            auto stmt = SetupSqlStatement(R"sql(
-                select count(*)
-                from Transactions indexed by Transactions_Type_String1_Height_Time_Int1
-                where Type in (201)
-                  and Height is null
-                  and String1 = ?
-                  and Hash = String2
-            )sql");
-
-            TryBindStatementText(stmt, 1, address);
-
-            if (sqlite3_step(*stmt) == SQLITE_ROW)
-                if (auto[ok, value] = TryGetColumnInt(*stmt, 0); ok)
-                    result = value;
-
-            FinalizeSqlStatement(*stmt);
-        });
-
-        return result;
-    }
     int ConsensusRepository::CountChainVideo(const string& address, int height)
     {
         int result = 0;
@@ -1194,32 +1035,6 @@ namespace PocketDb
         return result;
     }
 
-    int ConsensusRepository::CountMempoolArticle(const string& address)
-    {
-        int result = 0;
-
-        TryTransactionStep(__func__, [&]()
-        {
-            auto stmt = SetupSqlStatement(R"sql(
-                select count(*)
-                from Transactions indexed by Transactions_Type_String1_Height_Time_Int1
-                where Type in (202)
-                  and Height is null
-                  and String1 = ?
-                  and Hash = String2
-            )sql");
-
-            TryBindStatementText(stmt, 1, address);
-
-            if (sqlite3_step(*stmt) == SQLITE_ROW)
-                if (auto[ok, value] = TryGetColumnInt(*stmt, 0); ok)
-                    result = value;
-
-            FinalizeSqlStatement(*stmt);
-        });
-
-        return result;
-    }
     int ConsensusRepository::CountChainArticle(const string& address, int height)
     {
         int result = 0;
@@ -1248,31 +1063,6 @@ namespace PocketDb
         return result;
     }
 
-    int ConsensusRepository::CountMempoolScoreComment(const string& address)
-    {
-        int result = 0;
-
-        TryTransactionStep(__func__, [&]()
-        {
-            auto stmt = SetupSqlStatement(R"sql(
-                select count(*)
-                from Transactions indexed by Transactions_Type_String1_Height_Time_Int1
-                where Type in (301)
-                  and Height is null
-                  and String1 = ?
-            )sql");
-
-            TryBindStatementText(stmt, 1, address);
-
-            if (sqlite3_step(*stmt) == SQLITE_ROW)
-                if (auto[ok, value] = TryGetColumnInt(*stmt, 0); ok)
-                    result = value;
-
-            FinalizeSqlStatement(*stmt);
-        });
-
-        return result;
-    }
     int ConsensusRepository::CountChainScoreCommentTime(const string& address, int64_t time)
     {
         int result = 0;
@@ -1328,31 +1118,6 @@ namespace PocketDb
         return result;
     }
 
-    int ConsensusRepository::CountMempoolScoreContent(const string& address)
-    {
-        int result = 0;
-
-        TryTransactionStep(__func__, [&]()
-        {
-            auto stmt = SetupSqlStatement(R"sql(
-                select count(*)
-                from Transactions indexed by Transactions_Type_String1_Height_Time_Int1
-                where Type in (300)
-                  and Height is null
-                  and String1 = ?
-            )sql");
-
-            TryBindStatementText(stmt, 1, address);
-
-            if (sqlite3_step(*stmt) == SQLITE_ROW)
-                if (auto[ok, value] = TryGetColumnInt(*stmt, 0); ok)
-                    result = value;
-
-            FinalizeSqlStatement(*stmt);
-        });
-
-        return result;
-    }
     int ConsensusRepository::CountChainScoreContentTime(const string& address, int64_t time)
     {
         int result = 0;
@@ -1408,57 +1173,6 @@ namespace PocketDb
         return result;
     }
 
-    int ConsensusRepository::CountMempoolUser(const string& address)
-    {
-        int result = 0;
-
-        TryTransactionStep(__func__, [&]()
-        {
-            auto stmt = SetupSqlStatement(R"sql(
-                select count(*)
-                from Transactions
-                where Type in (100)
-                  and Height is null
-                  and String1 = ?
-            )sql");
-
-            TryBindStatementText(stmt, 1, address);
-
-            if (sqlite3_step(*stmt) == SQLITE_ROW)
-                if (auto[ok, value] = TryGetColumnInt(*stmt, 0); ok)
-                    result = value;
-
-            FinalizeSqlStatement(*stmt);
-        });
-
-        return result;
-    }
-
-    int ConsensusRepository::CountMempoolAccountSetting(const string& address)
-    {
-        int result = 0;
-
-        TryTransactionStep(__func__, [&]()
-        {
-            auto stmt = SetupSqlStatement(R"sql(
-                select count(*)
-                from Transactions
-                where Type in (103)
-                  and Height is null
-                  and String1 = ?
-            )sql");
-
-            TryBindStatementText(stmt, 1, address);
-
-            if (sqlite3_step(*stmt) == SQLITE_ROW)
-                if (auto[ok, value] = TryGetColumnInt(*stmt, 0); ok)
-                    result = value;
-
-            FinalizeSqlStatement(*stmt);
-        });
-
-        return result;
-    }
     int ConsensusRepository::CountChainAccountSetting(const string& address, int height)
     {
         int result = 0;
@@ -1518,33 +1232,6 @@ namespace PocketDb
 
     // EDITS
 
-    int ConsensusRepository::CountMempoolCommentEdit(const string& address, const string& rootTxHash)
-    {
-        int result = 0;
-
-        TryTransactionStep(__func__, [&]()
-        {
-            auto stmt = SetupSqlStatement(R"sql(
-                select count(*)
-                from Transactions indexed by Transactions_Type_String1_String2_Height
-                where Type in (204,205,206)
-                  and Height is null
-                  and String1 = ?
-                  and String2 = ?
-            )sql");
-
-            TryBindStatementText(stmt, 1, address);
-            TryBindStatementText(stmt, 2, rootTxHash);
-
-            if (sqlite3_step(*stmt) == SQLITE_ROW)
-                if (auto[ok, value] = TryGetColumnInt(*stmt, 0); ok)
-                    result = value;
-
-            FinalizeSqlStatement(*stmt);
-        });
-
-        return result;
-    }
     int ConsensusRepository::CountChainCommentEdit(const string& address, const string& rootTxHash)
     {
         int result = 0;
@@ -1574,33 +1261,6 @@ namespace PocketDb
         return result;
     }
 
-    int ConsensusRepository::CountMempoolPostEdit(const string& address, const string& rootTxHash)
-    {
-        int result = 0;
-
-        TryTransactionStep(__func__, [&]()
-        {
-            auto stmt = SetupSqlStatement(R"sql(
-                select count(*)
-                from Transactions indexed by Transactions_Type_String1_String2_Height
-                where Type in (200,207)
-                  and Height is null
-                  and String1 = ?
-                  and String2 = ?
-            )sql");
-
-            TryBindStatementText(stmt, 1, address);
-            TryBindStatementText(stmt, 2, rootTxHash);
-
-            if (sqlite3_step(*stmt) == SQLITE_ROW)
-                if (auto[ok, value] = TryGetColumnInt(*stmt, 0); ok)
-                    result = value;
-
-            FinalizeSqlStatement(*stmt);
-        });
-
-        return result;
-    }
     int ConsensusRepository::CountChainPostEdit(const string& address, const string& rootTxHash)
     {
         int result = 0;
@@ -1630,33 +1290,6 @@ namespace PocketDb
         return result;
     }
 
-    int ConsensusRepository::CountMempoolVideoEdit(const string& address, const string& rootTxHash)
-    {
-        int result = 0;
-
-        TryTransactionStep(__func__, [&]()
-        {
-            auto stmt = SetupSqlStatement(R"sql(
-                select count(*)
-                from Transactions indexed by Transactions_Type_String1_String2_Height
-                where Type in (201,207)
-                  and Height is null
-                  and String1 = ?
-                  and String2 = ?
-            )sql");
-
-            TryBindStatementText(stmt, 1, address);
-            TryBindStatementText(stmt, 2, rootTxHash);
-
-            if (sqlite3_step(*stmt) == SQLITE_ROW)
-                if (auto[ok, value] = TryGetColumnInt(*stmt, 0); ok)
-                    result = value;
-
-            FinalizeSqlStatement(*stmt);
-        });
-
-        return result;
-    }
     int ConsensusRepository::CountChainVideoEdit(const string& address, const string& rootTxHash)
     {
         int result = 0;
@@ -1686,33 +1319,6 @@ namespace PocketDb
         return result;
     }
 
-    int ConsensusRepository::CountMempoolArticleEdit(const string& address, const string& rootTxHash)
-    {
-        int result = 0;
-
-        TryTransactionStep(__func__, [&]()
-        {
-            auto stmt = SetupSqlStatement(R"sql(
-                select count(*)
-                from Transactions indexed by Transactions_Type_String1_String2_Height
-                where Type in (202,207)
-                  and Height is null
-                  and String1 = ?
-                  and String2 = ?
-            )sql");
-
-            TryBindStatementText(stmt, 1, address);
-            TryBindStatementText(stmt, 2, rootTxHash);
-
-            if (sqlite3_step(*stmt) == SQLITE_ROW)
-                if (auto[ok, value] = TryGetColumnInt(*stmt, 0); ok)
-                    result = value;
-
-            FinalizeSqlStatement(*stmt);
-        });
-
-        return result;
-    }
     int ConsensusRepository::CountChainArticleEdit(const string& address, const string& rootTxHash)
     {
         int result = 0;
@@ -1742,32 +1348,4 @@ namespace PocketDb
         return result;
     }
 
-    int ConsensusRepository::CountMempoolContentDelete(const string& address, const string& rootTxHash)
-    {
-        int result = 0;
-
-        TryTransactionStep(__func__, [&]()
-        {
-            auto stmt = SetupSqlStatement(R"sql(
-                select count(*)
-                from Transactions indexed by Transactions_Type_String1_String2_Height
-                where Type in (200,201,202,207)
-                  and Height is null
-                  and String1 = ?
-                  and String2 = ?
-            )sql");
-
-            TryBindStatementText(stmt, 1, address);
-            TryBindStatementText(stmt, 2, rootTxHash);
-
-            if (sqlite3_step(*stmt) == SQLITE_ROW)
-                if (auto[ok, value] = TryGetColumnInt(*stmt, 0); ok)
-                    result = value;
-
-            FinalizeSqlStatement(*stmt);
-        });
-
-        return result;
-    }
-
 }
\ No newline at end of file
@@ -72,58 +72,38 @@ namespace PocketDb
         bool ExistsUserRegistrations(vector<string>& addresses, bool mempool);
         bool ExistsAnotherByName(const string& address, const string& name);
 
-        // get counts in "mempool" - Height is null
-        int CountMempoolBlocking(const string& address, const string& addressTo);
-        int CountMempoolSubscribe(const string& address, const string& addressTo);
-
-        int CountMempoolComment(const string& address);
+        // get counts in chain - mempool counts are kept by SocialMempoolIndex of CTxMemPool
         int CountChainCommentTime(const string& address, int64_t time);
         int CountChainCommentHeight(const string& address, int height);
 
-        int CountMempoolComplain(const string& address);
         int CountChainComplainTime(const string& address, int64_t time);
         int CountChainComplainHeight(const string& address, int height);
 
-        int CountMempoolPost(const string& address);
         int CountChainPostTime(const string& address, int64_t time);
         int CountChainPostHeight(const string& address, int height);
 
-        int CountMempoolVideo(const string& address);
         int CountChainVideo(const string& address, int height);
 
-        int CountMempoolArticle(const string& address);
         int CountChainArticle(const string& address, int height);
 
-        int CountMempoolScoreComment(const string& address);
         int CountChainScoreCommentTime(const string& address, int64_t time);
         int CountChainScoreCommentHeight(const string& address, int height);
 
-        int CountMempoolScoreContent(const string& address);
         int CountChainScoreContentTime(const string& address, int64_t time);
         int CountChainScoreContentHeight(const string& address, int height);
 
-        int CountMempoolUser(const string& address);
-
-        int CountMempoolAccountSetting(const string& address);
         int CountChainAccountSetting(const string& address, int height);
 
         int CountChainAccount(TxType txType, const string& address, int height);
 
-        int CountMempoolCommentEdit(const string& address, const string& rootTxHash);
         int CountChainCommentEdit(const string& address, const string& rootTxHash);
-
-        int CountMempoolPostEdit(const string& address, const string& rootTxHash);
         int CountChainPostEdit(const string& address, const string& rootTxHash);
-
-        int CountMempoolVideoEdit(const string& address, const string& rootTxHash);
         int CountChainVideoEdit(const string& address, const string& rootTxHash);
-
-        int CountMempoolArticleEdit(const string& address, const string& rootTxHash);
         int CountChainArticleEdit(const string& address, const string& rootTxHash);
-
-        int CountMempoolContentDelete(const string& address, const string& rootTxHash);
     };
 
+    typedef std::shared_ptr<ConsensusRepository> ConsensusRepositoryRef;
+
 } // namespace PocketDb
 
 #endif // POCKETDB_CONSENSUSREPOSITORY_H
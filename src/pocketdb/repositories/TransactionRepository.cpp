@@ -2,14 +2,40 @@
 // Distributed under the Apache 2.0 software license, see the accompanying
 // https://www.apache.org/licenses/LICENSE-2.0
 
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <unordered_map>
+#include <uint256.h>
+
 #include "pocketdb/repositories/TransactionRepository.h"
 
 namespace PocketDb
 {
+    struct TxHashHasher
+    {
+        size_t operator()(const uint256& hash) const { return hash.GetCheapHash(); }
+    };
+
     class TransactionReconstructor : public RowAccessor
     {
     public:
-        TransactionReconstructor() {};
+        /**
+         * Slots of result are reserved for requested hashes up front, so rows are assembled
+         * through one unordered index keyed by binary hash without copying hash strings.
+         * @param onComplete - streaming mode: rows must be grouped by transaction hash, every transaction
+         * is passed to callback as soon as its rows end and released right after
+         */
+        explicit TransactionReconstructor(const vector<string>& txHashes, function<void(const PTransactionRef&)> onComplete = nullptr)
+            : m_onComplete(move(onComplete))
+        {
+            m_slots.reserve(txHashes.size());
+            m_index.reserve(txHashes.size());
+
+            for (const auto& txHash : txHashes)
+                if (m_index.emplace(uint256S(txHash), m_slots.size()).second)
+                    m_slots.emplace_back();
+        }
 
         /**
          * Pass a new row for reconstructor to collect all necessary data from it.
@@ -25,71 +51,120 @@ namespace PocketDb
             auto[okPartType, partType] = TryGetColumnInt(stmt, 0);
             if (!okPartType) return false;
 
-            auto[okTxHash, txHash] = TryGetColumnString(stmt, 1);
-            if (!okTxHash) return false;
+            auto txHashText = (const char*) sqlite3_column_text(stmt, 1);
+            if (!txHashText) return false;
+
+            auto it = m_index.find(uint256S(txHashText));
+            if (it == m_index.end()) return false;
 
-            if (partType > 0 && m_transactions.find(txHash) == m_transactions.end())
+            if (m_onComplete && it->second != m_current)
+                Flush();
+
+            m_current = it->second;
+            auto& slot = m_slots[it->second];
+
+            if (partType > 0 && !slot.Tx)
                 return false;
 
             switch (partType)
             {
-                case 0: {
-                    auto[ok, ptx] = ParseTransaction(stmt, txHash);
-                    if (!ok) return false;
-
-                    ptx->SetHash(txHash);
-                    m_transactions.emplace(txHash, ptx);
-                    
-                    return true;
-                }
+                case 0:
+                    return ParseTransaction(stmt, txHashText, slot);
                 case 1:
-                    return ParsePayload(stmt, m_transactions[txHash]);
+                    return ParsePayload(stmt, slot.Tx);
                 case 2:
-                    return ParseInput(stmt, m_transactions[txHash], txHash);
+                    return ParseInput(stmt, slot.Tx);
                 case 3:
-                    return ParseOutput(stmt, m_transactions[txHash], txHash);
+                    return ParseOutput(stmt, slot.Tx);
                 default:
                     return false;
             }
         }
 
         /**
-         * Return contructed block.
+         * Streaming mode: pass last transaction to callback
+         */
+        void Flush()
+        {
+            if (m_current >= m_slots.size())
+                return;
+
+            if (auto& slot = m_slots[m_current]; slot.Tx)
+            {
+                m_onComplete(slot.Tx);
+                slot.Tx = nullptr;
+            }
+
+            m_current = m_slots.size();
+        }
+
+        /**
+         * Return contructed block in block order: transactions already indexed in chain by height
+         * and position in block, then not yet indexed ones (block being connected, mempool) in order of request.
          */
         PocketBlockRef GetResult()
         {
+            vector<Slot*> found;
+            found.reserve(m_slots.size());
+            for (auto& slot : m_slots)
+                if (slot.Tx)
+                    found.push_back(&slot);
+
+            stable_sort(found.begin(), found.end(), [](const Slot* a, const Slot* b)
+            {
+                if (a->BlockNum < 0 || b->BlockNum < 0)
+                    return a->BlockNum >= 0 && b->BlockNum < 0;
+
+                return tie(a->Height, a->BlockNum) < tie(b->Height, b->BlockNum);
+            });
+
             PocketBlockRef pocketBlock = make_shared<PocketBlock>();
-            for (const auto[txHash, ptx] : m_transactions)
-                pocketBlock->push_back(ptx);
+            pocketBlock->reserve(found.size());
+            for (const auto* slot : found)
+                pocketBlock->push_back(slot->Tx);
 
             return pocketBlock;
         }
 
     private:
 
-        map<string, PTransactionRef> m_transactions;
+        struct Slot
+        {
+            PTransactionRef Tx;
+            int64_t Height = -1;
+            int64_t BlockNum = -1;
+        };
+
+        // Scratch of one block - placed in block arena if reconstructed within its scope
+        vector<Slot, BlockArenaAllocator<Slot>> m_slots;
+        unordered_map<uint256, size_t, TxHashHasher, equal_to<uint256>, BlockArenaAllocator<pair<const uint256, size_t>>> m_index;
+
+        function<void(const PTransactionRef&)> m_onComplete;
+        size_t m_current = numeric_limits<size_t>::max();
 
         /**
          * This method parses transaction data, constructs if needed and return construct entry to fill
-         * Index:   0  1     2     3     4          5       6     7   8        9        10       11       12       13    14    15
-         * Columns: 0, Hash, Type, Time, BlockHash, Height, Last, Id, String1, String2, String3, String4, String5, null, null, Int1
+         * Index:   0  1     2     3     4          5       6     7   8        9        10       11       12       13        14    15
+         * Columns: 0, Hash, Type, Time, BlockHash, Height, Last, Id, String1, String2, String3, String4, String5, BlockNum, null, Int1
          */
-        tuple<bool, PTransactionRef> ParseTransaction(sqlite3_stmt* stmt, const string& txHash)
+        bool ParseTransaction(sqlite3_stmt* stmt, const char* txHash, Slot& slot)
         {
             // Try get Type and create pocket transaction instance
             auto[okType, txType] = TryGetColumnInt(stmt, 2);
-            if (!okType) return {false, nullptr};
+            if (!okType) return false;
             
             PTransactionRef ptx = PocketHelpers::TransactionHelper::CreateInstance(static_cast<TxType>(txType));
-            if (!ptx) return {false, nullptr};
+            if (!ptx) return false;
+
+            ptx->SetHash(txHash);
 
             // Required fields
             if (auto[ok, value] = TryGetColumnInt64(stmt, 3); ok) ptx->SetTime(value);
-            else return {false, nullptr};
+            else return false;
 
             // Optional fields
             if (auto[ok, value] = TryGetColumnString(stmt, 4); ok) ptx->SetBlockHash(value);
-            if (auto[ok, value] = TryGetColumnInt64(stmt, 5); ok) ptx->SetHeight(value);
+            if (auto[ok, value] = TryGetColumnInt64(stmt, 5); ok) { ptx->SetHeight(value); slot.Height = value; }
             if (auto[ok, value] = TryGetColumnInt(stmt, 6); ok) ptx->SetLast(value == 1);
             if (auto[ok, value] = TryGetColumnInt64(stmt, 7); ok) ptx->SetId(value);
             if (auto[ok, value] = TryGetColumnString(stmt, 8); ok) ptx->SetString1(value);
@@ -97,9 +172,11 @@ namespace PocketDb
             if (auto[ok, value] = TryGetColumnString(stmt, 10); ok) ptx->SetString3(value);
             if (auto[ok, value] = TryGetColumnString(stmt, 11); ok) ptx->SetString4(value);
             if (auto[ok, value] = TryGetColumnString(stmt, 12); ok) ptx->SetString5(value);
+            if (auto[ok, value] = TryGetColumnInt64(stmt, 13); ok) slot.BlockNum = value;
             if (auto[ok, value] = TryGetColumnInt64(stmt, 15); ok) ptx->SetInt1(value);
 
-            return {true, ptx};
+            slot.Tx = move(ptx);
+            return true;
         }
 
         /**
@@ -107,7 +184,7 @@ namespace PocketDb
          * Index:   0  1       2     3     4     5     6     7     8        9        10       11       12       13       14       15
          * Columns: 1, TxHash, null, null, null, null, null, null, String1, String2, String3, String4, String5, String6, String7, Int1
          */
-        bool ParsePayload(sqlite3_stmt* stmt, PTransactionRef& ptx)
+        bool ParsePayload(sqlite3_stmt* stmt, const PTransactionRef& ptx)
         {
             ptx->GeneratePayload();
 
@@ -128,23 +205,22 @@ namespace PocketDb
          * Index:   0  1              2     3     4         5         6        7     8              9     10    11    12    13    14    15
          * Columns: 2, i.SpentTxHash, null, null, i.TxHash, i.Number, o.Value, null, o.AddressHash, null, null, null, null, null, null, null
          */
-        bool ParseInput(sqlite3_stmt* stmt, PTransactionRef& ptx, const string& txHash)
+        bool ParseInput(sqlite3_stmt* stmt, const PTransactionRef& ptx)
         {
             bool incomplete = false;
 
-            PTransactionInputRef input = make_shared<TransactionInput>();
-            input->SetSpentTxHash(txHash);
+            auto& input = ptx->Inputs().emplace_back();
+            input.SetSpentTxHash(*ptx->GetHash());
 
-            if (auto[ok, value] = TryGetColumnString(stmt, 4); ok) input->SetTxHash(value);
+            if (auto[ok, value] = TryGetColumnString(stmt, 4); ok) input.SetTxHash(value);
             else incomplete = true;
 
-            if (auto[ok, value] = TryGetColumnInt64(stmt, 5); ok) input->SetNumber(value);
+            if (auto[ok, value] = TryGetColumnInt64(stmt, 5); ok) input.SetNumber(value);
             else incomplete = true;
 
-            if (auto[ok, value] = TryGetColumnInt64(stmt, 6); ok) input->SetValue(value);
-            if (auto[ok, value] = TryGetColumnString(stmt, 8); ok) input->SetAddressHash(value);
+            if (auto[ok, value] = TryGetColumnInt64(stmt, 6); ok) input.SetValue(value);
+            if (auto[ok, value] = TryGetColumnString(stmt, 8); ok) input.SetAddressHash(value);
 
-            ptx->Inputs().push_back(input);
             return !incomplete;
         }
 
@@ -153,29 +229,28 @@ namespace PocketDb
          * Index:   0  1       2     3       4            5      6     7     8     9     10            11    12    13    14           15
          * Columns: 3, TxHash, null, Number, AddressHash, Value, null, null, null, null, ScriptPubKey, null, null, null, SpentTxHash, SpentHeight
          */
-        bool ParseOutput(sqlite3_stmt* stmt, PTransactionRef& ptx, const string& txHash)
+        bool ParseOutput(sqlite3_stmt* stmt, const PTransactionRef& ptx)
         {
             bool incomplete = false;
 
-            PTransactionOutputRef output = make_shared<TransactionOutput>();
-            output->SetTxHash(txHash);
+            auto& output = ptx->Outputs().emplace_back();
+            output.SetTxHash(*ptx->GetHash());
 
-            if (auto[ok, value] = TryGetColumnInt64(stmt, 3); ok) output->SetNumber(value);
+            if (auto[ok, value] = TryGetColumnInt64(stmt, 3); ok) output.SetNumber(value);
             else incomplete = true;
 
-            if (auto[ok, value] = TryGetColumnString(stmt, 4); ok) output->SetAddressHash(value);
+            if (auto[ok, value] = TryGetColumnString(stmt, 4); ok) output.SetAddressHash(value);
             else incomplete = true;
 
-            if (auto[ok, value] = TryGetColumnInt64(stmt, 5); ok) output->SetValue(value);
+            if (auto[ok, value] = TryGetColumnInt64(stmt, 5); ok) output.SetValue(value);
             else incomplete = true;
 
-            if (auto[ok, value] = TryGetColumnString(stmt, 10); ok) output->SetScriptPubKey(value);
+            if (auto[ok, value] = TryGetColumnString(stmt, 10); ok) output.SetScriptPubKey(value);
             else incomplete = true;
 
-            if (auto[ok, value] = TryGetColumnString(stmt, 14); ok) output->SetSpentTxHash(value);
-            if (auto[ok, value] = TryGetColumnInt64(stmt, 15); ok) output->SetSpentHeight(value);
+            if (auto[ok, value] = TryGetColumnString(stmt, 14); ok) output.SetSpentTxHash(value);
+            if (auto[ok, value] = TryGetColumnInt64(stmt, 15); ok) output.SetSpentHeight(value);
 
-            ptx->Outputs().push_back(output);
             return !incomplete;
         }
     };
@@ -205,11 +280,37 @@ namespace PocketDb
     }
 
     PocketBlockRef TransactionRepository::List(const vector<string>& txHashes, bool includePayload, bool includeInputs, bool includeOutputs)
+    {
+        TransactionReconstructor reconstructor(txHashes);
+
+        ListRows(__func__, txHashes, includePayload, includeInputs, includeOutputs, false, [&](sqlite3_stmt* stmt)
+        {
+            return reconstructor.FeedRow(stmt);
+        });
+
+        return reconstructor.GetResult();
+    }
+
+    void TransactionRepository::ListStream(const vector<string>& txHashes, const function<void(const PTransactionRef&)>& callback,
+        bool includePayload, bool includeInputs, bool includeOutputs)
+    {
+        TransactionReconstructor reconstructor(txHashes, callback);
+
+        ListRows(__func__, txHashes, includePayload, includeInputs, includeOutputs, true, [&](sqlite3_stmt* stmt)
+        {
+            return reconstructor.FeedRow(stmt);
+        });
+
+        reconstructor.Flush();
+    }
+
+    void TransactionRepository::ListRows(const string& func, const vector<string>& txHashes, bool includePayload, bool includeInputs,
+        bool includeOutputs, bool groupByTx, const function<bool(sqlite3_stmt*)>& feedRow)
     {
         string txReplacers = join(vector<string>(txHashes.size(), "?"), ",");
 
         auto sql = R"sql(
-            select (0)tp, Hash, Type, Time, BlockHash, Height, Last, Id, String1, String2, String3, String4, String5, null, null, Int1
+            select (0)tp, Hash, Type, Time, BlockHash, Height, Last, Id, String1, String2, String3, String4, String5, BlockNum, null, Int1
             from Transactions
             where Hash in ( )sql" + txReplacers + R"sql( )
         )sql" +
@@ -239,13 +340,14 @@ namespace PocketDb
             where TxHash in ( )sql" + txReplacers + R"sql( )
         )sql") : "") +
 
-        string(R"sql(
+        // Streaming needs all parts of transaction one after another
+        (groupByTx ? string(R"sql(
+            order by 2 asc, 1 asc
+        )sql") : string(R"sql(
             order by tp asc
-        )sql");
-        
-        TransactionReconstructor reconstructor;
+        )sql"));
 
-        TryTransactionStep(__func__, [&]()
+        TryTransactionStep(func, [&]()
         {
             auto stmt = SetupSqlStatement(sql);
             size_t i = 1;
@@ -268,7 +370,7 @@ namespace PocketDb
             while (sqlite3_step(*stmt) == SQLITE_ROW)
             {
                 // TODO (brangr): maybe throw exception if errors?
-                if (!reconstructor.FeedRow(*stmt))
+                if (!feedRow(*stmt))
                 {
                     break;
                 }
@@ -276,8 +378,6 @@ namespace PocketDb
 
             FinalizeSqlStatement(*stmt);
         });
-
-        return reconstructor.GetResult();
     }
 
     PTransactionRef TransactionRepository::Get(const string& hash, bool includePayload, bool includeInputs, bool includeOutputs)
@@ -514,9 +614,9 @@ namespace PocketDb
                 )
             )sql");
 
-            TryBindStatementText(stmt, 1, input->GetSpentTxHash());
-            TryBindStatementText(stmt, 2, input->GetTxHash());
-            TryBindStatementInt64(stmt, 3, input->GetNumber());
+            TryBindStatementText(stmt, 1, input.GetSpentTxHash());
+            TryBindStatementText(stmt, 2, input.GetTxHash());
+            TryBindStatementInt64(stmt, 3, input.GetNumber());
 
             TryStepStatement(stmt);
         }
@@ -545,11 +645,11 @@ namespace PocketDb
                 )
             )sql");
 
-            TryBindStatementText(stmt, 1, output->GetTxHash());
-            TryBindStatementInt64(stmt, 2, output->GetNumber());
-            TryBindStatementText(stmt, 3, output->GetAddressHash());
-            TryBindStatementInt64(stmt, 4, output->GetValue());
-            TryBindStatementText(stmt, 5, output->GetScriptPubKey());
+            TryBindStatementText(stmt, 1, output.GetTxHash());
+            TryBindStatementInt64(stmt, 2, output.GetNumber());
+            TryBindStatementText(stmt, 3, output.GetAddressHash());
+            TryBindStatementInt64(stmt, 4, output.GetValue());
+            TryBindStatementText(stmt, 5, output.GetScriptPubKey());
 
             TryStepStatement(stmt);
         }
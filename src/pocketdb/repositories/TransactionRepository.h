@@ -5,6 +5,7 @@
 #ifndef POCKETDB_TRANSACTIONREPOSITORY_H
 #define POCKETDB_TRANSACTIONREPOSITORY_H
 
+#include <functional>
 #include <boost/algorithm/string/join.hpp>
 #include <boost/range/adaptor/transformed.hpp>
 
@@ -37,7 +38,11 @@ namespace PocketDb
 
         //  Base transaction operations
         void InsertTransactions(PocketBlock& pocketBlock);
+        // Transactions of chain ordered by height and position in block, not yet indexed ones follow in order of txHashes
         PocketBlockRef List(const vector<string>& txHashes, bool includePayload = false, bool includeInputs = false, bool includeOutputs = false);
+        // Every transaction is passed to callback as soon as it is read without collecting whole list, ordered by hash
+        void ListStream(const vector<string>& txHashes, const function<void(const PTransactionRef&)>& callback,
+            bool includePayload = false, bool includeInputs = false, bool includeOutputs = false);
         PTransactionRef Get(const string& hash, bool includePayload = false, bool includeInputs = false, bool includeOutputs = false);
         PTransactionOutputRef GetTxOutput(const string& txHash, int number);
 
@@ -55,6 +60,9 @@ namespace PocketDb
         void InsertTransactionPayload(const PTransactionRef& ptx);
         void InsertTransactionModel(const PTransactionRef& ptx);
 
+        void ListRows(const string& func, const vector<string>& txHashes, bool includePayload, bool includeInputs,
+            bool includeOutputs, bool groupByTx, const function<bool(sqlite3_stmt*)>& feedRow);
+
     protected:
         tuple<bool, PTransactionRef> CreateTransactionFromListRow(
             const shared_ptr<sqlite3_stmt*>& stmt, bool includedPayload);
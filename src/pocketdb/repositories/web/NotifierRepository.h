@@ -6,9 +6,38 @@
 #define POCKETNET_CORE_NOTIFIERREPOSITORY_H
 
 #include "pocketdb/repositories/BaseRepository.h"
+#include "pocketdb/models/base/PocketTypes.h"
+
+#include <unordered_map>
 
 namespace PocketDb
 {
+    using namespace PocketTx;
+
+    // Everything websocket notifier needs for one block.
+    // Per-transaction entries are keyed by transaction hash and hold the same fields
+    // as single-transaction lookups did before, missing entry means nothing to notify.
+    struct NotifierBlockData
+    {
+        unordered_map<string, TxType> Types;
+
+        // hash, rootHash, lang
+        unordered_map<string, UniValue> Contents;
+        unordered_map<string, UniValue> Reposts;
+        unordered_map<string, UniValue> Boosts;
+        unordered_map<string, UniValue> Referrers;
+        unordered_map<string, UniValue> ContentScores;
+        unordered_map<string, UniValue> Subscribes;
+        unordered_map<string, UniValue> CommentScores;
+        unordered_map<string, UniValue> Comments;
+
+        // Address receiving content outputs -> array of its private subscribers
+        unordered_map<string, UniValue> PrivateSubscribers;
+
+        // Subscriber address -> number of contents from its subscriptions at block height
+        unordered_map<string, int> SubscribesContentsCount;
+    };
+
     class NotifierRepository : public BaseRepository
     {
     public:
@@ -18,18 +47,15 @@ namespace PocketDb
         void Destroy() override;
 
         UniValue GetAccountInfoByAddress(const string& address);
-        UniValue GetPostLang(const string& postHash);
-        UniValue GetPostInfo(const string& postHash);
-        UniValue GetBoostInfo(const string& boostHash);
-        UniValue GetOriginalPostAddressByRepost(const string& repostHash);
-        UniValue GetPrivateSubscribeAddressesByAddressTo(const string& addressTo);
-        UniValue GetUserReferrerAddress(const string& userHash);
-        UniValue GetPostInfoAddressByScore(const string& postScoreHash);
-        UniValue GetSubscribeAddressTo(const string& subscribeHash);
-        UniValue GetCommentInfoAddressByScore(const string& commentScoreHash);
-        UniValue GetFullCommentInfo(const string& commentHash);
-        UniValue GetPostCountFromMySubscribes(const string& address, int height);
+
+        // Fixed number of queries independent of number of transactions in block
+        NotifierBlockData GetBlockData(const string& blockHash, int height);
+
+    private:
+        void SelectBlockRows(const string& sql, const string& blockHash, const function<void(sqlite3_stmt*)>& row);
     };
+
+    typedef shared_ptr<NotifierRepository> NotifierRepositoryRef;
 }
 
 #endif //POCKETNET_CORE_NOTIFIERREPOSITORY_H
@@ -3,6 +3,7 @@
 // https://www.apache.org/licenses/LICENSE-2.0
 
 #include "pocketdb/repositories/web/WebRpcRepository.h"
+#include "pocketdb/repositories/ChainRepository.h"
 
 namespace PocketDb
 {
@@ -201,8 +202,7 @@ namespace PocketDb
                 ifnull((select b.Value from Balances b indexed by Balances_AddressHash_Last
                     where b.AddressHash=u.String1 and b.Last=1),0) as Balance,
 
-                (select count(1) from Ratings r indexed by Ratings_Type_Id_Last_Height
-                    where r.Type=1 and r.Id=u.Id) as Likers,
+                ifnull((select st.Likers from AccountStats st where st.Address=u.String1),0) as Likers,
 
                 (select count(1) from Transactions p indexed by Transactions_Type_String1_Height_Time_Int1
                     where p.Type in (200) and p.Hash=p.String2 and p.String1=u.String1 and (p.Height>=? or p.Height isnull)) as PostSpent,
@@ -269,6 +269,234 @@ namespace PocketDb
         return result;
     }
 
+    UniValue WebRpcRepository::VerifyAccountStats(const vector<string>& addresses, int limit)
+    {
+        static const vector<string> fields = { "posts", "subscribes", "subscribers", "blockings", "likers", "referrals" };
+
+        UniValue result(UniValue::VOBJ);
+        UniValue mismatches(UniValue::VARR);
+        int64_t checked = 0;
+        int64_t failed = 0;
+
+        string addressesWhere;
+        if (!addresses.empty())
+            addressesWhere = join(vector<string>(addresses.size(), "?"), ",");
+
+        string sql = R"sql(
+            with calc as (
+        )sql" + ChainRepository::AccountStatsSql(addresses.empty() ? "" : " and u.String1 in (" + addressesWhere + ") ") + R"sql(
+            )
+            select
+                c.Address, c.Posts, c.Subscribes, c.Subscribers, c.Blockings, c.Likers, c.Referrals,
+                st.Address, st.Posts, st.Subscribes, st.Subscribers, st.Blockings, st.Likers, st.Referrals
+            from calc c
+            left join AccountStats st on st.Address = c.Address
+        )sql";
+
+        // Counters left for accounts not existing anymore
+        string orphansSql = R"sql(
+            select st.Address
+            from AccountStats st
+            where not exists (
+                select 1
+                from Transactions u indexed by Transactions_Type_Last_String1_Height_Id
+                where u.Type in (100,101,102) and u.Last = 1 and u.Height is not null and u.String1 = st.Address
+            )
+        )sql" + (addresses.empty() ? "" : " and st.Address in (" + addressesWhere + ")");
+
+        TryTransactionStep(__func__, [&]()
+        {
+            auto stmt = SetupSqlStatement(sql);
+
+            int i = 1;
+            for (const auto& address : addresses)
+                TryBindStatementText(stmt, i++, address);
+
+            while (sqlite3_step(*stmt) == SQLITE_ROW)
+            {
+                checked += 1;
+
+                auto[okAddress, address] = TryGetColumnString(*stmt, 0);
+                auto[okStored, storedAddress] = TryGetColumnString(*stmt, 7);
+
+                UniValue record(UniValue::VOBJ);
+                bool mismatch = !okStored;
+
+                if (!okStored)
+                    record.pushKV("missing", true);
+
+                for (int f = 0; f < (int) fields.size(); f++)
+                {
+                    auto[okActual, actual] = TryGetColumnInt64(*stmt, 1 + f);
+                    auto[okTable, table] = TryGetColumnInt64(*stmt, 8 + f);
+
+                    if (okStored && actual == table)
+                        continue;
+
+                    UniValue diff(UniValue::VOBJ);
+                    diff.pushKV("table", table);
+                    diff.pushKV("actual", actual);
+                    record.pushKV(fields[f], diff);
+                    mismatch = true;
+                }
+
+                if (!mismatch)
+                    continue;
+
+                failed += 1;
+                if ((int) mismatches.size() < limit)
+                {
+                    record.pushKV("address", address);
+                    mismatches.push_back(record);
+                }
+            }
+
+            FinalizeSqlStatement(*stmt);
+
+            auto stmtOrphans = SetupSqlStatement(orphansSql);
+
+            i = 1;
+            for (const auto& address : addresses)
+                TryBindStatementText(stmtOrphans, i++, address);
+
+            while (sqlite3_step(*stmtOrphans) == SQLITE_ROW)
+            {
+                failed += 1;
+                if ((int) mismatches.size() < limit)
+                {
+                    UniValue record(UniValue::VOBJ);
+                    if (auto[ok, value] = TryGetColumnString(*stmtOrphans, 0); ok) record.pushKV("address", value);
+                    record.pushKV("orphan", true);
+                    mismatches.push_back(record);
+                }
+            }
+
+            FinalizeSqlStatement(*stmtOrphans);
+        });
+
+        result.pushKV("checked", checked);
+        result.pushKV("failed", failed);
+        result.pushKV("mismatches", mismatches);
+        return result;
+    }
+
+    UniValue WebRpcRepository::VerifyContentStats(const vector<string>& txHashes, int limit)
+    {
+        static const vector<string> fields = { "scoresCount", "scoresSum", "reposted", "comments" };
+
+        UniValue result(UniValue::VOBJ);
+        UniValue mismatches(UniValue::VARR);
+        int64_t checked = 0;
+        int64_t failed = 0;
+
+        string hashesWhere;
+        if (!txHashes.empty())
+            hashesWhere = join(vector<string>(txHashes.size(), "?"), ",");
+
+        string sql = R"sql(
+            with calc as (
+        )sql" + ChainRepository::ContentStatsSql(txHashes.empty() ? "" : " and c.String2 in (" + hashesWhere + ") ") + R"sql(
+            )
+            select
+                c.ContentId, c.ScoresCount, c.ScoresSum, c.Reposted, c.Comments,
+                st.ContentId, st.ScoresCount, st.ScoresSum, st.Reposted, st.Comments,
+                (select t.String2 from Transactions t indexed by Transactions_Last_Id_Height where t.Last = 1 and t.Id = c.ContentId)
+            from calc c
+            left join ContentStats st on st.ContentId = c.ContentId
+        )sql";
+
+        // Counters left for contents not existing anymore
+        string orphansSql = R"sql(
+            select st.ContentId
+            from ContentStats st
+            where not exists (
+                select 1
+                from Transactions c indexed by Transactions_Last_Id_Height
+                where c.Last = 1 and c.Id = st.ContentId and c.Type in (200,201,202,207) and c.Height is not null
+            )
+        )sql" + (txHashes.empty() ? "" : R"sql(
+              and st.ContentId in (
+                select t.Id from Transactions t indexed by Transactions_Hash_Height where t.Hash in ()sql" + hashesWhere + R"sql()
+              )
+        )sql");
+
+        TryTransactionStep(__func__, [&]()
+        {
+            auto stmt = SetupSqlStatement(sql);
+
+            int i = 1;
+            for (const auto& txHash : txHashes)
+                TryBindStatementText(stmt, i++, txHash);
+
+            while (sqlite3_step(*stmt) == SQLITE_ROW)
+            {
+                checked += 1;
+
+                auto[okId, id] = TryGetColumnInt64(*stmt, 0);
+                auto[okStored, storedId] = TryGetColumnInt64(*stmt, 5);
+
+                UniValue record(UniValue::VOBJ);
+                bool mismatch = !okStored;
+
+                if (!okStored)
+                    record.pushKV("missing", true);
+
+                for (int f = 0; f < (int) fields.size(); f++)
+                {
+                    auto[okActual, actual] = TryGetColumnInt64(*stmt, 1 + f);
+                    auto[okTable, table] = TryGetColumnInt64(*stmt, 6 + f);
+
+                    if (okStored && actual == table)
+                        continue;
+
+                    UniValue diff(UniValue::VOBJ);
+                    diff.pushKV("table", table);
+                    diff.pushKV("actual", actual);
+                    record.pushKV(fields[f], diff);
+                    mismatch = true;
+                }
+
+                if (!mismatch)
+                    continue;
+
+                failed += 1;
+                if ((int) mismatches.size() < limit)
+                {
+                    record.pushKV("id", id);
+                    if (auto[ok, value] = TryGetColumnString(*stmt, 10); ok) record.pushKV("txid", value);
+                    mismatches.push_back(record);
+                }
+            }
+
+            FinalizeSqlStatement(*stmt);
+
+            auto stmtOrphans = SetupSqlStatement(orphansSql);
+
+            i = 1;
+            for (const auto& txHash : txHashes)
+                TryBindStatementText(stmtOrphans, i++, txHash);
+
+            while (sqlite3_step(*stmtOrphans) == SQLITE_ROW)
+            {
+                failed += 1;
+                if ((int) mismatches.size() < limit)
+                {
+                    UniValue record(UniValue::VOBJ);
+                    if (auto[ok, value] = TryGetColumnInt64(*stmtOrphans, 0); ok) record.pushKV("id", value);
+                    record.pushKV("orphan", true);
+                    mismatches.push_back(record);
+                }
+            }
+
+            FinalizeSqlStatement(*stmtOrphans);
+        });
+
+        result.pushKV("checked", checked);
+        result.pushKV("failed", failed);
+        result.pushKV("mismatches", mismatches);
+        return result;
+    }
+
     UniValue WebRpcRepository::GetAccountSetting(const string& address)
     {
         string result;
@@ -402,20 +630,7 @@ namespace PocketDb
                     where blck.Type in (305) and blck.Height is not null and blck.Last = 1 and blck.String1 = u.String1
                 ) as Blockings
 
-                , ifnull((
-                  select count(1)
-                  from Transactions ru indexed by Transactions_Type_Last_String2_Height
-                  where ru.Type in (100)
-                    and ru.Last in (0,1)
-                    and ru.Height > 0
-                    and ru.String2 = u.String1
-                    and ru.ROWID = (
-                      select min(ru1.ROWID)
-                      from Transactions ru1 indexed by Transactions_Id
-                      where ru1.Id = ru.Id
-                      limit 1
-                    )
-                ),0) as ReferralsCount
+                , ifnull(st.Referrals, 0) as ReferralsCount
 
             )sql";
         }
@@ -429,11 +644,7 @@ namespace PocketDb
                 , p.String7 as Donations
                 , ifnull(u.String2,'') as Referrer
 
-                , ifnull((
-                    select count(1)
-                    from Transactions po indexed by Transactions_Type_Last_String1_Height_Id
-                    where po.Type in (200,201,202) and po.Last=1 and po.Height is not null and po.String1=u.String1)
-                ,0) as PostsCount
+                , ifnull(st.Posts, 0) as PostsCount
 
                 , ifnull((
                     select r.Value
@@ -441,29 +652,10 @@ namespace PocketDb
                     where r.Type=0 and r.Id=u.Id and r.Last=1)
                 ,0) as Reputation
 
-                , (
-                    select count(*)
-                    from Transactions subs indexed by Transactions_Type_Last_String1_Height_Id
-                    where subs.Type in (302,303) and subs.Height is not null and subs.Last = 1 and subs.String1 = u.String1
-                ) as SubscribesCount
-
-                , (
-                    select count(*)
-                    from Transactions subs indexed by Transactions_Type_Last_String2_Height
-                    where subs.Type in (302,303) and subs.Height is not null and subs.Last = 1 and subs.String2 = u.String1
-                ) as SubscribersCount
-
-                , (
-                    select count(*)
-                    from Transactions subs indexed by Transactions_Type_Last_String1_Height_Id
-                    where subs.Type in (305) and subs.Height is not null and subs.Last = 1 and subs.String1 = u.String1
-                ) as BlockingsCount
-
-                , (
-                    select count(*)
-                    from Ratings lkr indexed by Ratings_Type_Id_Last_Height
-                    where lkr.Type = 1 and lkr.Id = u.Id
-                ) as Likers
+                , ifnull(st.Subscribes, 0) as SubscribesCount
+                , ifnull(st.Subscribers, 0) as SubscribersCount
+                , ifnull(st.Blockings, 0) as BlockingsCount
+                , ifnull(st.Likers, 0) as Likers
 
                 , p.String6 as Pubkey
                 , p.String4 as About
@@ -481,6 +673,7 @@ namespace PocketDb
 
             from Transactions u indexed by Transactions_Type_Last_String1_Height_Id
             cross join Payload p on p.TxHash=u.Hash
+            left join AccountStats st on st.Address=u.String1
 
             where u.Type in (100,101,102)
               and u.Last=1
@@ -2374,9 +2567,23 @@ namespace PocketDb
     UniValue WebRpcRepository::GetHotPosts(int countOut, const int depth, const int nHeight, const string& lang,
         const vector<int>& contentTypes, const string& address, int badReputationLimit)
     {
-        auto func = __func__;
         UniValue result(UniValue::VARR);
 
+        auto ids = GetHotPostIds(countOut, depth, nHeight, lang, contentTypes, badReputationLimit);
+        if (ids.empty())
+            return result;
+
+        auto contents = GetContentsData(ids, address);
+        result.push_backV(contents);
+
+        return result;
+    }
+
+    vector<int64_t> WebRpcRepository::GetHotPostIds(int countOut, const int depth, const int nHeight, const string& lang,
+        const vector<int>& contentTypes, int badReputationLimit)
+    {
+        auto func = __func__;
+
         string sql = R"sql(
             select t.Id
 
@@ -2431,13 +2638,7 @@ namespace PocketDb
             FinalizeSqlStatement(*stmt);
         });
 
-        if (ids.empty())
-            return result;
-
-        auto contents = GetContentsData(ids, address);
-        result.push_backV(contents);
-
-        return result;
+        return ids;
     }
 
     vector<UniValue> WebRpcRepository::GetContentsData(const vector<int64_t>& ids, const string& address)
@@ -2465,39 +2666,17 @@ namespace PocketDb
                 p.String5 as Images,
                 p.String6 as Settings,
 
-                (select count() from Transactions scr indexed by Transactions_Type_Last_String2_Height
-                    where scr.Type = 300 and scr.Last in (0,1) and scr.Height is not null and scr.String2 = t.String2) as ScoresCount,
-
-                ifnull((select sum(scr.Int1) from Transactions scr indexed by Transactions_Type_Last_String2_Height
-                    where scr.Type = 300 and scr.Last in (0,1) and scr.Height is not null and scr.String2 = t.String2),0) as ScoresSum,
-
-                (select count() from Transactions rep indexed by Transactions_Type_Last_String3_Height
-                    where rep.Type in (200,201,202) and rep.Last = 1 and rep.Height is not null and rep.String3 = t.String2) as Reposted,
+                ifnull(cs.ScoresCount,0) as ScoresCount,
+                ifnull(cs.ScoresSum,0) as ScoresSum,
+                ifnull(cs.Reposted,0) as Reposted,
+                ifnull(cs.Comments,0) as CommentsCount,
 
-                (
-                    select count()
-                    from Transactions s indexed by Transactions_Type_Last_String3_Height
-                    where s.Type in (204, 205)
-                      and s.Height is not null
-                      and s.String3 = t.String2
-                      and s.Last = 1
-                      -- exclude commenters blocked by the author of the post
-                      and not exists (
-                        select 1
-                        from Transactions b indexed by Transactions_Type_Last_String1_Height_Id
-                        where b.Type in (305)
-                            and b.Last = 1
-                            and b.Height > 0
-                            and b.String1 = t.String1
-                            and b.String2 = s.String1
-                      )
-                ) AS CommentsCount,
-                
                 ifnull((select scr.Int1 from Transactions scr indexed by Transactions_Type_Last_String1_String2_Height
                     where scr.Type = 300 and scr.Last in (0,1) and scr.Height is not null and scr.String1 = ? and scr.String2 = t.String2),0) as MyScore
 
             from Transactions t indexed by Transactions_Last_Id_Height
             left join Payload p on t.Hash = p.TxHash
+            left join ContentStats cs on cs.ContentId = t.Id
             where t.Height is not null
               and t.Last = 1
               and t.Id in ( )sql" + join(vector<string>(ids.size(), "?"), ",") + R"sql( )
@@ -3037,23 +3216,15 @@ namespace PocketDb
         return result;
     }
 
-    UniValue WebRpcRepository::GetHierarchicalFeed(int countOut, const int64_t& topContentId, int topHeight,
-        const string& lang, const vector<string>& tags, const vector<int>& contentTypes,
-        const vector<string>& txidsExcluded, const vector<string>& adrsExcluded, const vector<string>& tagsExcluded,
-        const string& address, int badReputationLimit)
+    string WebRpcRepository::HierarchicalFeedSql(const string& lang, const vector<int>& contentTypes)
     {
-        auto func = __func__;
-        UniValue result(UniValue::VARR);
-
-        // ---------------------------------------------
-
         string contentTypesFilter = join(vector<string>(contentTypes.size(), "?"), ",");
 
         string langFilter;
         if (!lang.empty())
             langFilter += " join Payload p indexed by Payload_String1_TxHash on p.TxHash = t.Hash and p.String1 = ? ";
 
-        string sql = R"sql(
+        return R"sql(
             select
                 (t.Id)ContentId,
                 ifnull(pr.Value,0)ContentRating,
@@ -3075,7 +3246,10 @@ namespace PocketDb
                     )q
                     left join Ratings pr indexed by Ratings_Type_Id_Last_Height
                         on pr.Type = 2 and pr.Id = q.Id and pr.Last = 1
-                ), 0)SumRating
+                ), 0)SumRating,
+
+                t.String2,
+                t.String1
 
             from Transactions t indexed by Transactions_Type_Last_String3_Height
 
@@ -3101,6 +3275,135 @@ namespace PocketDb
                 -- Do not show posts from users with low reputation
                 and ifnull(ur.Value,0) > ?
         )sql";
+    }
+
+    int WebRpcRepository::BindHierarchicalFeed(shared_ptr<sqlite3_stmt*>& stmt, int topHeight, const string& lang,
+        const vector<int>& contentTypes, int badReputationLimit)
+    {
+        int i = 1;
+
+        for (const auto& contenttype: contentTypes)
+            TryBindStatementInt(stmt, i++, contenttype);
+
+        TryBindStatementInt(stmt, i++, durationBlocksForPrevPosts);
+
+        TryBindStatementInt(stmt, i++, cntPrevPosts);
+        
+        if (!lang.empty()) TryBindStatementText(stmt, i++, lang);
+
+        for (const auto& contenttype: contentTypes)
+            TryBindStatementInt(stmt, i++, contenttype);
+
+        TryBindStatementInt(stmt, i++, topHeight);
+        TryBindStatementInt(stmt, i++, topHeight - cntBlocksForResult);
+
+        TryBindStatementInt(stmt, i++, badReputationLimit);
+
+        return i;
+    }
+
+    HierarchicalCandidate WebRpcRepository::ReadHierarchicalCandidate(sqlite3_stmt* stmt, int topHeight,
+        const vector<int>& contentTypes)
+    {
+        const auto& decay = (contentTypes.size() == 1 && contentTypes[0] == CONTENT_VIDEO) ? decayVideo : decayContent;
+
+        HierarchicalCandidate candidate{};
+
+        auto[ok0, contentId] = TryGetColumnInt64(stmt, 0);
+        auto[ok1, contentRating] = TryGetColumnInt(stmt, 1);
+        auto[ok2, accountRating] = TryGetColumnInt(stmt, 2);
+        auto[ok3, contentOrigHeight] = TryGetColumnInt(stmt, 3);
+        auto[ok4, contentScores] = TryGetColumnInt(stmt, 4);
+
+        auto& record = candidate.Record;
+        record.Id = contentId;
+        record.LAST5 = 1.0 * contentScores;
+        record.UREP = accountRating;
+        record.PREP = contentRating;
+        record.DREP = decayRep(topHeight - contentOrigHeight);
+        record.DPOST = decay(topHeight - contentOrigHeight);
+
+        if (auto[ok, value] = TryGetColumnString(stmt, 5); ok) candidate.RootTxHash = value;
+        if (auto[ok, value] = TryGetColumnString(stmt, 6); ok) candidate.Address = value;
+
+        return candidate;
+    }
+
+    vector<HierarchicalCandidate> WebRpcRepository::GetHierarchicalCandidates(int topHeight, const string& lang,
+        const vector<int>& contentTypes, int badReputationLimit)
+    {
+        auto func = __func__;
+        vector<HierarchicalCandidate> result;
+
+        string sql = HierarchicalFeedSql(lang, contentTypes);
+
+        TryTransactionStep(func, [&]()
+        {
+            auto stmt = SetupSqlStatement(sql);
+            BindHierarchicalFeed(stmt, topHeight, lang, contentTypes, badReputationLimit);
+
+            while (sqlite3_step(*stmt) == SQLITE_ROW)
+                result.push_back(ReadHierarchicalCandidate(*stmt, topHeight, contentTypes));
+
+            FinalizeSqlStatement(*stmt);
+        });
+
+        return result;
+    }
+
+    unordered_set<int64_t> WebRpcRepository::GetTaggedContentIds(const vector<string>& tags, const string& lang,
+        int64_t minContentId)
+    {
+        auto func = __func__;
+        unordered_set<int64_t> result;
+
+        if (tags.empty())
+            return result;
+
+        string sql = R"sql(
+            select tm.ContentId
+            from web.Tags tag indexed by Tags_Lang_Value_Id
+            join web.TagsMap tm indexed by TagsMap_TagId_ContentId
+                on tag.Id = tm.TagId and tm.ContentId >= ?
+            where tag.Value in ( )sql" + join(vector<string>(tags.size(), "?"), ",") + R"sql( )
+                )sql" + (!lang.empty() ? " and tag.Lang = ? " : "") + R"sql(
+        )sql";
+
+        TryTransactionStep(func, [&]()
+        {
+            auto stmt = SetupSqlStatement(sql);
+
+            int i = 1;
+            TryBindStatementInt64(stmt, i++, minContentId);
+
+            for (const auto& tag: tags)
+                TryBindStatementText(stmt, i++, tag);
+
+            if (!lang.empty())
+                TryBindStatementText(stmt, i++, lang);
+
+            while (sqlite3_step(*stmt) == SQLITE_ROW)
+            {
+                if (auto[ok, value] = TryGetColumnInt64(*stmt, 0); ok)
+                    result.insert(value);
+            }
+
+            FinalizeSqlStatement(*stmt);
+        });
+
+        return result;
+    }
+
+    UniValue WebRpcRepository::GetHierarchicalFeed(int countOut, const int64_t& topContentId, int topHeight,
+        const string& lang, const vector<string>& tags, const vector<int>& contentTypes,
+        const vector<string>& txidsExcluded, const vector<string>& adrsExcluded, const vector<string>& tagsExcluded,
+        const string& address, int badReputationLimit)
+    {
+        auto func = __func__;
+
+        // ---------------------------------------------
+
+        string sql = HierarchicalFeedSql(lang, contentTypes);
 
         if (!tags.empty())
         {
@@ -3130,29 +3433,11 @@ namespace PocketDb
 
         // ---------------------------------------------
         vector<HierarchicalRecord> postsRanks;
-        double dekay = (contentTypes.size() == 1 && contentTypes[0] == CONTENT_VIDEO) ? dekayVideo : dekayContent;
 
         TryTransactionStep(func, [&]()
         {
             auto stmt = SetupSqlStatement(sql);
-            int i = 1;
-
-            for (const auto& contenttype: contentTypes)
-                TryBindStatementInt(stmt, i++, contenttype);
-
-            TryBindStatementInt(stmt, i++, durationBlocksForPrevPosts);
-
-            TryBindStatementInt(stmt, i++, cntPrevPosts);
-            
-            if (!lang.empty()) TryBindStatementText(stmt, i++, lang);
-
-            for (const auto& contenttype: contentTypes)
-                TryBindStatementInt(stmt, i++, contenttype);
-
-            TryBindStatementInt(stmt, i++, topHeight);
-            TryBindStatementInt(stmt, i++, topHeight - cntBlocksForResult);
-
-            TryBindStatementInt(stmt, i++, badReputationLimit);
+            int i = BindHierarchicalFeed(stmt, topHeight, lang, contentTypes, badReputationLimit);
             
             if (!tags.empty())
             {
@@ -3183,88 +3468,59 @@ namespace PocketDb
             // ---------------------------------------------
             
             while (sqlite3_step(*stmt) == SQLITE_ROW)
-            {
-                HierarchicalRecord record{};
-
-                auto[ok0, contentId] = TryGetColumnInt64(*stmt, 0);
-                auto[ok1, contentRating] = TryGetColumnInt(*stmt, 1);
-                auto[ok2, accountRating] = TryGetColumnInt(*stmt, 2);
-                auto[ok3, contentOrigHeight] = TryGetColumnInt(*stmt, 3);
-                auto[ok4, contentScores] = TryGetColumnInt(*stmt, 4);
-
-                record.Id = contentId;
-                record.LAST5 = 1.0 * contentScores;
-                record.UREP = accountRating;
-                record.PREP = contentRating;
-                record.DREP = pow(dekayRep, (topHeight - contentOrigHeight));
-                record.DPOST = pow(dekay, (topHeight - contentOrigHeight));
-
-                postsRanks.push_back(record);
-            }
+                postsRanks.push_back(ReadHierarchicalCandidate(*stmt, topHeight, contentTypes).Record);
 
             FinalizeSqlStatement(*stmt);
         });
 
-        // ---------------------------------------------
-        // Calculate content ratings
-        int nElements = postsRanks.size();
-        for (auto& iPostRank : postsRanks)
-        {
-            double _LAST5R = 0;
-            double _UREPR = 0;
-            double _PREPR = 0;
+        return CompleteHierarchicalFeed(postsRanks, countOut, topContentId, topHeight, lang, tags, contentTypes,
+            txidsExcluded, adrsExcluded, tagsExcluded, address, badReputationLimit);
+    }
 
-            double boost = 0;
-            if (nElements > 1)
-            {
-                for (auto jPostRank : postsRanks)
-                {
-                    if (iPostRank.LAST5 > jPostRank.LAST5)
-                        _LAST5R += 1;
-                    if (iPostRank.UREP > jPostRank.UREP)
-                        _UREPR += 1;
-                    if (iPostRank.PREP > jPostRank.PREP)
-                        _PREPR += 1;
-                }
+    UniValue WebRpcRepository::GetHierarchicalFeed(const vector<HierarchicalCandidate>& candidates, int countOut,
+        const int64_t& topContentId, int topHeight, const string& lang, const vector<string>& tags,
+        const vector<int>& contentTypes, const vector<string>& txidsExcluded, const vector<string>& adrsExcluded,
+        const vector<string>& tagsExcluded, const string& address, int badReputationLimit)
+    {
+        HierarchicalFilter filter;
+        filter.FilterTags = !tags.empty();
+        filter.TxIdsExcluded.insert(txidsExcluded.begin(), txidsExcluded.end());
+        filter.AddressesExcluded.insert(adrsExcluded.begin(), adrsExcluded.end());
 
-                iPostRank.LAST5R = 1.0 * (_LAST5R * 100) / (nElements - 1);
-                iPostRank.UREPR = min(iPostRank.UREP, 1.0 * (_UREPR * 100) / (nElements - 1)) * (iPostRank.UREP < 0 ? 2.0 : 1.0);
-                iPostRank.PREPR = min(iPostRank.PREP, 1.0 * (_PREPR * 100) / (nElements - 1)) * (iPostRank.PREP < 0 ? 2.0 : 1.0);
-            }
-            else
-            {
-                iPostRank.LAST5R = 100;
-                iPostRank.UREPR = 100;
-                iPostRank.PREPR = 100;
-            }
+        // Tags are read at request time - only contents inside candidates range are needed
+        if (!candidates.empty() && (!tags.empty() || !tagsExcluded.empty()))
+        {
+            int64_t minContentId = min_element(candidates.begin(), candidates.end(),
+                [](const HierarchicalCandidate& a, const HierarchicalCandidate& b) { return a.Record.Id < b.Record.Id; }
+            )->Record.Id;
 
-            iPostRank.POSTRF = 0.4 * (0.75 * (iPostRank.LAST5R + boost) + 0.25 * iPostRank.UREPR) * iPostRank.DREP + 0.6 * iPostRank.PREPR * iPostRank.DPOST;
+            filter.TaggedIds = GetTaggedContentIds(tags, lang, minContentId);
+            filter.ExcludedTaggedIds = GetTaggedContentIds(tagsExcluded, lang, minContentId);
         }
 
-        // Sort results
-        sort(postsRanks.begin(), postsRanks.end(), greater<HierarchicalRecord>());
+        auto postsRanks = FilterHierarchicalCandidates(candidates, filter);
 
-        // Build result list
-        bool found = false;
-        int64_t minPostRank = topContentId;
-        vector<int64_t> resultIds;
-        for(auto iter = postsRanks.begin(); iter < postsRanks.end() && (int)resultIds.size() < countOut; iter++)
-        {
-            if (iter->Id < minPostRank || minPostRank == 0)
-                minPostRank = iter->Id;
+        return CompleteHierarchicalFeed(postsRanks, countOut, topContentId, topHeight, lang, tags, contentTypes,
+            txidsExcluded, adrsExcluded, tagsExcluded, address, badReputationLimit);
+    }
 
-            // Find start position
-            if (!found && topContentId > 0)
-            {
-                if (iter->Id == topContentId)
-                    found = true;
+    UniValue WebRpcRepository::CompleteHierarchicalFeed(vector<HierarchicalRecord>& postsRanks, int countOut,
+        const int64_t& topContentId, int topHeight, const string& lang, const vector<string>& tags,
+        const vector<int>& contentTypes, const vector<string>& txidsExcluded, const vector<string>& adrsExcluded,
+        const vector<string>& tagsExcluded, const string& address, int badReputationLimit)
+    {
+        UniValue result(UniValue::VARR);
 
-                continue;
-            }
+        // ---------------------------------------------
+        // Calculate content ratings
+        RankHierarchicalRecords(postsRanks);
 
-            // Save id for get data
-            resultIds.push_back(iter->Id);
-        }
+        // Sort results
+        sort(postsRanks.begin(), postsRanks.end(), greater<HierarchicalRecord>());
+
+        // Build result list
+        int64_t minPostRank;
+        vector<int64_t> resultIds = PageHierarchicalRecords(postsRanks, countOut, topContentId, minPostRank);
 
         // Get content data
         if (!resultIds.empty())
@@ -5,6 +5,7 @@
 #ifndef POCKETDB_WEB_RPC_REPOSITORY_H
 #define POCKETDB_WEB_RPC_REPOSITORY_H
 
+#include "pocketdb/helpers/FeedRanking.h"
 #include "pocketdb/helpers/PocketnetHelper.h"
 #include "pocketdb/helpers/TransactionHelper.h"
 #include "pocketdb/repositories/BaseRepository.h"
@@ -24,31 +25,6 @@ namespace PocketDb
     using namespace PocketTx;
     using namespace PocketHelpers;
 
-    struct HierarchicalRecord
-    {
-        int64_t Id;
-        double LAST5;
-        double LAST5R;
-        double BOOST;
-        double UREP;
-        double UREPR;
-        double DREP;
-        double PREP;
-        double PREPR;
-        double DPOST;
-        double POSTRF;
-
-        bool operator > (const HierarchicalRecord& b) const
-        {
-            return (POSTRF > b.POSTRF);
-        }
-
-        bool operator < (const HierarchicalRecord& b) const
-        {
-            return (POSTRF < b.POSTRF);
-        }
-    };
-
     class WebRpcRepository : public BaseRepository
     {
     public:
@@ -63,6 +39,11 @@ namespace PocketDb
         UniValue GetAddressesRegistrationDates(const vector<string>& addresses);
         UniValue GetTopAddresses(int count);
         UniValue GetAccountState(const string& address, int heightWindow);
+
+        // Compare AccountStats with counters calculated from scratch
+        UniValue VerifyAccountStats(const vector<string>& addresses, int limit);
+        // Compare ContentStats with counters calculated from scratch
+        UniValue VerifyContentStats(const vector<string>& txHashes, int limit);
         UniValue GetAccountSetting(const string& address);
 
         UniValue GetUserStatistic(const vector<string>& addresses, const int nHeight = 0, const int depth = 0);
@@ -109,6 +90,7 @@ namespace PocketDb
         vector<UniValue> GetContentsData(const vector<int64_t>& ids, const string& address);
         
         UniValue GetHotPosts(int countOut, const int depth, const int nHeight, const string& lang, const vector<int>& contentTypes, const string& address, int badReputationLimit);
+        vector<int64_t> GetHotPostIds(int countOut, const int depth, const int nHeight, const string& lang, const vector<int>& contentTypes, int badReputationLimit);
         
         UniValue GetProfileFeed(const string& addressFeed, int countOut, const int64_t& topContentId, int topHeight, const string& lang,
             const vector<string>& tags, const vector<int>& contentTypes, const vector<string>& txidsExcluded,
@@ -128,6 +110,17 @@ namespace PocketDb
             const vector<string>& adrsExcluded, const vector<string>& tagsExcluded, const string& address,
             int badReputationLimit);
 
+        // Hierarchical feed over candidates selected before by GetHierarchicalCandidates with same
+        // topHeight, lang, contentTypes and badReputationLimit - other filters are applied in memory
+        UniValue GetHierarchicalFeed(const vector<HierarchicalCandidate>& candidates, int countOut,
+            const int64_t& topContentId, int topHeight, const string& lang, const vector<string>& tags,
+            const vector<int>& contentTypes, const vector<string>& txidsExcluded, const vector<string>& adrsExcluded,
+            const vector<string>& tagsExcluded, const string& address, int badReputationLimit);
+
+        // Unranked records of hierarchical feed without tags and exclusion filters
+        vector<HierarchicalCandidate> GetHierarchicalCandidates(int topHeight, const string& lang,
+            const vector<int>& contentTypes, int badReputationLimit);
+
         UniValue GetBoostFeed(int topHeight, const string& lang,
             const vector<string>& tags, const vector<int>& contentTypes, const vector<string>& txidsExcluded,
             const vector<string>& adrsExcluded, const vector<string>& tagsExcluded,
@@ -149,7 +142,24 @@ namespace PocketDb
         double dekayVideo = 0.99;
         double dekayContent =  0.96;
 
+        // Decay of posts created inside result window
+        DecayTable decayRep{dekayRep, cntBlocksForResult + 1};
+        DecayTable decayVideo{dekayVideo, cntBlocksForResult + 1};
+        DecayTable decayContent{dekayContent, cntBlocksForResult + 1};
+
         vector<tuple<string, int64_t, UniValue>> GetAccountProfiles(const vector<string>& addresses, const vector<int64_t>& ids, bool shortForm);
+
+        string HierarchicalFeedSql(const string& lang, const vector<int>& contentTypes);
+        int BindHierarchicalFeed(shared_ptr<sqlite3_stmt*>& stmt, int topHeight, const string& lang,
+            const vector<int>& contentTypes, int badReputationLimit);
+        HierarchicalCandidate ReadHierarchicalCandidate(sqlite3_stmt* stmt, int topHeight, const vector<int>& contentTypes);
+        UniValue CompleteHierarchicalFeed(vector<HierarchicalRecord>& postsRanks, int countOut,
+            const int64_t& topContentId, int topHeight, const string& lang, const vector<string>& tags,
+            const vector<int>& contentTypes, const vector<string>& txidsExcluded, const vector<string>& adrsExcluded,
+            const vector<string>& tagsExcluded, const string& address, int badReputationLimit);
+
+        // Ids of contents not lower than minContentId with any of tags
+        unordered_set<int64_t> GetTaggedContentIds(const vector<string>& tags, const string& lang, int64_t minContentId);
     };
 
     typedef shared_ptr<WebRpcRepository> WebRpcRepositoryRef;
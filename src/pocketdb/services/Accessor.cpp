@@ -33,15 +33,18 @@ namespace PocketServices
     }
 
     // Read block data for send via network
-    bool Accessor::GetBlock(const CBlock& block, string& data)
+    bool Accessor::GetBlock(const CBlock& block, string& data, PayloadFormat format)
     {
+        auto blockHash = block.GetHash();
+        if (PocketServices::BlockPayloadCacheInst.Get(blockHash, format, data))
+            return true;
+
         PocketBlockRef pocketBlock;
         if (!GetBlock(block, pocketBlock))
             return false;
 
-        auto dataPtr = PocketServices::Serializer::SerializeBlock(*pocketBlock);
-        if (dataPtr)
-            data = dataPtr->write();
+        data = PocketServices::Serializer::SerializeBlockPayload(pocketBlock ? *pocketBlock : PocketBlock(), format);
+        PocketServices::BlockPayloadCacheInst.Put(blockHash, format, data);
 
         return true;
     }
@@ -53,7 +56,7 @@ namespace PocketServices
     }
 
     // Read transaction data for send via network
-    bool Accessor::GetTransaction(const CTransaction& tx, string& data)
+    bool Accessor::GetTransaction(const CTransaction& tx, string& data, PayloadFormat format)
     {
         if (!PocketHelpers::TransactionHelper::IsPocketSupportedTransaction(tx))
             return true;
@@ -62,10 +65,7 @@ namespace PocketServices
         if (!GetTransaction(tx, pocketTx) || !pocketTx)
             return false;
             
-        auto dataPtr = PocketServices::Serializer::SerializeTransaction(*pocketTx);
-        if (dataPtr)
-            data = dataPtr->write();
-
+        data = PocketServices::Serializer::SerializeTransactionPayload(*pocketTx, format);
         return true;
     }
 
@@ -27,9 +27,9 @@ namespace PocketServices
     {
     public:
         static bool GetBlock(const CBlock& block, PocketBlockRef& pocketBlock);
-        static bool GetBlock(const CBlock& block, string& data);
+        static bool GetBlock(const CBlock& block, string& data, PayloadFormat format = PayloadFormat::Json);
         static bool GetTransaction(const CTransaction& tx, PTransactionRef& pocketTx);
-        static bool GetTransaction(const CTransaction& tx, string& data);
+        static bool GetTransaction(const CTransaction& tx, string& data, PayloadFormat format = PayloadFormat::Json);
     };
 } // namespace PocketServices
 
@@ -0,0 +1,138 @@
+// Copyright (c) 2018-2022 The Pocketnet developers
+// Distributed under the Apache 2.0 software license, see the accompanying
+// https://www.apache.org/licenses/LICENSE-2.0
+
+#include "pocketdb/services/BlockPayloadCache.h"
+
+namespace PocketServices
+{
+    // Approximate memory used by entry besides payload data
+    static const size_t ENTRY_OVERHEAD = sizeof(uint256) + 128;
+
+    void BlockPayloadCache::SetMaxSize(size_t maxBytes)
+    {
+        LOCK(m_mutex);
+        m_maxBytes = maxBytes;
+        evict();
+    }
+
+    bool BlockPayloadCache::Get(const uint256& blockHash, PayloadFormat format, string& data)
+    {
+        LOCK(m_mutex);
+
+        if (auto it = m_index.find(blockHash); it != m_index.end())
+        {
+            if (auto dataIt = it->second->Data.find(format); dataIt != it->second->Data.end())
+            {
+                data = dataIt->second;
+                m_lru.splice(m_lru.begin(), m_lru, it->second);
+
+                m_hits += 1;
+                return true;
+            }
+        }
+
+        m_misses += 1;
+        return false;
+    }
+
+    void BlockPayloadCache::Put(const uint256& blockHash, PayloadFormat format, const string& data)
+    {
+        LOCK(m_mutex);
+
+        if (data.size() + ENTRY_OVERHEAD > m_maxBytes)
+            return;
+
+        auto it = m_index.find(blockHash);
+        if (it == m_index.end())
+        {
+            m_lru.push_front(Entry{blockHash, {}, ENTRY_OVERHEAD});
+            it = m_index.emplace(blockHash, m_lru.begin()).first;
+            m_bytes += ENTRY_OVERHEAD;
+        }
+        else
+        {
+            m_lru.splice(m_lru.begin(), m_lru, it->second);
+        }
+
+        auto& entry = *it->second;
+        if (auto dataIt = entry.Data.find(format); dataIt != entry.Data.end())
+        {
+            entry.Bytes -= dataIt->second.size();
+            m_bytes -= dataIt->second.size();
+        }
+
+        entry.Data[format] = data;
+        entry.Bytes += data.size();
+        m_bytes += data.size();
+
+        evict();
+    }
+
+    void BlockPayloadCache::Put(const uint256& blockHash, const PocketBlock& pocketBlock)
+    {
+        for (auto format : { PayloadFormat::Binary, PayloadFormat::Json })
+        {
+            // Skip formats already serialized for block announcement
+            {
+                LOCK(m_mutex);
+                if (m_maxBytes == 0)
+                    return;
+
+                if (auto it = m_index.find(blockHash); it != m_index.end() && it->second->Data.count(format))
+                    continue;
+            }
+
+            Put(blockHash, format, Serializer::SerializeBlockPayload(pocketBlock, format));
+        }
+    }
+
+    void BlockPayloadCache::Remove(const uint256& blockHash)
+    {
+        LOCK(m_mutex);
+
+        if (auto it = m_index.find(blockHash); it != m_index.end())
+        {
+            m_bytes -= it->second->Bytes;
+            m_lru.erase(it->second);
+            m_index.erase(it);
+        }
+    }
+
+    void BlockPayloadCache::Clear()
+    {
+        LOCK(m_mutex);
+        m_index.clear();
+        m_lru.clear();
+        m_bytes = 0;
+    }
+
+    BlockPayloadCacheStats BlockPayloadCache::GetStats()
+    {
+        LOCK(m_mutex);
+
+        BlockPayloadCacheStats stats;
+        stats.Hits = m_hits;
+        stats.Misses = m_misses;
+        stats.Evictions = m_evictions;
+        stats.Count = m_lru.size();
+        stats.Bytes = m_bytes;
+        stats.MaxBytes = m_maxBytes;
+
+        return stats;
+    }
+
+    // Drop least recently used entries until cache fits the limit
+    void BlockPayloadCache::evict()
+    {
+        while (m_bytes > m_maxBytes && !m_lru.empty())
+        {
+            auto& victim = m_lru.back();
+            m_bytes -= victim.Bytes;
+            m_index.erase(victim.Hash);
+            m_lru.pop_back();
+            m_evictions += 1;
+        }
+    }
+
+} // namespace PocketServices
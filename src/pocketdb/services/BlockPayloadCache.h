@@ -0,0 +1,77 @@
+// Copyright (c) 2018-2022 The Pocketnet developers
+// Distributed under the Apache 2.0 software license, see the accompanying
+// https://www.apache.org/licenses/LICENSE-2.0
+
+#ifndef POCKETSERVICES_BLOCKPAYLOADCACHE_H
+#define POCKETSERVICES_BLOCKPAYLOADCACHE_H
+
+#include "sync.h"
+#include "uint256.h"
+
+#include "pocketdb/services/Serializer.h"
+
+#include <list>
+#include <map>
+
+namespace PocketServices
+{
+    using namespace std;
+
+    static const int DEFAULT_BLOCK_PAYLOAD_CACHE = 32;
+
+    struct BlockPayloadCacheStats
+    {
+        int64_t Hits = 0;
+        int64_t Misses = 0;
+        int64_t Evictions = 0;
+        size_t Count = 0;
+        size_t Bytes = 0;
+        size_t MaxBytes = 0;
+    };
+
+    // Bounded LRU cache of serialized pocket payload for blocks sent to peers.
+    // Payload of block depends only on block content, so entries stay valid until the block
+    // is disconnected - then entry evicted to free memory.
+    class BlockPayloadCache
+    {
+    public:
+        // Zero size disables caching
+        void SetMaxSize(size_t maxBytes);
+
+        bool Get(const uint256& blockHash, PayloadFormat format, string& data);
+        void Put(const uint256& blockHash, PayloadFormat format, const string& data);
+
+        // Serialize payload for all formats and put to cache
+        void Put(const uint256& blockHash, const PocketBlock& pocketBlock);
+
+        void Remove(const uint256& blockHash);
+        void Clear();
+
+        BlockPayloadCacheStats GetStats();
+
+    private:
+        struct Entry
+        {
+            uint256 Hash;
+            map<PayloadFormat, string> Data;
+            size_t Bytes = 0;
+        };
+
+        Mutex m_mutex;
+        size_t m_maxBytes = 0;
+        size_t m_bytes = 0;
+
+        // Most recently used at front
+        list<Entry> m_lru;
+        map<uint256, list<Entry>::iterator> m_index;
+
+        int64_t m_hits = 0;
+        int64_t m_misses = 0;
+        int64_t m_evictions = 0;
+
+        void evict();
+    };
+
+} // namespace PocketServices
+
+#endif // POCKETSERVICES_BLOCKPAYLOADCACHE_H
@@ -11,9 +11,14 @@ namespace PocketServices
         vector<TransactionIndexingInfo> txs;
         PrepareTransactions(block, txs);
 
+        Index(block.GetHash().GetHex(), height, txs);
+    }
+
+    void ChainPostProcessing::Index(const string& blockHash, int height, vector<TransactionIndexingInfo>& txs)
+    {
         int64_t nTime1 = GetTimeMicros();
 
-        IndexChain(block.GetHash().GetHex(), height, txs);
+        IndexChain(blockHash, height, txs);
 
         int64_t nTime2 = GetTimeMicros();
         LogPrint(BCLog::BENCH, "    - IndexChain: %.2fms _ %d\n", 0.001 * (double)(nTime2 - nTime1), height);
@@ -22,6 +27,10 @@ namespace PocketServices
 
         int64_t nTime3 = GetTimeMicros();
         LogPrint(BCLog::BENCH, "    - IndexRatings: %.2fms _ %d\n", 0.001 * (double)(nTime3 - nTime2), height);
+
+        // Counters depend on likers saved with ratings
+        PocketDb::ChainRepoInst.IndexAccountStats(height);
+        PocketDb::ChainRepoInst.IndexContentStats(height);
     }
 
     bool ChainPostProcessing::Rollback(int height)
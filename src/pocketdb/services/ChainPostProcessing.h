@@ -28,9 +28,12 @@ namespace PocketServices
     {
     public:
         static void Index(const CBlock& block, int height);
+        // Index block already parsed with PrepareTransactions - e.g. on other thread
+        static void Index(const string& blockHash, int height, vector<TransactionIndexingInfo>& txs);
         static bool Rollback(int height);
-    protected:
+
         static void PrepareTransactions(const CBlock& block, vector<TransactionIndexingInfo>& txs);
+    protected:
         static void IndexChain(const string& blockHash, int height, vector<TransactionIndexingInfo>& txs);
         static void IndexRatings(int height, vector<TransactionIndexingInfo>& txs);
     private:
@@ -0,0 +1,167 @@
+// Copyright (c) 2018-2022 The Pocketnet developers
+// Distributed under the Apache 2.0 software license, see the accompanying
+// https://www.apache.org/licenses/LICENSE-2.0
+
+#include "pocketdb/services/ChainReindexer.h"
+
+#include <thread>
+
+#include "util.h"
+#include "utiltime.h"
+#include "pocketdb/pocketnet.h"
+#include "pocketdb/helpers/BlockArena.h"
+#include "pocketdb/services/ChainPostProcessing.h"
+
+namespace PocketServices
+{
+    ChainReindexer::ChainReindexer(BlockReader reader, int groupSize, int threads)
+        : m_reader(move(reader)), m_groupSize(max(1, groupSize)), m_threads(max(1, threads))
+    {
+    }
+
+    bool ChainReindexer::Run(int start, int stop, const function<bool()>& interrupted)
+    {
+        m_nextHeight = m_writeHeight = m_nextRead = start;
+        m_stop = stop;
+        m_cancel = false;
+        m_ready.clear();
+
+        // Readers stay at most two groups ahead of writer
+        vector<thread> readers;
+        for (int i = 0; i < m_threads; i++)
+            readers.emplace_back([this] { Reader(); });
+
+        int64_t startTime = GetTimeMicros();
+        int64_t logTime = startTime;
+        size_t txCount = 0;
+        int groupBlocks = 0;
+        bool done = false;
+
+        try
+        {
+            while (m_writeHeight <= stop && !interrupted())
+            {
+                PreparedBlock prepared;
+                {
+                    unique_lock<mutex> lock(m_mutex);
+                    m_readyCond.wait(lock, [&] { return m_ready.count(m_writeHeight) > 0; });
+
+                    auto it = m_ready.find(m_writeHeight);
+                    prepared = move(it->second);
+                    m_ready.erase(it);
+                }
+
+                if (!prepared.Ok)
+                    throw runtime_error(strprintf("failed read block at height %d", m_writeHeight));
+
+                if (groupBlocks == 0 && !SQLiteDbInst.BeginGroup())
+                    throw runtime_error("can't begin transaction group");
+
+                ChainPostProcessing::Index(prepared.BlockHash, m_writeHeight, prepared.Txs);
+                LogPrint(BCLog::SYNC, "Indexing pocketnet part at height %d\n", m_writeHeight);
+
+                txCount += prepared.Txs.size();
+                groupBlocks += 1;
+
+                {
+                    lock_guard<mutex> lock(m_mutex);
+                    m_writeHeight += 1;
+                }
+                m_spaceCond.notify_all();
+
+                if (groupBlocks < m_groupSize && m_writeHeight <= stop)
+                    continue;
+
+                Commit();
+                groupBlocks = 0;
+
+                int64_t time = GetTimeMicros();
+                if (time - logTime > 10 * 1000000 || m_writeHeight > stop)
+                {
+                    double seconds = 0.000001 * (double) max<int64_t>(1, time - startTime);
+                    auto arenaStats = PocketHelpers::GetBlockArenaStats();
+                    LogPrintf("Indexing pocketnet part: height %d of %d (%.2f%%), %.1f blocks/s, %.1f tx/s, "
+                              "peak RSS %.2fMiB, %u block arena allocations in %.2fMiB\n",
+                        m_writeHeight - 1, stop, 100.0 * (m_writeHeight - start) / max(1, stop - start + 1),
+                        (m_writeHeight - start) / seconds, txCount / seconds,
+                        PocketHelpers::GetPeakRss() / 1048576.0, arenaStats.Allocations, arenaStats.Bytes / 1048576.0);
+
+                    logTime = time;
+                }
+            }
+
+            // Keep blocks indexed before shutdown
+            if (groupBlocks > 0)
+                Commit();
+
+            done = m_writeHeight > stop;
+        }
+        catch (const std::exception& e)
+        {
+            SQLiteDbInst.AbortGroup();
+            LogPrintf("Failed index pocket part at height %d: %s\n", m_writeHeight, e.what());
+        }
+
+        {
+            lock_guard<mutex> lock(m_mutex);
+            m_cancel = true;
+        }
+        m_spaceCond.notify_all();
+
+        for (auto& reader : readers)
+            reader.join();
+
+        return done;
+    }
+
+    void ChainReindexer::Reader()
+    {
+        int window = 2 * m_groupSize;
+
+        while (true)
+        {
+            int height;
+            {
+                unique_lock<mutex> lock(m_mutex);
+                m_spaceCond.wait(lock, [&] { return m_cancel || m_nextRead > m_stop || m_nextRead < m_writeHeight + window; });
+
+                if (m_cancel || m_nextRead > m_stop)
+                    return;
+
+                height = m_nextRead++;
+            }
+
+            PreparedBlock prepared;
+            try
+            {
+                CBlock block;
+                if (m_reader(height, block))
+                {
+                    prepared.BlockHash = block.GetHash().GetHex();
+                    ChainPostProcessing::PrepareTransactions(block, prepared.Txs);
+                    prepared.Ok = true;
+                }
+            }
+            catch (const std::exception& e)
+            {
+                LogPrintf("Failed read block at height %d: %s\n", height, e.what());
+            }
+
+            {
+                lock_guard<mutex> lock(m_mutex);
+                m_ready.emplace(height, move(prepared));
+            }
+            m_readyCond.notify_all();
+        }
+    }
+
+    void ChainReindexer::Commit()
+    {
+        if (!SQLiteDbInst.CommitGroup())
+            throw runtime_error("can't commit transaction group");
+
+        m_nextHeight = m_writeHeight;
+        WalCheckpointerInst.Notify();
+    }
+
+} // namespace PocketServices
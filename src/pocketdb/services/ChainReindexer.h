@@ -0,0 +1,74 @@
+// Copyright (c) 2018-2022 The Pocketnet developers
+// Distributed under the Apache 2.0 software license, see the accompanying
+// https://www.apache.org/licenses/LICENSE-2.0
+
+#ifndef POCKETDB_CHAIN_REINDEXER_H
+#define POCKETDB_CHAIN_REINDEXER_H
+
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "primitives/block.h"
+#include "pocketdb/models/base/PocketTypes.h"
+
+namespace PocketServices
+{
+    using namespace std;
+    using namespace PocketTx;
+
+    static const int DEFAULT_REINDEX_GROUP = 100;
+    static const int DEFAULT_REINDEX_THREADS = 2;
+    static const int MAX_REINDEX_THREADS = 16;
+
+    // Pocket part of -reindex=3 as pipeline. Workers read blocks from disk and parse their
+    // transactions ahead, single writer indexes them in height order and commits every group
+    // of blocks in one SQLite transaction - one commit and sync per group instead of per block.
+    // Only whole groups are committed, so after failure or shutdown indexing resumes
+    // with -reindex-start=NextHeight().
+    class ChainReindexer
+    {
+    public:
+        // Read block of active chain at height, false if not found
+        using BlockReader = function<bool(int height, CBlock& block)>;
+
+        ChainReindexer(BlockReader reader, int groupSize, int threads);
+
+        // Index heights [start, stop], true if whole range is indexed
+        bool Run(int start, int stop, const function<bool()>& interrupted);
+
+        // First height not committed yet
+        int NextHeight() const { return m_nextHeight; }
+
+    private:
+        struct PreparedBlock
+        {
+            bool Ok = false;
+            string BlockHash;
+            vector<TransactionIndexingInfo> Txs;
+        };
+
+        BlockReader m_reader;
+        int m_groupSize;
+        int m_threads;
+        int m_nextHeight = 0;
+
+        mutex m_mutex;
+        condition_variable m_readyCond;
+        condition_variable m_spaceCond;
+        map<int, PreparedBlock> m_ready;
+        int m_nextRead = 0;
+        int m_writeHeight = 0;
+        int m_stop = 0;
+        bool m_cancel = false;
+
+        void Reader();
+        void Commit();
+    };
+
+} // namespace PocketServices
+
+#endif // POCKETDB_CHAIN_REINDEXER_H
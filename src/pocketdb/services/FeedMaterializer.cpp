@@ -0,0 +1,273 @@
+// Copyright (c) 2018-2022 The Pocketnet developers
+// Distributed under the Apache 2.0 software license, see the accompanying
+// https://www.apache.org/licenses/LICENSE-2.0
+
+#include "pocketdb/services/FeedMaterializer.h"
+
+#include <algorithm>
+
+#include "util.h"
+
+namespace PocketServices
+{
+    void FeedMaterializer::Start(boost::thread_group& threadGroup)
+    {
+        {
+            LOCK(_snapshots_mutex);
+            _enabled = true;
+        }
+
+        shutdown = false;
+        threadGroup.create_thread([this] { Worker(); });
+    }
+
+    void FeedMaterializer::Stop()
+    {
+        {
+            LOCK(_snapshots_mutex);
+
+            _enabled = false;
+            _snapshots.clear();
+        }
+
+        {
+            LOCK(_queue_mutex);
+
+            shutdown = true;
+            _queue_cond.notify_all();
+        }
+
+        // Wait worker exit
+        LOCK(_running_mutex);
+    }
+
+    void FeedMaterializer::Enqueue(int height)
+    {
+        {
+            LOCK(_snapshots_mutex);
+
+            if (!_enabled)
+                return;
+
+            _height = height;
+            _snapshots.clear();
+        }
+
+        LOCK(_queue_mutex);
+        pending = height;
+        _queue_cond.notify_all();
+    }
+
+    void FeedMaterializer::Invalidate()
+    {
+        LOCK(_snapshots_mutex);
+
+        _height = -1;
+        _snapshots.clear();
+    }
+
+    FeedSnapshotRef FeedMaterializer::GetHierarchical(int height, const string& lang, const vector<int>& contentTypes,
+        int badReputationLimit)
+    {
+        FeedSnapshotKey key;
+        key.Lang = lang;
+        key.ContentTypes = contentTypes;
+        key.BadReputationLimit = badReputationLimit;
+
+        return Get(height, key);
+    }
+
+    FeedSnapshotRef FeedMaterializer::GetHotPosts(int height, int depth, const string& lang,
+        const vector<int>& contentTypes, int badReputationLimit)
+    {
+        FeedSnapshotKey key;
+        key.Hot = true;
+        key.Lang = lang;
+        key.ContentTypes = contentTypes;
+        key.Depth = depth;
+        key.BadReputationLimit = badReputationLimit;
+
+        return Get(height, key);
+    }
+
+    // Drops least recently requested key if map is full
+    static void EvictOldestKey(map<FeedSnapshotKey, FeedSnapshotKeyRequest>& keys, int limit)
+    {
+        if ((int) keys.size() < limit)
+            return;
+
+        auto oldest = min_element(keys.begin(), keys.end(), [](const auto& a, const auto& b) {
+            return a.second.Sequence < b.second.Sequence;
+        });
+        keys.erase(oldest);
+    }
+
+    void FeedMaterializer::Register(const FeedSnapshotKey& key, int height)
+    {
+        FeedSnapshotKeyRequest request;
+        request.Height = height;
+        request.Sequence = ++_sequence;
+
+        if (auto it = _keys.find(key); it != _keys.end())
+        {
+            it->second = request;
+            return;
+        }
+
+        // Key requested once is only a candidate - single requests with arbitrary parameters
+        // must not push out feeds of real clients
+        auto candidate = _candidateKeys.find(key);
+        if (candidate == _candidateKeys.end())
+        {
+            EvictOldestKey(_candidateKeys, MAX_FEED_SNAPSHOT_CANDIDATE_KEYS);
+            _candidateKeys.emplace(key, request);
+            return;
+        }
+
+        _candidateKeys.erase(candidate);
+        EvictOldestKey(_keys, MAX_FEED_SNAPSHOT_KEYS);
+        _keys.emplace(key, request);
+    }
+
+    FeedSnapshotRef FeedMaterializer::Get(int height, FeedSnapshotKey& key)
+    {
+        // Order of content types does not change selection
+        sort(key.ContentTypes.begin(), key.ContentTypes.end());
+        key.ContentTypes.erase(unique(key.ContentTypes.begin(), key.ContentTypes.end()), key.ContentTypes.end());
+
+        LOCK(_snapshots_mutex);
+
+        if (!_enabled)
+            return nullptr;
+
+        // Remember key for next blocks
+        Register(key, _height >= 0 ? _height : height);
+
+        if (height != _height)
+            return nullptr;
+
+        auto it = _snapshots.find(key);
+        return it != _snapshots.end() ? it->second : nullptr;
+    }
+
+    void FeedMaterializer::Worker()
+    {
+        RenameThread("pocketcoin-feeds");
+        LogPrintf("FeedMaterializer: starting thread worker\n");
+
+        LOCK(_running_mutex);
+
+        // Own read-only connection - selection does not hold RPC pool connections
+        auto dbBasePath = (GetDataDir() / "pocketdb").string();
+
+        sqliteDbInst = make_shared<SQLiteDatabase>(true);
+        sqliteDbInst->Init(dbBasePath, "main");
+        sqliteDbInst->AttachDatabase("web");
+
+        webRpcRepoInst = make_shared<WebRpcRepository>(*sqliteDbInst);
+
+        while (true)
+        {
+            int height;
+
+            {
+                WAIT_LOCK(_queue_mutex, lock);
+
+                while (!shutdown && pending < 0)
+                    _queue_cond.wait(lock);
+
+                if (shutdown) break;
+
+                // Blocks connected during previous run are skipped - only last one is served
+                height = pending;
+                pending = -1;
+            }
+
+            Materialize(height);
+        }
+
+        sqliteDbInst->m_connection_mutex.lock();
+
+        webRpcRepoInst->Destroy();
+        webRpcRepoInst = nullptr;
+
+        sqliteDbInst->DetachDatabase("web");
+        sqliteDbInst->Close();
+
+        sqliteDbInst->m_connection_mutex.unlock();
+        sqliteDbInst = nullptr;
+
+        LogPrintf("FeedMaterializer: thread worker exit\n");
+    }
+
+    void FeedMaterializer::Materialize(int height)
+    {
+        int64_t nTime1 = GetTimeMicros();
+
+        vector<FeedSnapshotKey> keys;
+        {
+            LOCK(_snapshots_mutex);
+
+            if (_height != height)
+                return;
+
+            for (auto it = _keys.begin(); it != _keys.end();)
+            {
+                if (it->second.Height < height - FEED_SNAPSHOT_KEY_EXPIRY)
+                    it = _keys.erase(it);
+                else
+                    keys.push_back((it++)->first);
+            }
+        }
+
+        int materialized = 0;
+        for (const auto& key : keys)
+        {
+            // Next block arrived - its snapshots are needed, not these
+            {
+                LOCK(_queue_mutex);
+                if (shutdown || pending >= 0)
+                    return;
+            }
+
+            FeedSnapshotRef snapshot;
+            try
+            {
+                snapshot = Select(height, key);
+            }
+            catch (const std::exception& e)
+            {
+                LogPrintf("Warning: FeedMaterializer::Materialize - %s\n", e.what());
+                continue;
+            }
+
+            LOCK(_snapshots_mutex);
+
+            if (_height != height)
+                return;
+
+            _snapshots[key] = snapshot;
+            materialized += 1;
+        }
+
+        int64_t nTime2 = GetTimeMicros();
+        LogPrint(BCLog::BENCH, "    - FeedMaterializer::Materialize (%d feeds at height %d): %.2fms\n",
+            materialized, height, 0.001 * (double)(nTime2 - nTime1));
+    }
+
+    FeedSnapshotRef FeedMaterializer::Select(int height, const FeedSnapshotKey& key)
+    {
+        auto snapshot = make_shared<FeedSnapshot>();
+        snapshot->Height = height;
+
+        if (key.Hot)
+            snapshot->Ids = webRpcRepoInst->GetHotPostIds(HOT_POSTS_SNAPSHOT_SIZE, key.Depth, height, key.Lang,
+                key.ContentTypes, key.BadReputationLimit);
+        else
+            snapshot->Candidates = webRpcRepoInst->GetHierarchicalCandidates(height, key.Lang, key.ContentTypes,
+                key.BadReputationLimit);
+
+        return snapshot;
+    }
+
+} // namespace PocketServices
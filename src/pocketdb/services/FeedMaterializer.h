@@ -0,0 +1,116 @@
+// Copyright (c) 2018-2022 The Pocketnet developers
+// Distributed under the Apache 2.0 software license, see the accompanying
+// https://www.apache.org/licenses/LICENSE-2.0
+
+#ifndef POCKETDB_FEED_MATERIALIZER_H
+#define POCKETDB_FEED_MATERIALIZER_H
+
+#include <boost/thread.hpp>
+#include "utiltime.h"
+#include "sync.h"
+
+#include "pocketdb/SQLiteDatabase.h"
+#include "pocketdb/helpers/FeedRanking.h"
+#include "pocketdb/repositories/web/WebRpcRepository.h"
+
+namespace PocketServices
+{
+    using namespace PocketDb;
+    using namespace PocketHelpers;
+
+    static const bool DEFAULT_FEED_SNAPSHOTS = true;
+    static const int MAX_FEED_SNAPSHOT_KEYS = 64;
+    // Keys requested once wait for the second request before they are materialized
+    static const int MAX_FEED_SNAPSHOT_CANDIDATE_KEYS = 256;
+    // Key not requested during this number of blocks is not materialized anymore
+    static const int FEED_SNAPSHOT_KEY_EXPIRY = 60;
+    // Hot posts requested with larger count are selected by RPC itself
+    static const int HOT_POSTS_SNAPSHOT_SIZE = 100;
+
+    // Request parameters selecting feed candidates - everything except height
+    struct FeedSnapshotKey
+    {
+        bool Hot = false;
+        string Lang;
+        vector<int> ContentTypes;
+        int Depth = 0;
+        int BadReputationLimit = 0;
+
+        bool operator<(const FeedSnapshotKey& b) const
+        {
+            return tie(Hot, Lang, ContentTypes, Depth, BadReputationLimit) <
+                tie(b.Hot, b.Lang, b.ContentTypes, b.Depth, b.BadReputationLimit);
+        }
+    };
+
+    // Feed candidates selected once for height, never changed after publish
+    struct FeedSnapshot
+    {
+        int Height = 0;
+        // Hierarchical feed - unranked, ranking depends on per-request filters
+        vector<HierarchicalCandidate> Candidates;
+        // Hot posts - ordered, at most HOT_POSTS_SNAPSHOT_SIZE
+        vector<int64_t> Ids;
+    };
+
+    typedef shared_ptr<const FeedSnapshot> FeedSnapshotRef;
+
+    // Last request of key - height for expiry and sequence number for eviction
+    struct FeedSnapshotKeyRequest
+    {
+        int Height = 0;
+        uint64_t Sequence = 0;
+    };
+
+    // Materializes candidates of hierarchical feed and hot posts after every connected block, so
+    // gethierarchicalfeed, gethierarchicalstrip and gethotposts do not repeat the heavy selection per client.
+    // Keys are registered by requests: a key requested twice is materialized by following blocks until
+    // nobody asks for FEED_SNAPSHOT_KEY_EXPIRY blocks, requests before that are served by SQL. When the
+    // registry is full the least recently requested key is evicted. Only snapshots of the last
+    // connected block are served; new block or disconnect drops them until materialized again.
+    class FeedMaterializer
+    {
+    public:
+        void Start(boost::thread_group& threadGroup);
+        void Stop();
+
+        // Block connected and indexed
+        void Enqueue(int height);
+        // Block disconnected
+        void Invalidate();
+
+        // Snapshot for request or nullptr if not materialized
+        FeedSnapshotRef GetHierarchical(int height, const string& lang, const vector<int>& contentTypes,
+            int badReputationLimit);
+        FeedSnapshotRef GetHotPosts(int height, int depth, const string& lang, const vector<int>& contentTypes,
+            int badReputationLimit);
+
+    private:
+        SQLiteDatabaseRef sqliteDbInst;
+        WebRpcRepositoryRef webRpcRepoInst;
+
+        bool shutdown = false;
+        int pending = -1;
+
+        Mutex _running_mutex;
+        Mutex _queue_mutex;
+        std::condition_variable _queue_cond;
+
+        Mutex _snapshots_mutex;
+        bool _enabled = false;
+        int _height = -1;
+        uint64_t _sequence = 0;
+        map<FeedSnapshotKey, FeedSnapshotKeyRequest> _keys;
+        map<FeedSnapshotKey, FeedSnapshotKeyRequest> _candidateKeys;
+        map<FeedSnapshotKey, FeedSnapshotRef> _snapshots;
+
+        void Worker();
+        void Materialize(int height);
+        FeedSnapshotRef Get(int height, FeedSnapshotKey& key);
+        void Register(const FeedSnapshotKey& key, int height);
+        FeedSnapshotRef Select(int height, const FeedSnapshotKey& key);
+    };
+
+} // PocketServices
+
+#endif // POCKETDB_FEED_MATERIALIZER_H
@@ -6,10 +6,79 @@
 
 namespace PocketServices
 {
+    // Binary payload starts with zero byte - json payload always starts with '{'
+    static const char BINARY_PAYLOAD_MAGIC[] = { '\0', 'p', 'k', 't' };
+    static const uint8_t BINARY_PAYLOAD_VERSION = 1;
+
+    // Binary entry: tx hash, type of model and fields of the type in fixed order.
+    // Text is length-prefixed, numbers are zigzag varints, tags and images are string vectors.
+    // Empty text means absent field, the same as empty string in json payload.
+
+    static void WriteText(CDataStream& stream, const optional<string>& value)
+    {
+        stream << (value ? *value : string());
+    }
+
+    static void WriteText(CDataStream& stream, const Payload* payload, const optional<string>& (Payload::*field)() const)
+    {
+        WriteText(stream, payload ? (payload->*field)() : optional<string>());
+    }
+
+    static void WriteNumber(CDataStream& stream, const optional<int64_t>& value)
+    {
+        int64_t n = value ? *value : 0;
+        WriteVarInt<CDataStream, VarIntMode::DEFAULT, uint64_t>(stream, ((uint64_t) n << 1) ^ (uint64_t) (n >> 63));
+    }
+
+    // Models keep tags and images as json array - elements are strings by consensus (BuildHash)
+    static void WriteList(CDataStream& stream, const Payload* payload, const optional<string>& (Payload::*field)() const)
+    {
+        vector<string> list;
+
+        UniValue src(UniValue::VARR);
+        if (payload && (payload->*field)() && src.read(*(payload->*field)()) && src.isArray())
+        {
+            list.reserve(src.size());
+            for (size_t i = 0; i < src.size(); i++)
+                list.push_back(src[i].isStr() ? src[i].get_str() : src[i].write());
+        }
+
+        stream << list;
+    }
+
+    static string ReadText(CDataStream& stream)
+    {
+        string value;
+        stream >> value;
+        return value;
+    }
+
+    static int64_t ReadNumber(CDataStream& stream)
+    {
+        uint64_t n = ReadVarInt<CDataStream, VarIntMode::DEFAULT, uint64_t>(stream);
+        return (int64_t) (n >> 1) ^ -(int64_t) (n & 1);
+    }
+
+    static string ReadList(CDataStream& stream)
+    {
+        vector<string> list;
+        stream >> list;
+
+        UniValue result(UniValue::VARR);
+        for (auto& item : list)
+            result.push_back(move(item));
+
+        return result.write();
+    }
+
     tuple<bool, PocketBlock> Serializer::DeserializeBlock(const CBlock& block, CDataStream& stream)
     {
         // Get Serialized data from stream
-        auto pocketData = parseStream(stream);
+        auto src = readStream(stream);
+        if (isBinary(src))
+            return deserializeBlockBinary(block, src);
+
+        auto pocketData = parseJson(src);
         return deserializeBlock(block, pocketData);
     }
     tuple<bool, PocketBlock> Serializer::DeserializeBlock(const CBlock& block)
@@ -26,7 +95,25 @@ namespace PocketServices
 
     tuple<bool, PTransactionRef> Serializer::DeserializeTransaction(const CTransactionRef& tx, CDataStream& stream)
     {
-        auto pocketData = parseStream(stream);
+        auto src = readStream(stream);
+        if (isBinary(src))
+        {
+            try
+            {
+                auto entries = parseBinary(src, {tx});
+
+                auto entry = entries.find(tx->GetHash());
+                auto ptx = entry != entries.end() ? entry->second : createInstance(tx, nullptr);
+                return {ptx != nullptr, ptx};
+            }
+            catch (const std::exception& ex)
+            {
+                LogPrintf("Error deserialize transaction: %s: %s\n", tx->GetHash().GetHex(), ex.what());
+                return {false, nullptr};
+            }
+        }
+
+        auto pocketData = parseJson(src);
         return deserializeTransaction(tx, pocketData);
     }
 
@@ -71,8 +158,257 @@ namespace PocketServices
         return result;
     }
 
+    PayloadFormat Serializer::GetPayloadFormat(int nVersion)
+    {
+        return nVersion >= POCKET_BINARY_PAYLOAD_VERSION ? PayloadFormat::Binary : PayloadFormat::Json;
+    }
+
+    string Serializer::SerializeBlockPayload(const PocketBlock& block, PayloadFormat format)
+    {
+        if (format == PayloadFormat::Json)
+            return SerializeBlock(block)->write();
+
+        CDataStream entries(SER_NETWORK, PROTOCOL_VERSION);
+        uint64_t count = 0;
+        for (const auto& transaction : block)
+        {
+            if (!PocketHelpers::TransactionHelper::IsPocketTransaction(*transaction->GetType()))
+                continue;
+
+            writeBinaryEntry(entries, *transaction);
+            count += 1;
+        }
+
+        CDataStream stream(SER_NETWORK, PROTOCOL_VERSION);
+        stream.write(BINARY_PAYLOAD_MAGIC, sizeof(BINARY_PAYLOAD_MAGIC));
+        stream << BINARY_PAYLOAD_VERSION;
+        WriteCompactSize(stream, count);
+        stream.write(entries.data(), entries.size());
+
+        return stream.str();
+    }
+
+    string Serializer::SerializeTransactionPayload(const Transaction& transaction, PayloadFormat format)
+    {
+        // Not pocket transactions sent without payload in any format
+        if (!PocketHelpers::TransactionHelper::IsPocketTransaction(*transaction.GetType()))
+            return "";
+
+        if (format == PayloadFormat::Json)
+            return SerializeTransaction(transaction)->write();
+
+        CDataStream stream(SER_NETWORK, PROTOCOL_VERSION);
+        stream.write(BINARY_PAYLOAD_MAGIC, sizeof(BINARY_PAYLOAD_MAGIC));
+        stream << BINARY_PAYLOAD_VERSION;
+        WriteCompactSize(stream, 1);
+        writeBinaryEntry(stream, transaction);
+
+        return stream.str();
+    }
+
+    // Fields are taken the same way Serialize of models takes them, so receiver restores
+    // the instance that json payload would give
+    void Serializer::writeBinaryEntry(CDataStream& stream, const Transaction& transaction)
+    {
+        auto txType = *transaction.GetType();
+        auto payload = transaction.GetPayload();
+
+        stream << uint256S(*transaction.GetHash());
+        WriteCompactSize(stream, (uint64_t) txType);
+
+        switch (txType)
+        {
+            case ACCOUNT_USER:
+                WriteText(stream, transaction.GetString1()); // address
+                WriteText(stream, transaction.GetString2()); // referrer
+                WriteText(stream, payload && payload->GetString1() ? *payload->GetString1() : "en"); // lang
+                WriteText(stream, payload, &Payload::GetString2); // name
+                WriteText(stream, payload, &Payload::GetString3); // avatar
+                WriteText(stream, payload, &Payload::GetString4); // about
+                WriteText(stream, payload, &Payload::GetString5); // url
+                WriteText(stream, payload, &Payload::GetString6); // pubkey
+                WriteText(stream, payload, &Payload::GetString7); // donations
+                break;
+            case ACCOUNT_SETTING:
+                WriteText(stream, transaction.GetString1()); // address
+                WriteText(stream, payload, &Payload::GetString1); // data
+                break;
+            case CONTENT_POST:
+            case CONTENT_VIDEO:
+            case CONTENT_ARTICLE:
+                WriteText(stream, transaction.GetString1()); // address
+                // root tx hash only for edited content
+                WriteText(stream, transaction.GetString2() != transaction.GetHash() ? transaction.GetString2() : nullopt);
+                WriteText(stream, transaction.GetString3()); // relay tx hash
+                WriteText(stream, payload && payload->GetString1() ? *payload->GetString1() : "en"); // lang
+                WriteText(stream, payload, &Payload::GetString2); // caption
+                WriteText(stream, payload, &Payload::GetString3); // message
+                WriteText(stream, payload, &Payload::GetString7); // url
+                WriteText(stream, payload, &Payload::GetString6); // settings
+                WriteList(stream, payload, &Payload::GetString4); // tags
+                WriteList(stream, payload, &Payload::GetString5); // images
+                break;
+            case CONTENT_DELETE:
+                WriteText(stream, transaction.GetString1()); // address
+                WriteText(stream, transaction.GetString2()); // root tx hash of deleted content
+                WriteText(stream, payload, &Payload::GetString1); // settings
+                break;
+            case CONTENT_COMMENT:
+            case CONTENT_COMMENT_EDIT:
+            case CONTENT_COMMENT_DELETE:
+                WriteText(stream, transaction.GetString1()); // address
+                // root tx hash only for edited comment
+                WriteText(stream, transaction.GetString2() != transaction.GetHash() ? transaction.GetString2() : nullopt);
+                WriteText(stream, transaction.GetString3()); // post tx hash
+                WriteText(stream, transaction.GetString4()); // parent tx hash
+                WriteText(stream, transaction.GetString5()); // answer tx hash
+                if (txType != CONTENT_COMMENT_DELETE)
+                    WriteText(stream, payload, &Payload::GetString1); // message
+                break;
+            case ACTION_SCORE_CONTENT:
+            case ACTION_SCORE_COMMENT:
+            case ACTION_COMPLAIN:
+                WriteText(stream, transaction.GetString1()); // address
+                WriteText(stream, transaction.GetString2()); // content or comment tx hash
+                WriteNumber(stream, transaction.GetInt1()); // value or reason
+                break;
+            case BOOST_CONTENT:
+            case ACTION_SUBSCRIBE:
+            case ACTION_SUBSCRIBE_PRIVATE:
+            case ACTION_SUBSCRIBE_CANCEL:
+            case ACTION_BLOCKING:
+            case ACTION_BLOCKING_CANCEL:
+                WriteText(stream, transaction.GetString1()); // address
+                WriteText(stream, transaction.GetString2()); // content tx hash or address to
+                break;
+            default:
+                break;
+        }
+    }
+
+    // Mirror of Deserialize and DeserializePayload of models for fields of writeBinaryEntry
+    void Serializer::readBinaryFields(CDataStream& stream, Transaction& ptx)
+    {
+        auto setText = [&](void (Transaction::*setter)(string)) {
+            if (auto value = ReadText(stream); !value.empty())
+                (ptx.*setter)(move(value));
+        };
+        auto setPayloadText = [&](void (Payload::*setter)(string)) {
+            if (auto value = ReadText(stream); !value.empty())
+                (ptx.GetPayload()->*setter)(move(value));
+        };
+        auto setRootTxHash = [&]() {
+            auto value = ReadText(stream);
+            ptx.SetString2(value.empty() ? *ptx.GetHash() : move(value));
+        };
+
+        switch (*ptx.GetType())
+        {
+            case ACCOUNT_USER:
+                setText(&Transaction::SetString1);
+                setText(&Transaction::SetString2);
+                ptx.GeneratePayload();
+                setPayloadText(&Payload::SetString1);
+                ptx.GetPayload()->SetString2(ReadText(stream));
+                setPayloadText(&Payload::SetString3);
+                setPayloadText(&Payload::SetString4);
+                setPayloadText(&Payload::SetString5);
+                setPayloadText(&Payload::SetString6);
+                setPayloadText(&Payload::SetString7);
+                break;
+            case ACCOUNT_SETTING:
+                setText(&Transaction::SetString1);
+                ptx.GeneratePayload();
+                setPayloadText(&Payload::SetString1);
+                break;
+            case CONTENT_POST:
+            case CONTENT_VIDEO:
+            case CONTENT_ARTICLE:
+            {
+                setText(&Transaction::SetString1);
+                setRootTxHash();
+                setText(&Transaction::SetString3);
+                ptx.GeneratePayload();
+                auto lang = ReadText(stream);
+                ptx.GetPayload()->SetString1(lang.empty() ? "en" : move(lang));
+                setPayloadText(&Payload::SetString2);
+                setPayloadText(&Payload::SetString3);
+                setPayloadText(&Payload::SetString7);
+                setPayloadText(&Payload::SetString6);
+                ptx.GetPayload()->SetString4(ReadList(stream));
+                ptx.GetPayload()->SetString5(ReadList(stream));
+                break;
+            }
+            case CONTENT_DELETE:
+            {
+                setText(&Transaction::SetString1);
+                setText(&Transaction::SetString2);
+                if (auto settings = ReadText(stream); !settings.empty())
+                {
+                    ptx.GeneratePayload();
+                    ptx.GetPayload()->SetString1(move(settings));
+                }
+                break;
+            }
+            case CONTENT_COMMENT:
+            case CONTENT_COMMENT_EDIT:
+            case CONTENT_COMMENT_DELETE:
+                setText(&Transaction::SetString1);
+                setRootTxHash();
+                setText(&Transaction::SetString3);
+                setText(&Transaction::SetString4);
+                setText(&Transaction::SetString5);
+                if (*ptx.GetType() != CONTENT_COMMENT_DELETE)
+                {
+                    ptx.GeneratePayload();
+                    setPayloadText(&Payload::SetString1);
+                }
+                break;
+            case ACTION_SCORE_CONTENT:
+            case ACTION_SCORE_COMMENT:
+            case ACTION_COMPLAIN:
+                setText(&Transaction::SetString1);
+                setText(&Transaction::SetString2);
+                ptx.SetInt1(ReadNumber(stream));
+                break;
+            case BOOST_CONTENT:
+            case ACTION_SUBSCRIBE:
+            case ACTION_SUBSCRIBE_PRIVATE:
+            case ACTION_SUBSCRIBE_CANCEL:
+            case ACTION_BLOCKING:
+            case ACTION_BLOCKING_CANCEL:
+                setText(&Transaction::SetString1);
+                setText(&Transaction::SetString2);
+                if (*ptx.GetType() == BOOST_CONTENT)
+                    ptx.GeneratePayload();
+                break;
+            default:
+                break;
+        }
+    }
 
     shared_ptr <Transaction> Serializer::buildInstance(const CTransactionRef& tx, const UniValue& src)
+    {
+        // Deserialize payload if exists
+        if (!src.exists("d"))
+            return createInstance(tx, nullptr);
+
+        UniValue txDataSrc(UniValue::VOBJ);
+        auto txDataBase64 = src["d"].get_str();
+        auto txJson = DecodeBase64(txDataBase64);
+        txDataSrc.read(txJson);
+
+        if (src.exists("t") && src["t"].get_str() == "Mempool" && txDataSrc.exists("data"))
+        {
+            auto txMempoolDataBase64 = txDataSrc["data"].get_str();
+            auto txMempoolJson = DecodeBase64(txMempoolDataBase64);
+            txDataSrc.read(txMempoolJson);
+        }
+
+        return createInstance(tx, &txDataSrc);
+    }
+
+    shared_ptr <Transaction> Serializer::createInstance(const CTransactionRef& tx, const UniValue* data)
     {
         TxType txType;
         if (!PocketHelpers::TransactionHelper::IsPocketSupportedTransaction(tx, txType))
@@ -90,23 +426,10 @@ namespace PocketServices
         if (!buildOutputs(tx, ptx))
             return nullptr;
 
-        // Deserialize payload if exists
-        if (src.exists("d"))
+        if (data)
         {
-            UniValue txDataSrc(UniValue::VOBJ);
-            auto txDataBase64 = src["d"].get_str();
-            auto txJson = DecodeBase64(txDataBase64);
-            txDataSrc.read(txJson);
-
-            if (src.exists("t") && src["t"].get_str() == "Mempool" && txDataSrc.exists("data"))
-            {
-                auto txMempoolDataBase64 = txDataSrc["data"].get_str();
-                auto txMempoolJson = DecodeBase64(txMempoolDataBase64);
-                txDataSrc.read(txMempoolJson);
-            }
-
-            ptx->Deserialize(txDataSrc);
-            ptx->DeserializePayload(txDataSrc);
+            ptx->Deserialize(*data);
+            ptx->DeserializePayload(*data);
         }
 
         return ptx;
@@ -137,17 +460,16 @@ namespace PocketServices
     bool Serializer::buildInputs(const CTransactionRef& tx, shared_ptr <Transaction>& ptx)
     {
         string spentTxHash = tx->GetHash().GetHex();
+        ptx->Inputs().reserve(tx->vin.size());
 
         for (size_t i = 0; i < tx->vin.size(); i++)
         {
             const CTxIn& txin = tx->vin[i];
 
-            auto inp = make_shared<TransactionInput>();
-            inp->SetSpentTxHash(spentTxHash);
-            inp->SetTxHash(txin.prevout.hash.GetHex());
-            inp->SetNumber(txin.prevout.n);
-            
-            ptx->Inputs().push_back(inp);
+            auto& inp = ptx->Inputs().emplace_back();
+            inp.SetSpentTxHash(spentTxHash);
+            inp.SetTxHash(txin.prevout.hash.GetHex());
+            inp.SetNumber(txin.prevout.n);
         }
 
         return !ptx->Inputs().empty();
@@ -156,16 +478,17 @@ namespace PocketServices
     bool Serializer::buildOutputs(const CTransactionRef& tx, shared_ptr <Transaction>& ptx)
     {
         string txHash = tx->GetHash().GetHex();
+        ptx->Outputs().reserve(tx->vout.size());
 
         for (size_t i = 0; i < tx->vout.size(); i++)
         {
             const CTxOut& txout = tx->vout[i];
 
-            auto out = make_shared<TransactionOutput>();
-            out->SetTxHash(txHash);
-            out->SetNumber((int) i);
-            out->SetValue(txout.nValue);
-            out->SetScriptPubKey(HexStr(txout.scriptPubKey));
+            auto& out = ptx->Outputs().emplace_back();
+            out.SetTxHash(txHash);
+            out.SetNumber((int) i);
+            out.SetValue(txout.nValue);
+            out.SetScriptPubKey(HexStr(txout.scriptPubKey));
 
             txnouttype type;
             std::vector <CTxDestination> vDest;
@@ -173,34 +496,83 @@ namespace PocketServices
             if (ExtractDestinations(txout.scriptPubKey, type, vDest, nRequired))
             {
                 for (const auto& dest : vDest)
-                    out->SetAddressHash(EncodeDestination(dest));
+                    out.SetAddressHash(EncodeDestination(dest));
             }
             else
             {
-                out->SetAddressHash("");
+                out.SetAddressHash("");
             }
-
-            ptx->Outputs().push_back(out);
         }
 
         return !ptx->Outputs().empty();
     }
 
-    UniValue Serializer::parseStream(CDataStream& stream)
+    string Serializer::readStream(CDataStream& stream)
     {
-        // Prepare source data - old format (Json)
-        UniValue pocketData(UniValue::VOBJ);
+        string src;
         if (!stream.empty())
-        {
-            // TODO (brangr) (v0.21.0): speed up protocol
-            string src;
             stream >> src;
+
+        return src;
+    }
+
+    UniValue Serializer::parseJson(const string& src)
+    {
+        // Prepare source data - old format (Json)
+        UniValue pocketData(UniValue::VOBJ);
+        if (!src.empty())
             pocketData.read(src);
-        }
 
         return pocketData;
     }
 
+    bool Serializer::isBinary(const string& src)
+    {
+        return src.size() > sizeof(BINARY_PAYLOAD_MAGIC)
+            && src.compare(0, sizeof(BINARY_PAYLOAD_MAGIC), BINARY_PAYLOAD_MAGIC, sizeof(BINARY_PAYLOAD_MAGIC)) == 0;
+    }
+
+    // Entries are restored straight into instances of transactions they belong to
+    map<uint256, PTransactionRef> Serializer::parseBinary(const string& src, const vector<CTransactionRef>& txs)
+    {
+        CDataStream stream(src.data() + sizeof(BINARY_PAYLOAD_MAGIC), src.data() + src.size(), SER_NETWORK, PROTOCOL_VERSION);
+
+        uint8_t version;
+        stream >> version;
+        if (version != BINARY_PAYLOAD_VERSION)
+            throw std::runtime_error(strprintf("unsupported binary payload version %d", version));
+
+        map<uint256, CTransactionRef> txsByHash;
+        for (const auto& tx : txs)
+            txsByHash.emplace(tx->GetHash(), tx);
+
+        map<uint256, PTransactionRef> entries;
+
+        uint64_t count = ReadCompactSize(stream);
+        for (uint64_t i = 0; i < count; i++)
+        {
+            uint256 hash;
+            stream >> hash;
+            uint64_t txType = ReadCompactSize(stream);
+
+            // Layout of fields depends on type - entry of other transaction can not be skipped
+            auto tx = txsByHash.find(hash);
+            if (tx == txsByHash.end())
+                throw std::runtime_error(strprintf("payload of unknown transaction %s", hash.GetHex()));
+
+            auto ptx = createInstance(tx->second, nullptr);
+            if (!ptx || (uint64_t) *ptx->GetType() != txType)
+                throw std::runtime_error(strprintf("payload type %d does not match transaction %s", txType, hash.GetHex()));
+
+            readBinaryFields(stream, *ptx);
+            entries[hash] = ptx;
+        }
+
+        if (!stream.empty())
+            throw std::runtime_error("unexpected data after payload entries");
+
+        return entries;
+    }
 
     tuple<bool, PocketBlock> Serializer::deserializeBlock(const CBlock& block, UniValue& pocketData)
     {
@@ -232,6 +604,31 @@ namespace PocketServices
         return { true, pocketBlock };
     }
 
+    tuple<bool, PocketBlock> Serializer::deserializeBlockBinary(const CBlock& block, const string& src)
+    {
+        map<uint256, PTransactionRef> entries;
+        try
+        {
+            entries = parseBinary(src, block.vtx);
+        }
+        catch (const std::exception& ex)
+        {
+            LogPrintf("Error deserialize block: %s: %s\n", block.GetHash().GetHex(), ex.what());
+            return { false, {} };
+        }
+
+        // Restore pocket transaction instance
+        PocketBlock pocketBlock;
+        for (const auto& tx : block.vtx)
+        {
+            auto entry = entries.find(tx->GetHash());
+            if (auto ptx = entry != entries.end() ? entry->second : createInstance(tx, nullptr); ptx)
+                pocketBlock.push_back(ptx);
+        }
+
+        return { true, pocketBlock };
+    }
+
     tuple<bool, shared_ptr<Transaction>> Serializer::deserializeTransaction(const CTransactionRef& tx, UniValue& pocketData)
     {
         auto ptx = buildInstance(tx, pocketData);
@@ -28,6 +28,7 @@
 #include "key_io.h"
 #include "streams.h"
 #include "logging.h"
+#include "version.h"
 
 #include <utilstrencodings.h>
 
@@ -36,6 +37,15 @@ namespace PocketServices
     using namespace PocketTx;
     using namespace PocketHelpers;
 
+    // Format of pocket payload appended to block and transaction network messages
+    // Json - legacy format, understood by all peers
+    // Binary - fields of every type in fixed order without keys, base64 and json, for peers since POCKET_BINARY_PAYLOAD_VERSION
+    enum class PayloadFormat
+    {
+        Json,
+        Binary
+    };
+
     class Serializer
     {
     public:
@@ -49,13 +59,27 @@ namespace PocketServices
         static shared_ptr<UniValue> SerializeBlock(const PocketBlock& block);
         static shared_ptr<UniValue> SerializeTransaction(const Transaction& transaction);
 
+        // Payload format supported by peer with protocol version nVersion
+        static PayloadFormat GetPayloadFormat(int nVersion);
+
+        // Payload ready for network message
+        static string SerializeBlockPayload(const PocketBlock& block, PayloadFormat format);
+        static string SerializeTransactionPayload(const Transaction& transaction, PayloadFormat format);
+
     private:
         static shared_ptr<Transaction> buildInstance(const CTransactionRef& tx, const UniValue& src);
+        static shared_ptr<Transaction> createInstance(const CTransactionRef& tx, const UniValue* data);
         static shared_ptr<Transaction> buildInstanceRpc(const CTransactionRef& tx, const UniValue& src);
         static bool buildInputs(const CTransactionRef& tx, shared_ptr<Transaction>& ptx);
         static bool buildOutputs(const CTransactionRef& tx, shared_ptr<Transaction>& ptx);
-        static UniValue parseStream(CDataStream& stream);
+        static string readStream(CDataStream& stream);
+        static UniValue parseJson(const string& src);
+        static bool isBinary(const string& src);
+        static void writeBinaryEntry(CDataStream& stream, const Transaction& transaction);
+        static void readBinaryFields(CDataStream& stream, Transaction& ptx);
+        static map<uint256, PTransactionRef> parseBinary(const string& src, const vector<CTransactionRef>& txs);
         static tuple<bool, PocketBlock> deserializeBlock(const CBlock& block, UniValue& pocketData);
+        static tuple<bool, PocketBlock> deserializeBlockBinary(const CBlock& block, const string& src);
         static tuple<bool, shared_ptr<Transaction>> deserializeTransaction(const CTransactionRef& tx, UniValue& pocketData);
     };
 
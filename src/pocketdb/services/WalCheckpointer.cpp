@@ -0,0 +1,165 @@
+// Copyright (c) 2018-2022 The Pocketnet developers
+// Distributed under the Apache 2.0 software license, see the accompanying
+// https://www.apache.org/licenses/LICENSE-2.0
+
+#include "pocketdb/services/WalCheckpointer.h"
+#include "pocketdb/pocketnet.h"
+#include "util.h"
+
+namespace PocketServices
+{
+    void WalCheckpointer::Start(boost::thread_group& threadGroup)
+    {
+        interval = max<int64_t>(1, gArgs.GetArg("-sqlcheckpointinterval", DEFAULT_SQL_CHECKPOINT_INTERVAL));
+        truncateSize = max<int64_t>(0, gArgs.GetArg("-sqlwaltruncatesize", DEFAULT_SQL_WAL_TRUNCATE_SIZE)) * 1024 * 1024;
+        walPath = GetDataDir() / "pocketdb" / "main.sqlite3-wal";
+        shutdown = false;
+
+        threadGroup.create_thread([this] { Worker(); });
+    }
+
+    void WalCheckpointer::Stop()
+    {
+        {
+            LOCK(_queue_mutex);
+
+            shutdown = true;
+            _queue_cond.notify_all();
+        }
+
+        // Wait worker exit
+        LOCK(_running_mutex);
+    }
+
+    void WalCheckpointer::Notify()
+    {
+        LOCK(_queue_mutex);
+
+        pending = true;
+        _queue_cond.notify_all();
+    }
+
+    WalCheckpointStats WalCheckpointer::GetStats()
+    {
+        LOCK(_stats_mutex);
+
+        auto stats = _stats;
+        stats.WalSize = WalSize();
+
+        return stats;
+    }
+
+    void WalCheckpointer::Worker()
+    {
+        RenameThread("pocketcoin-walcheckpoint");
+        LogPrintf("WalCheckpointer: starting thread worker\n");
+
+        LOCK(_running_mutex);
+
+        // Own connection - PASSIVE checkpoint does not take locks of writer
+        auto dbBasePath = (GetDataDir() / "pocketdb").string();
+
+        sqliteDbInst = make_shared<SQLiteDatabase>(false);
+        sqliteDbInst->Init(dbBasePath, "main");
+
+        while (true)
+        {
+            {
+                WAIT_LOCK(_queue_mutex, lock);
+
+                if (!shutdown && !pending)
+                    _queue_cond.wait_for(lock, std::chrono::seconds(interval));
+
+                if (shutdown) break;
+
+                pending = false;
+            }
+
+            Checkpoint();
+        }
+
+        sqliteDbInst->Close();
+        sqliteDbInst = nullptr;
+
+        LogPrintf("WalCheckpointer: thread worker exit\n");
+    }
+
+    void WalCheckpointer::Checkpoint()
+    {
+        int mode = SQLITE_CHECKPOINT_PASSIVE;
+        bool writerLocked = false;
+        int64_t walSize = WalSize();
+
+        // Nothing written since WAL was truncated
+        if (walSize == 0)
+            return;
+
+        // Escalate only if WAL still has frames to reset or file itself grew too large
+        bool escalate;
+        {
+            LOCK(_stats_mutex);
+            escalate = _stats.LastLogFrames != 0 || walSize >= truncateSize;
+        }
+
+        // Readers pinning old snapshot make RESTART and TRUNCATE fail - escalate only when read pool is idle.
+        // Writer does not wait on busy database, so it must not start transaction while checkpoint holds write lock.
+        auto poolStats = SQLiteConnectionPoolInst.GetStats();
+        auto consensusPoolStats = SQLiteConsensusPoolInst.GetStats();
+        if (escalate && poolStats.Opened == poolStats.Idle && consensusPoolStats.Opened == consensusPoolStats.Idle &&
+            SQLiteDbInst.m_connection_mutex.try_lock())
+        {
+            writerLocked = true;
+            mode = walSize >= truncateSize ? SQLITE_CHECKPOINT_TRUNCATE : SQLITE_CHECKPOINT_RESTART;
+        }
+
+        int logFrames = 0;
+        int checkpointedFrames = 0;
+
+        int64_t nTime1 = GetTimeMicros();
+        int res = sqlite3_wal_checkpoint_v2(sqliteDbInst->m_db, "main", mode, &logFrames, &checkpointedFrames);
+        int64_t nTime2 = GetTimeMicros();
+
+        if (writerLocked)
+            SQLiteDbInst.m_connection_mutex.unlock();
+
+        if (res != SQLITE_OK && res != SQLITE_BUSY)
+        {
+            LogPrintf("WalCheckpointer: checkpoint failed: %d; %s\n", res, sqlite3_errstr(res));
+            return;
+        }
+
+        {
+            LOCK(_stats_mutex);
+
+            switch (mode)
+            {
+                case SQLITE_CHECKPOINT_PASSIVE: _stats.Passive += 1; break;
+                case SQLITE_CHECKPOINT_RESTART: _stats.Restart += 1; break;
+                case SQLITE_CHECKPOINT_TRUNCATE: _stats.Truncate += 1; break;
+            }
+
+            if (res == SQLITE_BUSY)
+                _stats.Busy += 1;
+
+            _stats.LastDurationUs = nTime2 - nTime1;
+            _stats.MaxDurationUs = max(_stats.MaxDurationUs, nTime2 - nTime1);
+            _stats.TotalDurationUs += nTime2 - nTime1;
+            _stats.LastLogFrames = logFrames;
+            _stats.LastCheckpointedFrames = checkpointedFrames;
+        }
+
+        LogPrint(BCLog::BENCH, "WalCheckpointer: mode %d, %d/%d frames, wal %d bytes, %.2fms%s\n",
+            mode, checkpointedFrames, logFrames, walSize, 0.001 * (nTime2 - nTime1), res == SQLITE_BUSY ? " (busy)" : "");
+    }
+
+    int64_t WalCheckpointer::WalSize() const
+    {
+        if (walPath.empty())
+            return 0;
+
+        boost::system::error_code ec;
+        auto size = fs::file_size(walPath, ec);
+        return ec ? 0 : (int64_t) size;
+    }
+
+} // PocketServices
@@ -0,0 +1,73 @@
+// Copyright (c) 2018-2022 The Pocketnet developers
+// Distributed under the Apache 2.0 software license, see the accompanying
+// https://www.apache.org/licenses/LICENSE-2.0
+
+#ifndef POCKETDB_WAL_CHECKPOINTER_H
+#define POCKETDB_WAL_CHECKPOINTER_H
+
+#include <boost/thread.hpp>
+#include "utiltime.h"
+#include "sync.h"
+
+#include "pocketdb/SQLiteDatabase.h"
+
+namespace PocketServices
+{
+    using namespace PocketDb;
+
+    static const int DEFAULT_SQL_CHECKPOINT_INTERVAL = 30;
+    static const int DEFAULT_SQL_WAL_TRUNCATE_SIZE = 64;
+
+    struct WalCheckpointStats
+    {
+        int64_t Passive = 0;
+        int64_t Restart = 0;
+        int64_t Truncate = 0;
+        int64_t Busy = 0;
+        int64_t LastDurationUs = 0;
+        int64_t MaxDurationUs = 0;
+        int64_t TotalDurationUs = 0;
+        int LastLogFrames = 0;
+        int LastCheckpointedFrames = 0;
+        int64_t WalSize = 0;
+    };
+
+    // Checkpoints WAL of main database outside of block connection.
+    // Writer commits do not checkpoint inline; instead this thread runs PASSIVE checkpoint after every
+    // connected block and by timer. When no pooled read-only connection holds a snapshot and writer is idle,
+    // checkpoint escalates to RESTART, or TRUNCATE when WAL file grew over limit, so WAL is reused from start.
+    class WalCheckpointer
+    {
+    public:
+        void Start(boost::thread_group& threadGroup);
+        void Stop();
+
+        // Block connected - good moment for checkpoint
+        void Notify();
+
+        WalCheckpointStats GetStats();
+
+    private:
+        SQLiteDatabaseRef sqliteDbInst;
+        fs::path walPath;
+
+        int64_t interval = DEFAULT_SQL_CHECKPOINT_INTERVAL;
+        int64_t truncateSize = DEFAULT_SQL_WAL_TRUNCATE_SIZE;
+        bool shutdown = false;
+        bool pending = false;
+
+        Mutex _running_mutex;
+        Mutex _queue_mutex;
+        std::condition_variable _queue_cond;
+
+        Mutex _stats_mutex;
+        WalCheckpointStats _stats;
+
+        void Worker();
+        void Checkpoint();
+        int64_t WalSize() const;
+    };
+
+} // PocketServices
+
+#endif // POCKETDB_WAL_CHECKPOINTER_H
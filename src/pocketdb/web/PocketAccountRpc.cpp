@@ -123,6 +123,36 @@ namespace PocketWeb::PocketWebRpc
         return request.DbConnection()->WebRpcRepoInst->GetAddressesRegistrationDates(addresses);
     }
 
+    UniValue VerifyAccountStats(const JSONRPCRequest& request)
+    {
+        if (request.fHelp)
+            throw runtime_error(
+                "verifyaccountstats ( [\"address\",...] limit )\n"
+                "\nCompare stored account counters with values calculated from transactions.\n"
+                "\nArguments:\n"
+                "1. \"addresses\"   (array or string, optional) Accounts to check, all accounts if empty\n"
+                "2. \"limit\"       (numeric, optional, default 100) Max mismatches returned\n"
+            );
+
+        vector<string> addresses;
+        if (request.params.size() > 0)
+        {
+            if (request.params[0].isStr())
+                addresses.push_back(request.params[0].get_str());
+            else if (request.params[0].isArray())
+                for (unsigned int idx = 0; idx < request.params[0].size(); idx++)
+                    addresses.push_back(request.params[0][idx].get_str());
+        }
+
+        int limit = 100;
+        if (request.params.size() > 1 && request.params[1].isNum())
+            limit = request.params[1].get_int();
+
+        // Check of all accounts runs longer than -sqltimeout, pooled connections would interrupt it
+        SQLiteConnection connection(SQLiteTuning::Verification());
+        return connection.WebRpcRepoInst->VerifyAccountStats(addresses, limit);
+    }
+
     UniValue GetAccountState(const JSONRPCRequest& request)
     {
         if (request.fHelp)
@@ -25,6 +25,7 @@ namespace PocketWeb::PocketWebRpc
     UniValue GetAccountSubscribes(const JSONRPCRequest& request);
     UniValue GetAccountSubscribers(const JSONRPCRequest& request);
     UniValue GetAccountBlockings(const JSONRPCRequest& request);
+    UniValue VerifyAccountStats(const JSONRPCRequest& request);
 }
 
 
@@ -4,6 +4,7 @@
 
 #include <pocketdb/consensus/Base.h>
 #include "pocketdb/web/PocketContentRpc.h"
+#include "pocketdb/pocketnet.h"
 
 namespace PocketWeb::PocketWebRpc
 {
@@ -303,6 +304,20 @@ namespace PocketWeb::PocketWebRpc
         auto reputationConsensus = ReputationConsensusFactoryInst.Instance(chainActive.Height());
         auto badReputationLimit = reputationConsensus->GetConsensusLimit(ConsensusLimit_bad_reputation);
 
+        // Posts selected after last block - enough if snapshot holds all of them or more than requested
+        auto snapshot = PocketServices::FeedMaterializerInst.GetHotPosts(nHeightOffset, depthBlocks, lang, contentTypes,
+            badReputationLimit);
+        if (snapshot && count > 0 && (count <= (int) snapshot->Ids.size() || (int) snapshot->Ids.size() < PocketServices::HOT_POSTS_SNAPSHOT_SIZE))
+        {
+            vector<int64_t> ids(snapshot->Ids.begin(), snapshot->Ids.begin() + min(count, (int) snapshot->Ids.size()));
+
+            UniValue result(UniValue::VARR);
+            if (!ids.empty())
+                result.push_backV(request.DbConnection()->WebRpcRepoInst->GetContentsData(ids, address));
+
+            return result;
+        }
+
         return request.DbConnection()->WebRpcRepoInst->GetHotPosts(count, depthBlocks, nHeightOffset, lang,
             contentTypes, address, badReputationLimit);
     }
@@ -401,10 +416,21 @@ namespace PocketWeb::PocketWebRpc
         auto badReputationLimit = reputationConsensus->GetConsensusLimit(ConsensusLimit_bad_reputation);
 
         UniValue result(UniValue::VOBJ);
-        UniValue content = request.DbConnection()->WebRpcRepoInst->GetHierarchicalFeed(
-            countOut, topContentId, topHeight, lang, tags, contentTypes,
-            txIdsExcluded, adrsExcluded, tagsExcluded,
-            address, badReputationLimit);
+        UniValue content;
+        if (auto snapshot = PocketServices::FeedMaterializerInst.GetHierarchical(topHeight, lang, contentTypes, badReputationLimit))
+        {
+            content = request.DbConnection()->WebRpcRepoInst->GetHierarchicalFeed(
+                snapshot->Candidates, countOut, topContentId, topHeight, lang, tags, contentTypes,
+                txIdsExcluded, adrsExcluded, tagsExcluded,
+                address, badReputationLimit);
+        }
+        else
+        {
+            content = request.DbConnection()->WebRpcRepoInst->GetHierarchicalFeed(
+                countOut, topContentId, topHeight, lang, tags, contentTypes,
+                txIdsExcluded, adrsExcluded, tagsExcluded,
+                address, badReputationLimit);
+        }
 
         result.pushKV("height", topHeight);
         result.pushKV("contents", content);
@@ -648,4 +674,34 @@ namespace PocketWeb::PocketWebRpc
 
         return result;
     }
-}
\ No newline at end of file
+
+    UniValue VerifyContentStats(const JSONRPCRequest& request)
+    {
+        if (request.fHelp)
+            throw runtime_error(
+                "verifycontentstats ( [\"txid\",...] limit )\n"
+                "\nCompare stored content counters with values calculated from transactions.\n"
+                "\nArguments:\n"
+                "1. \"txids\"       (array or string, optional) Root transaction hashes of contents to check, all contents if empty\n"
+                "2. \"limit\"       (numeric, optional, default 100) Max mismatches returned\n"
+            );
+
+        vector<string> txHashes;
+        if (request.params.size() > 0)
+        {
+            if (request.params[0].isStr())
+                txHashes.push_back(request.params[0].get_str());
+            else if (request.params[0].isArray())
+                for (unsigned int idx = 0; idx < request.params[0].size(); idx++)
+                    txHashes.push_back(request.params[0][idx].get_str());
+        }
+
+        int limit = 100;
+        if (request.params.size() > 1 && request.params[1].isNum())
+            limit = request.params[1].get_int();
+
+        // Check of all contents runs longer than -sqltimeout, pooled connections would interrupt it
+        SQLiteConnection connection(SQLiteTuning::Verification());
+        return connection.WebRpcRepoInst->VerifyContentStats(txHashes, limit);
+    }
+}
@@ -27,6 +27,7 @@ namespace PocketWeb::PocketWebRpc
     UniValue FeedSelector(const JSONRPCRequest& request);
     UniValue GetContentsStatistic(const JSONRPCRequest& request);
     UniValue GetRandomContents(const JSONRPCRequest& request);
+    UniValue VerifyContentStats(const JSONRPCRequest& request);
     
 }
 
@@ -500,14 +500,12 @@ namespace PocketWeb::PocketWebRpc
             throw JSONRPCError(RPC_INVALID_PARAMS, "Invalid inputs params");
         }
 
-        auto pBlock = request.DbConnection()->TransactionRepoInst->List(transactions, false, true, true);
-
+        // Build answer transaction by transaction - models are released as soon as they are serialized
         UniValue result(UniValue::VARR);
-        for (const auto& ptx : *pBlock)
+        request.DbConnection()->TransactionRepoInst->ListStream(transactions, [&](const PTransactionRef& ptx)
         {
-            UniValue utx = _constructTransaction(ptx);
-            result.push_back(utx);
-        }
+            result.push_back(_constructTransaction(ptx));
+        }, false, true, true);
 
         return result;
     }
@@ -529,10 +527,10 @@ namespace PocketWeb::PocketWebRpc
         {
             UniValue uinp(UniValue::VOBJ);
 
-            uinp.pushKV("txid", *inp->GetSpentTxHash());
-            uinp.pushKV("vout", *inp->GetNumber());
-            if (inp->GetAddressHash()) uinp.pushKV("address", *inp->GetAddressHash());
-            if (inp->GetValue()) uinp.pushKV("value", *inp->GetValue() / 100000000.0);
+            uinp.pushKV("txid", *inp.GetSpentTxHash());
+            uinp.pushKV("vout", *inp.GetNumber());
+            if (inp.GetAddressHash()) uinp.pushKV("address", *inp.GetAddressHash());
+            if (inp.GetValue()) uinp.pushKV("value", *inp.GetValue() / 100000000.0);
 
             utx.At("vin").push_back(uinp);
         }
@@ -542,17 +540,17 @@ namespace PocketWeb::PocketWebRpc
         for (const auto& out : ptx->Outputs())
         {
             UniValue uout(UniValue::VOBJ);
-            uout.pushKV("n", *out->GetNumber());
-            uout.pushKV("value", *out->GetValue() / 100000000.0);
+            uout.pushKV("n", *out.GetNumber());
+            uout.pushKV("value", *out.GetValue() / 100000000.0);
 
             UniValue scriptPubKey(UniValue::VOBJ);
             UniValue addresses(UniValue::VARR);
-            addresses.push_back(*out->GetAddressHash());
+            addresses.push_back(*out.GetAddressHash());
             scriptPubKey.pushKV("addresses", addresses);
-            scriptPubKey.pushKV("hex", *out->GetScriptPubKey());
+            scriptPubKey.pushKV("hex", *out.GetScriptPubKey());
             uout.pushKV("scriptPubKey", scriptPubKey);
 
-            if (out->GetSpentHeight()) uout.pushKV("spent", *out->GetSpentHeight());
+            if (out.GetSpentHeight()) uout.pushKV("spent", *out.GetSpentHeight());
 
             utx.At("vout").push_back(uout);
         }
@@ -119,6 +119,20 @@ static const CRPCCommand commands_post[] =
 };
 // @formatter:on
 
+// @formatter:off
+static const CRPCCommand commands_private[] =
+{
+    {"accounts",       "verifyaccountstats",               &VerifyAccountStats,             {"addresses", "limit"}},
+    {"contents",       "verifycontentstats",               &VerifyContentStats,             {"txids", "limit"}},
+};
+// @formatter:on
+
+void RegisterPocketnetPrivateRPCCommands(CRPCTable &tableRPC)
+{
+    for (const auto& command : commands_private)
+        tableRPC.appendCommand(command.name, &command);
+}
+
 void RegisterPocketnetWebRPCCommands(CRPCTable &tableRPC, CRPCTable &tablePostRPC)
 {
     for (const auto& command : commands)
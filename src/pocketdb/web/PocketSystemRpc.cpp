@@ -3,6 +3,7 @@
 // https://www.apache.org/licenses/LICENSE-2.0
 
 #include "pocketdb/web/PocketSystemRpc.h"
+#include "httpserver.h"
 
 namespace PocketWeb::PocketWebRpc
 {
@@ -92,13 +93,13 @@ namespace PocketWeb::PocketWebRpc
 
         UniValue proxies(UniValue::VARR);
         if (WSConnections) {
-            auto fillProxy = [&proxies](const std::pair<const std::string, WSUser>& it) {
-                if (it.second.Service) {
+            auto fillProxy = [&proxies](const WSUser& it) {
+                if (it.Service) {
                     UniValue proxy(UniValue::VOBJ);
-                    proxy.pushKV("address", it.second.Address);
-                    proxy.pushKV("ip", it.second.Ip);
-                    proxy.pushKV("port", it.second.MainPort);
-                    proxy.pushKV("portWss", it.second.WssPort);
+                    proxy.pushKV("address", it.Address);
+                    proxy.pushKV("ip", it.Ip);
+                    proxy.pushKV("port", it.MainPort);
+                    proxy.pushKV("portWss", it.WssPort);
                     proxies.push_back(proxy);
                 }
             };
@@ -106,6 +107,18 @@ namespace PocketWeb::PocketWebRpc
         }
         entry.pushKV("proxies", proxies);
 
+        // Websocket notification clients
+        if (WSConnections) {
+            auto wsStats = WSConnections->GetStats();
+
+            UniValue ws(UniValue::VOBJ);
+            ws.pushKV("connections", (int64_t) wsStats.Connections);
+            ws.pushKV("addresses", (int64_t) wsStats.Addresses);
+            ws.pushKV("sent", wsStats.Sent);
+            ws.pushKV("dropped", wsStats.Dropped);
+            entry.pushKV("websocket", ws);
+        }
+
         // Ports information
         int64_t nodePort = gArgs.GetArg("-port", Params().GetDefaultPort());
         int64_t publicPort = gArgs.GetArg("-publicrpcport", BaseParams().PublicRPCPort());
@@ -122,6 +135,56 @@ namespace PocketWeb::PocketWebRpc
         ports.pushKV("https", staticPort);
         entry.pushKV("ports", ports);
 
+        // Hit rate of serialized block payload sent to peers
+        auto payloadCacheStats = PocketServices::BlockPayloadCacheInst.GetStats();
+        auto payloadCacheRequests = payloadCacheStats.Hits + payloadCacheStats.Misses;
+
+        UniValue payloadCache(UniValue::VOBJ);
+        payloadCache.pushKV("hits", payloadCacheStats.Hits);
+        payloadCache.pushKV("misses", payloadCacheStats.Misses);
+        payloadCache.pushKV("hitrate", payloadCacheRequests > 0 ? (double) payloadCacheStats.Hits / payloadCacheRequests : 0.0);
+        payloadCache.pushKV("evictions", payloadCacheStats.Evictions);
+        payloadCache.pushKV("blocks", (int64_t) payloadCacheStats.Count);
+        payloadCache.pushKV("size", (int64_t) payloadCacheStats.Bytes);
+        payloadCache.pushKV("maxsize", (int64_t) payloadCacheStats.MaxBytes);
+        entry.pushKV("blockpayloadcache", payloadCache);
+
+        // Read-only database connections shared by RPC workers
+        auto poolStats = PocketDb::SQLiteConnectionPoolInst.GetStats();
+
+        UniValue pool(UniValue::VOBJ);
+        pool.pushKV("capacity", (int64_t) poolStats.Capacity);
+        pool.pushKV("opened", (int64_t) poolStats.Opened);
+        pool.pushKV("idle", (int64_t) poolStats.Idle);
+        pool.pushKV("acquired", poolStats.Acquired);
+        pool.pushKV("waited", poolStats.Waited);
+        pool.pushKV("waitavgms", poolStats.Waited > 0 ? 0.001 * poolStats.WaitTotalUs / poolStats.Waited : 0.0);
+        pool.pushKV("waitmaxms", 0.001 * poolStats.WaitMaxUs);
+        pool.pushKV("reopened", poolStats.Reopened);
+        pool.pushKV("failed", poolStats.Failed);
+        entry.pushKV("sqlreadpool", pool);
+
+        // Background checkpoints of main database WAL
+        auto walStats = PocketServices::WalCheckpointerInst.GetStats();
+        auto walCheckpoints = walStats.Passive + walStats.Restart + walStats.Truncate;
+
+        UniValue wal(UniValue::VOBJ);
+        wal.pushKV("walsize", walStats.WalSize);
+        wal.pushKV("passive", walStats.Passive);
+        wal.pushKV("restart", walStats.Restart);
+        wal.pushKV("truncate", walStats.Truncate);
+        wal.pushKV("busy", walStats.Busy);
+        wal.pushKV("lastframes", walStats.LastLogFrames);
+        wal.pushKV("lastcheckpointed", walStats.LastCheckpointedFrames);
+        wal.pushKV("lastms", 0.001 * walStats.LastDurationUs);
+        wal.pushKV("maxms", 0.001 * walStats.MaxDurationUs);
+        wal.pushKV("avgms", walCheckpoints > 0 ? 0.001 * walStats.TotalDurationUs / walCheckpoints : 0.0);
+        entry.pushKV("walcheckpoint", wal);
+
+        // Cached results of public RPC methods
+        if (g_webSocket)
+            entry.pushKV("rpccache", g_webSocket->m_table_rpc.cacheStatistic());
+
         return entry;
     }
     
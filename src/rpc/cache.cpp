@@ -4,13 +4,70 @@
 
 #include <rpc/cache.h>
 #include <rpc/server.h>
+#include <validation.h>
 
-static const unsigned int MAX_CACHE_SIZE_MB = 64;
+/** Feed results pinned to explicit topHeight are reused during this number of blocks */
+static const int PINNED_FEED_TTL = 10;
 
-RPCCache::RPCCache() 
+/** Approximate memory used by entry besides key and content */
+static const size_t ENTRY_OVERHEAD = sizeof(std::string) + 96;
+
+RPCCache::RPCCache()
 {
-    m_blockHeight = chainActive.Height();
-    m_maxCacheSize = gArgs.GetArg("-rpccachesize", MAX_CACHE_SIZE_MB) * 1024 * 1024;
+    m_maxStripeSize = gArgs.GetArg("-rpccachesize", DEFAULT_RPC_CACHE_SIZE) * 1024 * 1024 / STRIPES;
+
+    for (const auto& method : { "getlastcomments",
+                                "getcomments",
+                                "getuseraddress",
+                                "getaddressregistration",
+                                "search",
+                                "searchlinks",
+                                "searchusers",
+                                "gettags",
+                                "getrawtransactionwithmessagebyid",
+                                "getrawtransactionwithmessage",
+                                "getrawtransaction",
+                                "getusercontents",
+                                "gethotposts",
+                                "getuserprofile",
+                                "txunspent",
+                                "getaddressid",
+                                "getuserstate",
+                                "getpagescores",
+                                "getcontent",
+                                "getcontents",
+                                "getaccountsetting",
+                                "getcontentsstatistic",
+                                "getusersubscribes",
+                                "getusersubscribers",
+                                "getuserblockings",
+                                "getaddressscores",
+                                "getpostscores",
+                                "getstatisticbyhours",
+                                "getstatisticbydays",
+                                "getstatisticcontentbyhours",
+                                "getstatisticcontentbydays",
+                                "getrecomendedaccountsbytags",
+                                "getrecomendedcontentsbyscoresonsimilarcontents",
+                                "getaddressinfo",
+                                "getcompactblock",
+                                "getlastblocks",
+                                "searchbyhash",
+                                "gettransactions",
+                                "getaddresstransactions",
+                                "getblocktransactions",
+                                "getbalancehistory",
+                                "getcoininfo",
+                                "estimatesmartfee" })
+        m_methods.emplace(std::piecewise_construct, std::forward_as_tuple(method), std::forward_as_tuple(1));
+
+    for (const auto& method : { "gethistoricalfeed",
+                                "gethistoricalstrip",
+                                "gethierarchicalfeed",
+                                "gethierarchicalstrip",
+                                "getprofilefeed",
+                                "getsubscribesfeed" })
+        m_methods.emplace(std::piecewise_construct, std::forward_as_tuple(method), std::forward_as_tuple(PINNED_FEED_TTL));
 }
 
 std::string RPCCache::MakeHashKey(const JSONRPCRequest& req)
@@ -22,83 +79,170 @@ std::string RPCCache::MakeHashKey(const JSONRPCRequest& req)
     return hashKey;
 }
 
-void RPCCache::Clear()
+RPCCache::Stripe& RPCCache::GetStripe(const std::string& key)
 {
-    LOCK(CacheMutex);
-    m_cache.clear();
-    m_cacheSize = 0;
-    m_blockHeight = chainActive.Height();
-
-    LogPrint(BCLog::RPC, "RPC cache cleared.\n");
+    return m_stripes[std::hash<std::string>{}(key) % STRIPES];
 }
 
-void RPCCache::Put(const std::string& path, const UniValue& content)
+int RPCCache::GetTtl(const JSONRPCRequest& req, const MethodStat& stat)
 {
-    if (chainActive.Height() > m_blockHeight)
-        this->Clear();
+    if (stat.ttl <= 1)
+        return 1;
 
-    int size = path.size() + content.write().size();
+    // Only requests with explicit topHeight of connected block return the same result after new blocks.
+    // Height above tip is resolved to the tip by handlers and changes with every block.
+    UniValue topHeight;
+    if (req.params.isArray() && req.params.size() > 0)
+        topHeight = req.params[0];
+    else if (req.params.isObject())
+        topHeight = find_value(req.params, "topHeight");
 
-    if (m_maxCacheSize < size + m_cacheSize) {
-        LogPrint(BCLog::RPC, "RPC cache over size limit: current = %d, max = %d\n", size + m_cacheSize, m_maxCacheSize);
-        return;
-    }
+    if (topHeight.isNum() && topHeight.get_int() > 0 && topHeight.get_int() <= chainActive.Height())
+        return stat.ttl;
 
-    LOCK(CacheMutex);
-    if (m_cache.find(path) == m_cache.end()) {
-        LogPrint(BCLog::RPC, "RPC cache put '%s', size %d\n", path, size);
-        m_cacheSize += size;
-        m_cache.emplace(path, content);
-    } else {
-        LogPrint(BCLog::RPC, "RPC cache put update '%s'\n", path);
-        // Adjust cache size, remove old element size, add new element size
-        m_cacheSize -= m_cache[path].size();
-        m_cacheSize += content.write().size();
-        m_cache[path] = content;
-    }
+    return 1;
 }
 
-UniValue RPCCache::Get(const std::string& path)
+void RPCCache::Evict(Stripe& stripe, size_t required)
 {
-    if (m_cache.empty()) {
-        return UniValue();
+    while (!stripe.lru.empty() && stripe.size + required > m_maxStripeSize)
+    {
+        auto& victim = stripe.lru.back();
+        victim.stat->evictions += 1;
+        stripe.size -= victim.size;
+        stripe.index.erase(victim.key);
+        stripe.lru.pop_back();
     }
+}
 
-    if (chainActive.Height() > m_blockHeight) {
-        this->Clear();
-        return UniValue();
+void RPCCache::Clear()
+{
+    for (auto& stripe : m_stripes)
+    {
+        LOCK(stripe.mutex);
+        stripe.index.clear();
+        stripe.lru.clear();
+        stripe.size = 0;
     }
 
-    LOCK(CacheMutex);
-    if (m_cache.find(path) != m_cache.end()) {
-        LogPrint(BCLog::RPC, "RPC Cache get found %s in cache\n", path);
-        return m_cache.at(path);
-    }
+    LogPrint(BCLog::RPC, "RPC cache cleared.\n");
+}
 
-    // Return empty UniValue if nothing found in cache.
-    return UniValue();
+bool RPCCache::IsSupported(const JSONRPCRequest& req) const
+{
+    return m_methods.find(req.strMethod) != m_methods.end();
 }
 
-UniValue RPCCache::GetRpcCache(const JSONRPCRequest& req)
+std::shared_ptr<const std::string> RPCCache::GetRpcCache(const JSONRPCRequest& req)
 {
-    // Return empty UniValue if method not supported for caching.
-    if (std::find(supportedMethods.begin(), supportedMethods.end(), req.strMethod) == supportedMethods.end())
-        return UniValue();
+    // Return nullptr if method not supported for caching.
+    auto method = m_methods.find(req.strMethod);
+    if (method == m_methods.end())
+        return nullptr;
+
+    auto key = MakeHashKey(req);
+    int height = chainActive.Height();
+
+    auto& stripe = GetStripe(key);
+    {
+        LOCK(stripe.mutex);
+
+        auto it = stripe.index.find(key);
+        if (it != stripe.index.end())
+        {
+            auto entry = it->second;
+            if (height <= entry->validUntil)
+            {
+                LogPrint(BCLog::RPC, "RPC Cache get found %s in cache\n", key);
+                stripe.lru.splice(stripe.lru.begin(), stripe.lru, entry);
+                method->second.hits += 1;
+                return entry->content;
+            }
+
+            // Outdated by new blocks
+            stripe.size -= entry->size;
+            stripe.lru.erase(entry);
+            stripe.index.erase(it);
+        }
+    }
 
-    return Get(MakeHashKey(req));
+    // Return nullptr if nothing found in cache.
+    method->second.misses += 1;
+    return nullptr;
 }
 
-void RPCCache::PutRpcCache(const JSONRPCRequest& req, const UniValue& content)
+void RPCCache::PutRpcCache(const JSONRPCRequest& req, const std::shared_ptr<const std::string>& content)
 {
-    if (std::find(supportedMethods.begin(), supportedMethods.end(), req.strMethod) == supportedMethods.end())
+    auto method = m_methods.find(req.strMethod);
+    if (method == m_methods.end() || !content)
+        return;
+
+    auto key = MakeHashKey(req);
+    size_t size = key.size() + content->size() + ENTRY_OVERHEAD;
+    if (size > m_maxStripeSize)
+    {
+        LogPrint(BCLog::RPC, "RPC cache entry over size limit: size = %d, max = %d\n", size, m_maxStripeSize);
         return;
+    }
+
+    int validUntil = chainActive.Height() + GetTtl(req, method->second) - 1;
+
+    auto& stripe = GetStripe(key);
+    LOCK(stripe.mutex);
+
+    auto it = stripe.index.find(key);
+    if (it != stripe.index.end())
+    {
+        LogPrint(BCLog::RPC, "RPC cache put update '%s'\n", key);
+        // Adjust cache size, remove old element size, add new element size
+        stripe.size -= it->second->size;
+        stripe.lru.erase(it->second);
+        stripe.index.erase(it);
+    }
+    else
+    {
+        LogPrint(BCLog::RPC, "RPC cache put '%s', size %d\n", key, size);
+    }
+
+    Evict(stripe, size);
 
-    Put(MakeHashKey(req), content);
+    stripe.lru.push_front(Entry{key, content, size, validUntil, &method->second});
+    stripe.index.emplace(std::move(key), stripe.lru.begin());
+    stripe.size += size;
 }
 
 std::tuple<int64_t, int64_t> RPCCache::Statistic()
 {
-    LOCK(CacheMutex);
+    int64_t count = 0;
+    int64_t size = 0;
+
+    for (auto& stripe : m_stripes)
+    {
+        LOCK(stripe.mutex);
+        count += stripe.lru.size();
+        size += stripe.size;
+    }
+
     // Return number of elements in cache and size of cache in bytes
-    return { (int64_t) m_cache.size(), (int64_t) m_cacheSize };
-}
\ No newline at end of file
+    return { count, size };
+}
+
+UniValue RPCCache::MethodStatistic()
+{
+    UniValue result(UniValue::VOBJ);
+    for (const auto& [name, stat] : m_methods)
+    {
+        int64_t hits = stat.hits;
+        int64_t misses = stat.misses;
+        if (hits + misses == 0)
+            continue;
+
+        UniValue methodStat(UniValue::VOBJ);
+        methodStat.pushKV("hits", hits);
+        methodStat.pushKV("misses", misses);
+        methodStat.pushKV("evictions", (int64_t) stat.evictions);
+        result.pushKV(name, methodStat);
+    }
+
+    return result;
+}
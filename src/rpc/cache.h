@@ -9,65 +9,68 @@
 #include <logging.h>
 #include <validation.h>
 
+#include <array>
+#include <atomic>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
 class JSONRPCRequest;
 
+/** Default number of megabytes for RPC cache of each RPC table */
+static const unsigned int DEFAULT_RPC_CACHE_SIZE = 64;
+
+/**
+ * Cache of RPC results serialized to JSON.
+ *
+ * Serialized result is shared between cache and replies, so hit is sent without copying and
+ * without encoding UniValue again.
+ *
+ * Every entry is stamped with the last chain height it stays valid for (height at put + method TTL),
+ * so a new block does not wipe the whole cache - outdated entries are dropped lazily on access or
+ * evicted as least recently used. Keys are spread over independently locked stripes so parallel
+ * RPC workers do not contend on a single mutex.
+ */
 class RPCCache
 {
 private:
-    Mutex CacheMutex;
-    std::map<std::string, UniValue> m_cache;
-    int m_blockHeight;
-    int m_cacheSize;
-    int m_maxCacheSize;
-    const std::vector<std::string> supportedMethods = { "getlastcomments",
-                                                        "getcomments",
-                                                        "getuseraddress",
-                                                        "getaddressregistration",
-                                                        "search",
-                                                        "searchlinks",
-                                                        "searchusers",
-                                                        "gettags",
-                                                        "getrawtransactionwithmessagebyid",
-                                                        "getrawtransactionwithmessage",
-                                                        "getrawtransaction",
-                                                        "getusercontents",
-                                                        "gethistoricalfeed",
-                                                        "gethistoricalstrip",
-                                                        "gethierarchicalfeed",
-                                                        "gethierarchicalstrip",
-                                                        "gethotposts",
-                                                        "getuserprofile",
-                                                        "getprofilefeed",
-                                                        "getsubscribesfeed",
-                                                        "txunspent",
-                                                        "getaddressid",
-                                                        "getuserstate",
-                                                        "getpagescores",
-                                                        "getcontent",
-                                                        "getcontents",
-                                                        "getaccountsetting",
-                                                        "getcontentsstatistic",
-                                                        "getusersubscribes",
-                                                        "getusersubscribers",
-                                                        "getuserblockings",
-                                                        "getaddressscores",
-                                                        "getpostscores",
-                                                        "getstatisticbyhours",
-                                                        "getstatisticbydays",
-                                                        "getstatisticcontentbyhours",
-                                                        "getstatisticcontentbydays",
-                                                        "getrecomendedaccountsbytags",
-                                                        "getrecomendedcontentsbyscoresonsimilarcontents",
-                                                        "getaddressinfo",
-                                                        "getcompactblock",
-                                                        "getlastblocks",
-                                                        "searchbyhash",
-                                                        "gettransactions",
-                                                        "getaddresstransactions",
-                                                        "getblocktransactions",
-                                                        "getbalancehistory",
-                                                        "getcoininfo",
-                                                        "estimatesmartfee" };
+    static const size_t STRIPES = 16;
+
+    struct MethodStat
+    {
+        // Number of blocks result of method stays valid
+        int ttl;
+        std::atomic<int64_t> hits{0};
+        std::atomic<int64_t> misses{0};
+        std::atomic<int64_t> evictions{0};
+
+        explicit MethodStat(int _ttl) : ttl(_ttl) {}
+    };
+
+    struct Entry
+    {
+        std::string key;
+        std::shared_ptr<const std::string> content;
+        size_t size;
+        int validUntil;
+        MethodStat* stat;
+    };
+
+    struct Stripe
+    {
+        Mutex mutex;
+        // Most recently used at front
+        std::list<Entry> lru;
+        std::unordered_map<std::string, std::list<Entry>::iterator> index;
+        size_t size = 0;
+    };
+
+    std::array<Stripe, STRIPES> m_stripes;
+    size_t m_maxStripeSize;
+
+    /* Supported methods with TTL in blocks. Methods with TTL above one block take explicit topHeight
+     * as first parameter - their results are extended only for requests pinned to that height. */
+    std::unordered_map<std::string, MethodStat> m_methods;
 
     /* Make a key for the unordered hash map by concatenating together the methodname and
      * params.  TODO: We will likely need to improve this methodology in the future in
@@ -75,21 +78,30 @@ private:
      */
     std::string MakeHashKey(const JSONRPCRequest& req);
 
+    Stripe& GetStripe(const std::string& key);
+
+    int GetTtl(const JSONRPCRequest& req, const MethodStat& stat);
+
+    /* Remove entries from tail of stripe until new entry fits in */
+    void Evict(Stripe& stripe, size_t required);
+
 public:
     RPCCache();
 
     void Clear();
 
-    void Put(const std::string& path, const UniValue& content);
-
-    UniValue Get(const std::string& path);
+    bool IsSupported(const JSONRPCRequest& req) const;
 
-    UniValue GetRpcCache(const JSONRPCRequest& req);
+    /* Serialized result or nullptr if nothing found in cache */
+    std::shared_ptr<const std::string> GetRpcCache(const JSONRPCRequest& req);
 
-    void PutRpcCache(const JSONRPCRequest& req, const UniValue& content);
+    void PutRpcCache(const JSONRPCRequest& req, const std::shared_ptr<const std::string>& content);
 
+    /* Number of elements in cache and size of cache in bytes */
     std::tuple<int64_t, int64_t> Statistic();
 
+    /* Hits, misses and evictions for each supported method */
+    UniValue MethodStatistic();
 };
 
 #endif // POCKETCOIN_RPC_CACHE_H
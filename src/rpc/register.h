@@ -21,5 +21,7 @@ void RegisterMiningRPCCommands(CRPCTable &tableRPC);
 void RegisterRawTransactionRPCCommands(CRPCTable &tableRPC);
 
 void RegisterPocketnetWebRPCCommands(CRPCTable &tableRPC, CRPCTable &tablePostRPC);
+/** Register pocketnet maintenance commands for private socket */
+void RegisterPocketnetPrivateRPCCommands(CRPCTable &tableRPC);
 
 #endif // POCKETCOIN_RPC_REGISTER_H
@@ -428,6 +428,35 @@ static inline JSONRPCRequest transformNamedArguments(const JSONRPCRequest& in, c
     return out;
 }
 
+const CRPCCommand* CRPCTable::prepareCommand(const JSONRPCRequest &request) const
+{
+    // Find method
+    auto it = mapCommands.find(request.strMethod);
+    if (it == mapCommands.end())
+        throw JSONRPCError(RPC_METHOD_NOT_FOUND, "Method not found");
+
+    const CRPCCommand *pcmd =  (*it).second;
+    g_rpcSignals.PreCommand(*pcmd);
+    return pcmd;
+}
+
+UniValue CRPCTable::executeCommand(const CRPCCommand *pcmd, const JSONRPCRequest &request) const
+{
+    try
+    {
+        // Execute, convert arguments to array if necessary
+        if (request.params.isObject()) {
+            return pcmd->actor(transformNamedArguments(request, pcmd->argNames));
+        } else {
+            return pcmd->actor(request);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        throw JSONRPCError(RPC_MISC_ERROR, e.what());
+    }
+}
+
 UniValue CRPCTable::execute(const JSONRPCRequest &request) const
 {
     // Return immediately if in warmup
@@ -441,33 +470,19 @@ UniValue CRPCTable::execute(const JSONRPCRequest &request) const
         return help(request);
     }
 
-    // Find method
-    auto it = mapCommands.find(request.strMethod);
-    if (it == mapCommands.end())
-        throw JSONRPCError(RPC_METHOD_NOT_FOUND, "Method not found");
-
-    const CRPCCommand *pcmd =  (*it).second;
-    g_rpcSignals.PreCommand(*pcmd);
+    const CRPCCommand *pcmd = prepareCommand(request);
     auto start = gStatEngineInstance.GetCurrentSystemTime();
 
     // See if this request reply is cached
-    UniValue ret = cache->GetRpcCache(request);
-    if (ret.isNull()) {
-        try
-        {
-            // Execute, convert arguments to array if necessary
-            if (request.params.isObject()) {
-                    ret = pcmd->actor(transformNamedArguments(request, pcmd->argNames));
-                } else {
-                    ret = pcmd->actor(request);
-            }
-                // Save return value in cache for later
-                cache->PutRpcCache(request, ret);
-        }
-        catch (const std::exception& e)
-        {
-            throw JSONRPCError(RPC_MISC_ERROR, e.what());
-        }
+    UniValue ret;
+    if (auto cached = cache->GetRpcCache(request)) {
+        ret.read(*cached);
+    } else {
+        ret = executeCommand(pcmd, request);
+
+        // Save return value in cache for later
+        if (cache->IsSupported(request))
+            cache->PutRpcCache(request, std::make_shared<const std::string>(ret.write()));
     }
 
     auto stop = gStatEngineInstance.GetCurrentSystemTime();
@@ -478,6 +493,50 @@ UniValue CRPCTable::execute(const JSONRPCRequest &request) const
     return ret;
 }
 
+std::shared_ptr<const std::string> CRPCTable::executeSerialized(const JSONRPCRequest &request) const
+{
+    // Return immediately if in warmup
+    {
+        LOCK(cs_rpcWarmup);
+        if (fRPCInWarmup)
+            throw JSONRPCError(RPC_IN_WARMUP, rpcWarmupStatus);
+    }
+
+    if (request.strMethod == "help") {
+        return std::make_shared<const std::string>(help(request).write());
+    }
+
+    const CRPCCommand *pcmd = prepareCommand(request);
+    auto start = gStatEngineInstance.GetCurrentSystemTime();
+
+    // Cached reply is shared as is
+    auto ret = cache->GetRpcCache(request);
+    if (!ret) {
+        ret = std::make_shared<const std::string>(executeCommand(pcmd, request).write());
+
+        // Save return value in cache for later
+        cache->PutRpcCache(request, ret);
+    }
+
+    auto stop = gStatEngineInstance.GetCurrentSystemTime();
+
+    auto diff = (stop - start);
+    LogPrint(BCLog::RPC, "RPC Method time %s (%s) - %ldms\n", request.strMethod, request.peerAddr.substr(0, request.peerAddr.find(':')), diff.count());
+
+    return ret;
+}
+
+UniValue CRPCTable::cacheStatistic() const
+{
+    auto[count, size] = cache->Statistic();
+
+    UniValue result(UniValue::VOBJ);
+    result.pushKV("count", count);
+    result.pushKV("size", size);
+    result.pushKV("methods", cache->MethodStatistic());
+    return result;
+}
+
 std::vector<std::string> CRPCTable::listCommands() const
 {
     std::vector<std::string> commandList;
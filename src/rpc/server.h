@@ -150,6 +150,9 @@ class CRPCTable
 private:
     std::map<std::string, const CRPCCommand*> mapCommands;
     std::unique_ptr<RPCCache> cache {new RPCCache()};
+
+    const CRPCCommand* prepareCommand(const JSONRPCRequest &request) const;
+    UniValue executeCommand(const CRPCCommand *pcmd, const JSONRPCRequest &request) const;
 public:
     const CRPCCommand* operator[](const std::string& name) const;
     std::string help(const std::string& name, const JSONRPCRequest& helpreq) const;
@@ -163,12 +166,26 @@ public:
      */
     UniValue execute(const JSONRPCRequest &request) const;
 
+    /**
+     * Execute a method and return its result serialized to JSON.
+     * Result found in cache is shared without copying.
+     * @param request The JSONRPCRequest to execute
+     * @returns Serialized result of the call.
+     * @throws an exception (UniValue) when an error happens.
+     */
+    std::shared_ptr<const std::string> executeSerialized(const JSONRPCRequest &request) const;
+
     /**
     * Returns a list of registered commands
     * @returns List of registered commands.
     */
     std::vector<std::string> listCommands() const;
 
+    /**
+    * Returns size of cached results and hits, misses and evictions for each cached method
+    */
+    UniValue cacheStatistic() const;
+
 
     /**
      * Appends a CRPCCommand to the dispatch table.
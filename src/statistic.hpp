@@ -265,6 +265,12 @@ namespace Statistic
             sqlite3_db_status(db, SQLITE_DBSTATUS_CACHE_SPILL, &current, &highWater, true);
             sqlStats.pushKV("CacheSpill", current);
 
+            auto stmtCacheStats = PocketDb::SQLiteDbInst.GetStatementCacheStats();
+            sqlStats.pushKV("StmtCacheHit", stmtCacheStats.Hits);
+            sqlStats.pushKV("StmtCacheMiss", stmtCacheStats.Misses);
+            sqlStats.pushKV("StmtCacheEvict", stmtCacheStats.Evictions);
+            sqlStats.pushKV("StmtCacheSize", (int64_t) stmtCacheStats.Size);
+
             result.pushKV("SQL", sqlStats);
 
             return result;
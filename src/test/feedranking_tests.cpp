@@ -0,0 +1,158 @@
+// Copyright (c) 2018-2022 The Pocketnet developers
+// Distributed under the Apache 2.0 software license, see the accompanying
+// https://www.apache.org/licenses/LICENSE-2.0
+
+#include <pocketdb/helpers/FeedRanking.h>
+#include <test/test_pocketcoin.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace PocketHelpers;
+
+// Ranking of GetHierarchicalFeed as it was - every record compared with all others
+static void RankPairwise(std::vector<HierarchicalRecord>& postsRanks)
+{
+    int nElements = postsRanks.size();
+    for (auto& iPostRank : postsRanks)
+    {
+        double _LAST5R = 0;
+        double _UREPR = 0;
+        double _PREPR = 0;
+
+        double boost = 0;
+        if (nElements > 1)
+        {
+            for (auto jPostRank : postsRanks)
+            {
+                if (iPostRank.LAST5 > jPostRank.LAST5)
+                    _LAST5R += 1;
+                if (iPostRank.UREP > jPostRank.UREP)
+                    _UREPR += 1;
+                if (iPostRank.PREP > jPostRank.PREP)
+                    _PREPR += 1;
+            }
+
+            iPostRank.LAST5R = 1.0 * (_LAST5R * 100) / (nElements - 1);
+            iPostRank.UREPR = std::min(iPostRank.UREP, 1.0 * (_UREPR * 100) / (nElements - 1)) * (iPostRank.UREP < 0 ? 2.0 : 1.0);
+            iPostRank.PREPR = std::min(iPostRank.PREP, 1.0 * (_PREPR * 100) / (nElements - 1)) * (iPostRank.PREP < 0 ? 2.0 : 1.0);
+        }
+        else
+        {
+            iPostRank.LAST5R = 100;
+            iPostRank.UREPR = 100;
+            iPostRank.PREPR = 100;
+        }
+
+        iPostRank.POSTRF = 0.4 * (0.75 * (iPostRank.LAST5R + boost) + 0.25 * iPostRank.UREPR) * iPostRank.DREP + 0.6 * iPostRank.PREPR * iPostRank.DPOST;
+    }
+}
+
+BOOST_FIXTURE_TEST_SUITE(feedranking_tests, BasicTestingSetup)
+
+BOOST_AUTO_TEST_CASE(decay_table_matches_pow)
+{
+    for (double base : {0.82, 0.96, 0.99})
+    {
+        DecayTable table(base, 301);
+        for (int distance = -5; distance < 2000; distance++)
+            BOOST_CHECK_EQUAL(table(distance), pow(base, distance));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ranking_matches_pairwise)
+{
+    SeedInsecureRand(true);
+
+    DecayTable decayRep(0.82, 301);
+    DecayTable decayContent(0.96, 301);
+
+    for (int count : {0, 1, 2, 3, 10, 100, 1000, 3000})
+    {
+        // Small value ranges give many ties - both in percentiles and in final score
+        std::vector<HierarchicalRecord> expected;
+        std::vector<HierarchicalRecord> actual;
+        for (int i = 0; i < count; i++)
+        {
+            int distance = (int) InsecureRandRange(400);
+
+            HierarchicalRecord record{};
+            record.Id = i + 1;
+            record.LAST5 = 1.0 * (int) InsecureRandRange(20);
+            record.UREP = (int) InsecureRandRange(100) - 50;
+            record.PREP = (int) InsecureRandRange(20) - 10;
+
+            record.DREP = pow(0.82, distance);
+            record.DPOST = pow(0.96, distance);
+            expected.push_back(record);
+
+            record.DREP = decayRep(distance);
+            record.DPOST = decayContent(distance);
+            actual.push_back(record);
+        }
+
+        RankPairwise(expected);
+        RankHierarchicalRecords(actual);
+
+        for (int i = 0; i < count; i++)
+        {
+            BOOST_CHECK_EQUAL(actual[i].LAST5R, expected[i].LAST5R);
+            BOOST_CHECK_EQUAL(actual[i].UREPR, expected[i].UREPR);
+            BOOST_CHECK_EQUAL(actual[i].PREPR, expected[i].PREPR);
+            BOOST_CHECK_EQUAL(actual[i].POSTRF, expected[i].POSTRF);
+        }
+
+        std::sort(expected.begin(), expected.end(), std::greater<HierarchicalRecord>());
+        std::sort(actual.begin(), actual.end(), std::greater<HierarchicalRecord>());
+
+        for (int i = 0; i < count; i++)
+            BOOST_CHECK_EQUAL(actual[i].Id, expected[i].Id);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(filter_and_page_candidates)
+{
+    std::vector<HierarchicalCandidate> candidates;
+    for (int i = 1; i <= 6; i++)
+    {
+        HierarchicalCandidate candidate{};
+        candidate.Record.Id = i;
+        candidate.Record.POSTRF = 10 - i;
+        candidate.RootTxHash = "tx" + std::to_string(i);
+        candidate.Address = i % 2 ? "odd" : "even";
+        candidates.push_back(candidate);
+    }
+
+    HierarchicalFilter filter;
+    filter.FilterTags = true;
+    filter.TaggedIds = {1, 2, 3, 4, 5};
+    filter.ExcludedTaggedIds = {2};
+    filter.TxIdsExcluded = {"tx3"};
+    filter.AddressesExcluded = {"none"};
+
+    auto records = FilterHierarchicalCandidates(candidates, filter);
+    BOOST_CHECK_EQUAL(records.size(), 3U);
+    BOOST_CHECK_EQUAL(records[0].Id, 1);
+    BOOST_CHECK_EQUAL(records[1].Id, 4);
+    BOOST_CHECK_EQUAL(records[2].Id, 5);
+
+    // Requested tags not found - nothing passes
+    filter.TaggedIds.clear();
+    BOOST_CHECK(FilterHierarchicalCandidates(candidates, filter).empty());
+
+    // First page, then page after id 4
+    int64_t minId;
+    auto ids = PageHierarchicalRecords(records, 2, 0, minId);
+    BOOST_CHECK(ids == std::vector<int64_t>({1, 4}));
+    BOOST_CHECK_EQUAL(minId, 1);
+
+    ids = PageHierarchicalRecords(records, 2, 4, minId);
+    BOOST_CHECK(ids == std::vector<int64_t>({5}));
+    BOOST_CHECK_EQUAL(minId, 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
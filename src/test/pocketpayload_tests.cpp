@@ -0,0 +1,186 @@
+// Copyright (c) 2018-2022 The Pocketnet developers
+// Distributed under the Apache 2.0 software license, see the accompanying
+// https://www.apache.org/licenses/LICENSE-2.0
+
+#include <arith_uint256.h>
+#include <pocketdb/services/Serializer.h>
+#include <test/test_pocketcoin.h>
+#include <utilstrencodings.h>
+
+#include <functional>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace PocketServices;
+
+// Transaction of pocket type with payload hash in OP_RETURN and one payment output
+static CTransactionRef MakePocketTx(const std::string& opReturnType, int n)
+{
+    CMutableTransaction tx;
+    tx.nTime = 1600000000 + n;
+    tx.vin.emplace_back(COutPoint{ArithToUint256(arith_uint256(n + 1)), 0});
+    tx.vout.emplace_back(0, CScript() << OP_RETURN << ParseHex(opReturnType) << ParseHex("00112233"));
+    tx.vout.emplace_back(1337, CScript() << OP_TRUE);
+    return MakeTransactionRef(tx);
+}
+
+static PTransactionRef MakeModel(const CTransactionRef& tx, const std::function<void(Transaction&)>& fill)
+{
+    TxType txType;
+    BOOST_REQUIRE(TransactionHelper::IsPocketSupportedTransaction(tx, txType));
+
+    auto ptx = TransactionHelper::CreateInstance(txType, tx);
+    BOOST_REQUIRE(ptx);
+    fill(*ptx);
+    return ptx;
+}
+
+static PTransactionRef Receive(const CTransactionRef& tx, const std::string& payload)
+{
+    CDataStream stream(SER_NETWORK, PROTOCOL_VERSION);
+    stream << payload;
+
+    auto[ok, ptx] = Serializer::DeserializeTransaction(tx, stream);
+    BOOST_REQUIRE(ok && ptx);
+    return ptx;
+}
+
+static void CheckSameField(const optional<std::string>& a, const optional<std::string>& b, const std::string& field)
+{
+    BOOST_CHECK_MESSAGE(a == b, field + ": '" + a.value_or("<none>") + "' != '" + b.value_or("<none>") + "'");
+}
+
+// Binary payload must restore the same model as json payload of the same transaction
+static void CheckSameAsJson(const CTransactionRef& tx, const PTransactionRef& ptx)
+{
+    auto json = Receive(tx, Serializer::SerializeTransactionPayload(*ptx, PayloadFormat::Json));
+    auto binary = Receive(tx, Serializer::SerializeTransactionPayload(*ptx, PayloadFormat::Binary));
+
+    BOOST_CHECK(*json->GetType() == *binary->GetType());
+    CheckSameField(json->GetString1(), binary->GetString1(), "String1");
+    CheckSameField(json->GetString2(), binary->GetString2(), "String2");
+    CheckSameField(json->GetString3(), binary->GetString3(), "String3");
+    CheckSameField(json->GetString4(), binary->GetString4(), "String4");
+    CheckSameField(json->GetString5(), binary->GetString5(), "String5");
+    BOOST_CHECK(json->GetInt1() == binary->GetInt1());
+
+    BOOST_REQUIRE_EQUAL(json->HasPayload(), binary->HasPayload());
+    if (json->HasPayload())
+    {
+        CheckSameField(json->GetPayload()->GetTxHash(), binary->GetPayload()->GetTxHash(), "Payload.TxHash");
+        CheckSameField(json->GetPayload()->GetString1(), binary->GetPayload()->GetString1(), "Payload.String1");
+        CheckSameField(json->GetPayload()->GetString2(), binary->GetPayload()->GetString2(), "Payload.String2");
+        CheckSameField(json->GetPayload()->GetString3(), binary->GetPayload()->GetString3(), "Payload.String3");
+        CheckSameField(json->GetPayload()->GetString4(), binary->GetPayload()->GetString4(), "Payload.String4");
+        CheckSameField(json->GetPayload()->GetString5(), binary->GetPayload()->GetString5(), "Payload.String5");
+        CheckSameField(json->GetPayload()->GetString6(), binary->GetPayload()->GetString6(), "Payload.String6");
+        CheckSameField(json->GetPayload()->GetString7(), binary->GetPayload()->GetString7(), "Payload.String7");
+    }
+
+    BOOST_CHECK_EQUAL(json->BuildHash(), binary->BuildHash());
+}
+
+BOOST_FIXTURE_TEST_SUITE(pocketpayload_tests, BasicTestingSetup)
+
+BOOST_AUTO_TEST_CASE(binary_payload_matches_json)
+{
+    auto post = MakePocketTx(OR_POST, 1);
+    CheckSameAsJson(post, MakeModel(post, [](Transaction& ptx) {
+        ptx.SetString1("address1");
+        ptx.SetString2(*ptx.GetHash());
+        ptx.GeneratePayload();
+        ptx.GetPayload()->SetString1("ru");
+        ptx.GetPayload()->SetString2("caption");
+        ptx.GetPayload()->SetString3("message");
+        ptx.GetPayload()->SetString4("[\"tag1\",\"tag 2\"]");
+        ptx.GetPayload()->SetString5("[\"https://image\"]");
+        ptx.GetPayload()->SetString6("{\"v\":1}");
+    }));
+
+    // Edited repost without lang, tags and images
+    auto postEdit = MakePocketTx(OR_POSTEDIT, 2);
+    CheckSameAsJson(postEdit, MakeModel(postEdit, [](Transaction& ptx) {
+        ptx.SetString1("address1");
+        ptx.SetString2("roottxhash");
+        ptx.SetString3("relaytxhash");
+        ptx.GeneratePayload();
+        ptx.GetPayload()->SetString7("https://url");
+    }));
+
+    auto user = MakePocketTx(OR_USERINFO, 3);
+    CheckSameAsJson(user, MakeModel(user, [](Transaction& ptx) {
+        ptx.SetString1("address1");
+        ptx.GeneratePayload();
+        ptx.GetPayload()->SetString2("name");
+        ptx.GetPayload()->SetString6("pubkey");
+    }));
+
+    auto comment = MakePocketTx(OR_COMMENT, 4);
+    CheckSameAsJson(comment, MakeModel(comment, [](Transaction& ptx) {
+        ptx.SetString1("address1");
+        ptx.SetString2(*ptx.GetHash());
+        ptx.SetString3("posttxhash");
+        ptx.SetString5("answertxhash");
+        ptx.GeneratePayload();
+        ptx.GetPayload()->SetString1("{\"message\":\"text\"}");
+    }));
+
+    auto commentDelete = MakePocketTx(OR_COMMENT_DELETE, 5);
+    CheckSameAsJson(commentDelete, MakeModel(commentDelete, [](Transaction& ptx) {
+        ptx.SetString1("address1");
+        ptx.SetString2("roottxhash");
+        ptx.SetString3("posttxhash");
+    }));
+
+    auto contentDelete = MakePocketTx(OR_CONTENT_DELETE, 6);
+    CheckSameAsJson(contentDelete, MakeModel(contentDelete, [](Transaction& ptx) {
+        ptx.SetString1("address1");
+        ptx.SetString2("roottxhash");
+    }));
+
+    auto score = MakePocketTx(OR_SCORE, 7);
+    CheckSameAsJson(score, MakeModel(score, [](Transaction& ptx) {
+        ptx.SetString1("address1");
+        ptx.SetString2("posttxhash");
+        ptx.SetInt1(5);
+    }));
+
+    auto commentScore = MakePocketTx(OR_COMMENT_SCORE, 8);
+    CheckSameAsJson(commentScore, MakeModel(commentScore, [](Transaction& ptx) {
+        ptx.SetString1("address1");
+        ptx.SetString2("commenttxhash");
+        ptx.SetInt1(-1);
+    }));
+
+    auto subscribe = MakePocketTx(OR_SUBSCRIBEPRIVATE, 9);
+    CheckSameAsJson(subscribe, MakeModel(subscribe, [](Transaction& ptx) {
+        ptx.SetString1("address1");
+        ptx.SetString2("address2");
+    }));
+
+    auto complain = MakePocketTx(OR_COMPLAIN, 10);
+    CheckSameAsJson(complain, MakeModel(complain, [](Transaction& ptx) {
+        ptx.SetString1("address1");
+        ptx.SetString2("posttxhash");
+        ptx.SetInt1(3);
+    }));
+}
+
+BOOST_AUTO_TEST_CASE(binary_payload_rejects_other_transaction)
+{
+    auto post = MakePocketTx(OR_POST, 1);
+    auto other = MakePocketTx(OR_POST, 2);
+    auto ptx = MakeModel(post, [](Transaction& ptx) {
+        ptx.SetString1("address1");
+        ptx.SetString2(*ptx.GetHash());
+    });
+
+    CDataStream stream(SER_NETWORK, PROTOCOL_VERSION);
+    stream << Serializer::SerializeTransactionPayload(*ptx, PayloadFormat::Binary);
+
+    auto[ok, result] = Serializer::DeserializeTransaction(other, stream);
+    BOOST_CHECK(!ok);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -472,6 +472,7 @@ void CTxMemPool::removeUnchecked(txiter it, MemPoolRemovalReason reason)
     cachedInnerUsage -= memusage::DynamicUsage(mapLinks[it].parents) + memusage::DynamicUsage(mapLinks[it].children);
     mapLinks.erase(it);
     mapTx.erase(it);
+    pocketIndex.Remove(hash.GetHex());
 
     //LogPrintf("DEBUG removeUnchecked : %s (%d)\n", hash.GetHex(), (int)reason);
 
@@ -676,6 +677,7 @@ void CTxMemPool::_clear()
     mapLinks.clear();
     mapTx.clear();
     mapNextTx.clear();
+    pocketIndex.Clear();
     totalTxSize = 0;
     cachedInnerUsage = 0;
     lastRollingFeeUpdate = GetTime();
@@ -827,6 +829,11 @@ void CTxMemPool::check(const CCoinsViewCache *pcoins) const
 
     assert(totalTxSize == checkTotal);
     assert(innerUsage == cachedInnerUsage);
+
+    // Pocket index holds only mempool transactions and its counters match indexed payloads
+    for (const auto& hash : pocketIndex.Hashes())
+        assert(mapTx.count(uint256S(hash)));
+    assert(pocketIndex.CheckConsistency());
 }
 
 bool CTxMemPool::CompareDepthAndScore(const uint256& hasha, const uint256& hashb)
@@ -1057,6 +1064,12 @@ void CTxMemPool::RemoveStaged(setEntries& stage, bool updateDescendants, MemPool
     }
 }
 
+void CTxMemPool::addPocketUnchecked(const PocketHelpers::PTransactionRef& ptx)
+{
+    if (ptx && ptx->GetHash() && mapTx.count(uint256S(*ptx->GetHash())))
+        pocketIndex.Add(ptx);
+}
+
 void CTxMemPool::CleanSQLite(const std::unordered_set<std::string>& hashes, const std::string& func, MemPoolRemovalReason reason)
 {
     for (const auto& hash : hashes)
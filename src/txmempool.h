@@ -28,6 +28,7 @@
 #include <boost/signals2/signal.hpp>
 
 #include "pocketdb/pocketnet.h"
+#include "pocketdb/consensus/MempoolIndex.h"
 
 class CBlockIndex;
 extern CCriticalSection cs_main;
@@ -455,6 +456,8 @@ private:
     mutable bool blockSinceLastRollingFeeBump;
     mutable double rollingMinimumFeeRate; //!< minimum fee to get into the pool, decreases exponentially
 
+    PocketConsensus::SocialMempoolIndex pocketIndex GUARDED_BY(cs); //!< pocket payloads of mempool transactions for social consensus limits
+
     void trackPackageRemoved(const CFeeRate& rate) EXCLUSIVE_LOCKS_REQUIRED(cs);
 
 public:
@@ -591,6 +594,12 @@ public:
      */
     void CleanSQLite(const std::unordered_set<std::string>& hashes, const std::string& func, MemPoolRemovalReason reason);
 
+    /** Index pocket payload of transaction just added by addUnchecked.
+     *  Entry leaves the index together with the mempool entry.
+     */
+    void addPocketUnchecked(const PocketHelpers::PTransactionRef& ptx) EXCLUSIVE_LOCKS_REQUIRED(cs);
+    const PocketConsensus::SocialMempoolIndex& GetPocketIndex() const EXCLUSIVE_LOCKS_REQUIRED(cs) { return pocketIndex; }
+
     /** When adding transactions from a disconnected block back to the mempool,
      *  new mempool entries may have children in the mempool (which is generally
      *  not the case when otherwise adding transactions).
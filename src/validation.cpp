@@ -1081,7 +1081,7 @@ static bool AcceptToMemoryPoolWorker(const CChainParams& chainparams, CTxMemPool
                 return state.ConsensusFailed((int)result, strprintf("Failed SocialConsensusHelper::Check with result %d\n", (int)result));
 
             // Check transaction with pocketnet consensus rules
-            if (auto[ok, result] = PocketConsensus::SocialConsensusHelper::Validate(ptx, _pocketTx, chainActive.Height() + 1); !ok)
+            if (auto[ok, result] = PocketConsensus::SocialConsensusHelper::Validate(ptx, _pocketTx, pool.GetPocketIndex(), chainActive.Height() + 1); !ok)
                 return state.ConsensusFailed((int)result, strprintf("Failed SocialConsensusHelper::Validate with result %d\n", (int)result));
         }
 
@@ -1133,6 +1133,13 @@ static bool AcceptToMemoryPoolWorker(const CChainParams& chainparams, CTxMemPool
         // Store transaction in memory
         pool.addUnchecked(entry, setAncestors, validForFeeEstimation);
 
+        // Index payload for mempool limits of social consensus and block assembling. Payload already saved
+        // in sqlite (transactions of disconnected block, mempool.dat) is read back from it
+        if (_pocketTx)
+            pool.addPocketUnchecked(_pocketTx);
+        else if (PocketHelpers::TransactionHelper::IsPocketSupportedTransaction(ptx))
+            pool.addPocketUnchecked(PocketDb::TransRepoInst.Get(hash.GetHex(), true));
+
         // trim mempool and check if tx was trimmed
         if (!bypass_limits)
         {
@@ -2548,8 +2555,9 @@ bool CChainState::ConnectBlock(const CBlock& block, const PocketBlockRef& pocket
 
         nTime5 = GetTimeMicros();
         nTimeVerify += nTime5 - nTime4;
-        LogPrint(BCLog::BENCH, "    - Consensus validation: %.2fms (%.3fms/txin) [%.2fs (%.2fms/blk)]\n",
-            MILLI * (nTime5 - nTime4), nInputs <= 1 ? 0 : MILLI * (nTime5 - nTime4) / (nInputs - 1), nTimeVerify * MICRO,
+        LogPrint(BCLog::BENCH, "    - Consensus validation: %.2fms (%.3fms/txin, %u pocket txs, %d threads) [%.2fs (%.2fms/blk)]\n",
+            MILLI * (nTime5 - nTime4), nInputs <= 1 ? 0 : MILLI * (nTime5 - nTime4) / (nInputs - 1),
+            pocketBlock ? pocketBlock->size() : 0, PocketConsensus::SocialValidationQueueInst.Threads() + 1, nTimeVerify * MICRO,
             nTimeVerify * MILLI / nBlocksTotal);
     }
 
@@ -2576,6 +2584,13 @@ bool CChainState::ConnectBlock(const CBlock& block, const PocketBlockRef& pocket
 
             return false;
         }
+
+        // New tip will be requested by peers - keep its payload ready for relay
+        if (pocketBlock && !IsInitialBlockDownload())
+            PocketServices::BlockPayloadCacheInst.Put(pindex->GetBlockHash(), *pocketBlock);
+
+        // Block committed - checkpoint WAL before next one arrives
+        PocketServices::WalCheckpointerInst.Notify();
     }
 
     int64_t nTime6 = GetTimeMicros();
@@ -2587,7 +2602,10 @@ bool CChainState::ConnectBlock(const CBlock& block, const PocketBlockRef& pocket
     // -----------------------------------------------------------------------------------------------------------------
     // Extend WEB database
     if (gArgs.GetBoolArg("-api", true) && enablePocketConnect)
+    {
         PocketServices::WebPostProcessorInst.Enqueue(block.GetHash().GetHex());
+        PocketServices::FeedMaterializerInst.Enqueue(pindex->nHeight);
+    }
 
     // -----------------------------------------------------------------------------------------------------------------
     if (!WriteUndoDataForBlock(blockundo, state, pindex, chainparams))
@@ -2882,6 +2900,9 @@ bool CChainState::DisconnectTip(CValidationState& state, const CChainParams& cha
         if (!PocketServices::ChainPostProcessing::Rollback(chainActive.Height()))
             return error("DisconnectTip(): DisconnectBlock (Pocketnet part) %s failed", pindexDelete->GetBlockHash().ToString());
 
+        PocketServices::BlockPayloadCacheInst.Remove(pindexDelete->GetBlockHash());
+        PocketServices::FeedMaterializerInst.Invalidate();
+
         bool flushed = view.Flush();
         assert(flushed);
     }
@@ -2922,6 +2943,7 @@ static int64_t nTimeConnectTotal = 0;
 static int64_t nTimeFlush = 0;
 static int64_t nTimeChainState = 0;
 static int64_t nTimePostConnect = 0;
+static int64_t nLastMemoryLog = 0;
 
 struct PerBlockConnectTrace
 {
@@ -3029,6 +3051,9 @@ bool CChainState::ConnectTip(CValidationState& state, const CChainParams& chainp
     }
     const CBlock& blockConnecting = *pthisBlock;
 
+    // Models read from db and social consensus indexes of the block share one arena
+    PocketHelpers::BlockArenaScope arenaScope;
+
     // Read transactions payload from db
     PocketBlockRef pocketBlock = nullptr;
     if (!pocketBlockPart)
@@ -3077,6 +3102,14 @@ bool CChainState::ConnectTip(CValidationState& state, const CChainParams& chainp
         LogPrint(BCLog::BENCH, "  - Connect total: %.2fms [%.2fs (%.2fms/blk)]\n", (nTime3 - nTime2) * MILLI,
             nTimeConnectTotal * MICRO, nTimeConnectTotal * MILLI / nBlocksTotal);
 
+        if (arenaScope.Arena())
+        {
+            auto arenaStats = PocketHelpers::GetBlockArenaStats();
+            LogPrint(BCLog::BENCH, "  - Block arena: %u allocations, %.2fKiB [%u allocations, %.2fMiB in %u released arenas]\n",
+                arenaScope.Arena()->Allocations(), arenaScope.Arena()->Bytes() / 1024.0,
+                arenaStats.Allocations, arenaStats.Bytes / 1048576.0, arenaStats.Arenas);
+        }
+
         bool flushed = view.Flush();
         assert(flushed);
     }
@@ -3113,6 +3146,17 @@ bool CChainState::ConnectTip(CValidationState& state, const CChainParams& chainp
     LogPrint(BCLog::BENCH, "- Connect block: %.2fms [%.2fs (%.2fms/blk)]\n", (nTime6 - nTime1) * MILLI,
         nTimeTotal * MICRO, nTimeTotal * MILLI / nBlocksTotal);
 
+    // Memory of connected blocks - reported only during reindex and initial sync, where arenas matter
+    if ((fReindex || IsInitialBlockDownload()) && nTime6 - nLastMemoryLog > 60 * 1000000)
+    {
+        auto arenaStats = PocketHelpers::GetBlockArenaStats();
+        LogPrintf("Connected block %d: peak RSS %.2fMiB, %u block arena allocations in %.2fMiB (%u arenas)\n",
+            pindexNew->nHeight, PocketHelpers::GetPeakRss() / 1048576.0,
+            arenaStats.Allocations, arenaStats.Bytes / 1048576.0, arenaStats.Arenas);
+
+        nLastMemoryLog = nTime6;
+    }
+
     uint256 _block_hash = blockConnecting.GetHash();
     std::string _block_hash_str = _block_hash.GetHex();
 
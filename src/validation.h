@@ -23,7 +23,6 @@
 #include <sync.h>
 #include <versionbits.h>
 #include <streams.h>
-#include <protectedmap.h>
 
 #include <algorithm>
 #include <exception>
@@ -39,11 +38,12 @@
 #include <boost/thread/mutex.hpp>
 
 #include "websocket/ws.h"
+#include "websocket/wsregistry.h"
 #include "pocketdb/helpers/TransactionHelper.h"
 using namespace PocketHelpers;
 
 extern std::shared_ptr<Queue<std::pair<CBlock, CBlockIndex*>>> notifyClientsQueue;
-extern std::shared_ptr<ProtectedMap<std::string, WSUser>> WSConnections;
+extern std::shared_ptr<WSConnectionRegistry> WSConnections;
 
 class CBlockIndex;
 
@@ -5,11 +5,32 @@
 #include "pocketdb/pocketnet.h"
 
 
-NotifyBlockProcessor::NotifyBlockProcessor(std::shared_ptr<ProtectedMap<std::string, WSUser>> WSConnections) 
+NotifyBlockProcessor::NotifyBlockProcessor(std::shared_ptr<WSConnectionRegistry> WSConnections) 
 {
     m_WSConnections = std::move(WSConnections);
 }
 
+std::string NotifyBlockProcessor::NotifyType(TxType type)
+{
+    switch (type)
+    {
+        case CONTENT_POST: return "share";
+        case CONTENT_VIDEO: return "video";
+        case CONTENT_ARTICLE: return "article";
+        case BOOST_CONTENT: return "contentBoost";
+        case ACTION_SCORE_CONTENT: return "upvoteShare";
+        case ACTION_SUBSCRIBE: return "subscribe";
+        case ACTION_SUBSCRIBE_PRIVATE: return "subscribePrivate";
+        case ACCOUNT_USER: return "userInfo";
+        case ACTION_SUBSCRIBE_CANCEL: return "unsubscribe";
+        case ACTION_SCORE_COMMENT: return "cScore";
+        case CONTENT_COMMENT: return "comment";
+        case CONTENT_COMMENT_EDIT: return "commentEdit";
+        case CONTENT_COMMENT_DELETE: return "commentDelete";
+        default: return "";
+    }
+}
+
 void NotifyBlockProcessor::PrepareWSMessage(std::map<std::string, std::vector<UniValue>>& messages, std::string msg_type, std::string addrTo, std::string txid, int64_t txtime, custom_fields cFields)
 {
     UniValue msg(UniValue::VOBJ);
@@ -44,94 +65,57 @@ void NotifyBlockProcessor::Process(std::pair<CBlock, CBlockIndex*> entry)
     string _block_stake_txHash = (block.IsProofOfStake() && block.vtx.size() > 1) ? block.vtx[1]->GetHash().GetHex() : "";
 
     int sharesCnt = 0;
-    std::map<std::string, std::map<std::string, int>> contentLangCnt;
+    std::map<TxType, std::map<std::string, int>> contentLangCnt;
     std::string txidpocketnet;
     std::string addrespocketnet = (Params().NetworkIDString() == CBaseChainParams::MAIN) ? "PEj7QNjKdDPqE9kMDRboKoCtp8V6vZeZPd" : "TAqR1ncH95eq9XKSDRR18DtpXqktxh74UU";
-    auto pocketnetaccinfo = PocketDb::NotifierRepoInst.GetAccountInfoByAddress(addrespocketnet);
+
+    // All lookups for block done at once on pooled read-only connection, writer is not touched
+    PocketDb::NotifierBlockData blockData;
+    UniValue pocketnetaccinfo(UniValue::VOBJ);
+    try
+    {
+        auto dbConnection = PocketDb::SQLiteConnectionPoolInst.Acquire();
+        blockData = dbConnection->NotifierRepoInst->GetBlockData(_block_hash.GetHex(), blockIndex->nHeight);
+        pocketnetaccinfo = dbConnection->NotifierRepoInst->GetAccountInfoByAddress(addrespocketnet);
+    }
+    catch (const std::exception& e)
+    {
+        LogPrintf("Error: NotifyBlockProcessor::Process - %s\n", e.what());
+        return;
+    }
+
+    auto find = [](const std::unordered_map<std::string, UniValue>& data, const std::string& txid) {
+        auto it = data.find(txid);
+        return it != data.end() ? it->second : UniValue(UniValue::VOBJ);
+    };
 
     for (const auto& tx : block.vtx) {
         std::map<std::string, std::pair<int, int64_t>> addrs;
         int64_t txtime = tx->nTime;
         std::string txid = tx->GetHash().GetHex();
-        std::string optype;
 
-        // Get all addresses from tx outs and check OP_RETURN
-        for (int i = 0; i < tx->vout.size(); i++) {
-            const CTxOut& txout = tx->vout[i];
-            //-------------------------
-            if (txout.scriptPubKey[0] == OP_RETURN) {
-                std::string asmstr = ScriptToAsmStr(txout.scriptPubKey);
-                std::vector<std::string> spl;
-                boost::split(spl, asmstr, boost::is_any_of("\t "));
-                if (spl.size() >= 3) {
-                    if (spl[1] == OR_POST) {
-                        optype = "share";
-                        sharesCnt += 1;
-
-                        auto response = PocketDb::NotifierRepoInst.GetPostLang(txid);
-
-                        if (response.exists("lang"))
-                        {
-                            std::string lang = response["lang"].get_str();
-
-                            contentLangCnt[OR_POST][lang] += 1;
-                        }
-                    }
-                    else if (spl[1] == OR_VIDEO) {
-                        optype = "video";
-                        sharesCnt += 1;
+        // Type already known from ChainPostProcessing, no need to parse OP_RETURN again
+        auto txType = blockData.Types.find(txid);
+        std::string optype = txType != blockData.Types.end() ? NotifyType(txType->second) : "";
 
-                        auto response = PocketDb::NotifierRepoInst.GetPostLang(txid);
+        if (optype == "share" || optype == "video" || optype == "article") {
+            sharesCnt += 1;
 
-                        if (response.exists("lang"))
-                        {
-                            std::string lang = response["lang"].get_str();
-
-                            contentLangCnt[OR_VIDEO][lang] += 1;
-                        }
-                    }
-                    else if (spl[1] == OR_ARTICLE) {
-                        optype = "article";
-                        sharesCnt += 1;
-
-                        auto response = PocketDb::NotifierRepoInst.GetPostLang(txid);
-
-                        if (response.exists("lang"))
-                        {
-                            std::string lang = response["lang"].get_str();
+            auto response = find(blockData.Contents, txid);
+            if (response.exists("lang"))
+                contentLangCnt[txType->second][response["lang"].get_str()] += 1;
+        }
 
-                            contentLangCnt[OR_ARTICLE][lang] += 1;
-                        }
-                    }
-                    else if (spl[1] == OR_CONTENT_BOOST)
-                        optype = "contentBoost";
-                    else if (spl[1] == OR_SCORE)
-                        optype = "upvoteShare";
-                    else if (spl[1] == OR_SUBSCRIBE)
-                        optype = "subscribe";
-                    else if (spl[1] == OR_SUBSCRIBEPRIVATE)
-                        optype = "subscribePrivate";
-                    else if (spl[1] == OR_USERINFO)
-                        optype = "userInfo";
-                    else if (spl[1] == OR_UNSUBSCRIBE)
-                        optype = "unsubscribe";
-                    else if (spl[1] == OR_COMMENT_SCORE)
-                        optype = "cScore";
-                    else if (spl[1] == OR_COMMENT)
-                        optype = "comment";
-                    else if (spl[1] == OR_COMMENT_EDIT)
-                        optype = "commentEdit";
-                    else if (spl[1] == OR_COMMENT_DELETE)
-                        optype = "commentDelete";
-                }
-            }
+        // Get all addresses from tx outs
+        for (size_t i = 0; i < tx->vout.size(); i++) {
+            const CTxOut& txout = tx->vout[i];
             //-------------------------
             CTxDestination destAddress;
             bool fValidAddress = ExtractDestination(txout.scriptPubKey, destAddress);
             if (fValidAddress) {
                 std::string encoded_address = EncodeDestination(destAddress);
                 if (addrs.find(encoded_address) == addrs.end())
-                    addrs.emplace(encoded_address, std::make_pair(i, (int64_t)txout.nValue));
+                    addrs.emplace(encoded_address, std::make_pair((int) i, (int64_t)txout.nValue));
             }
         }
 
@@ -149,7 +133,7 @@ void NotifyBlockProcessor::Process(std::pair<CBlock, CBlockIndex*> entry)
             // Event for new PocketNET transaction
             if (optype == "share" || optype == "video" || optype == "article")
             {
-                auto response = PocketDb::NotifierRepoInst.GetPostInfo(txid);
+                auto response = find(blockData.Contents, txid);
                 if (response.exists("hash") && response.exists("rootHash") && response["hash"].get_str() != response["rootHash"].get_str())
                     continue;
 
@@ -159,7 +143,7 @@ void NotifyBlockProcessor::Process(std::pair<CBlock, CBlockIndex*> entry)
                 }
                 else
                 {
-                    auto response = PocketDb::NotifierRepoInst.GetOriginalPostAddressByRepost(txid);
+                    auto response = find(blockData.Reposts, txid);
                     if (response.exists("hash"))
                     {
                         std::string address = response["address"].get_str();
@@ -178,7 +162,8 @@ void NotifyBlockProcessor::Process(std::pair<CBlock, CBlockIndex*> entry)
                     }
                 }
 
-                auto subscribesResponse = PocketDb::NotifierRepoInst.GetPrivateSubscribeAddressesByAddressTo(addr.first);
+                auto subscribesIt = blockData.PrivateSubscribers.find(addr.first);
+                auto subscribesResponse = subscribesIt != blockData.PrivateSubscribers.end() ? subscribesIt->second : UniValue(UniValue::VARR);
                 for (size_t i = 0; i < subscribesResponse.size(); ++i)
                 {
                     auto address = subscribesResponse[i]["addressTo"].get_str();
@@ -197,7 +182,7 @@ void NotifyBlockProcessor::Process(std::pair<CBlock, CBlockIndex*> entry)
             }
             else if (optype == "contentBoost")
             {
-                auto response = PocketDb::NotifierRepoInst.GetBoostInfo(txid);
+                auto response = find(blockData.Boosts, txid);
                 if (response.exists("contentHash"))
                 {
                     if(response["contentAddress"].get_str() == addr.first)
@@ -221,7 +206,7 @@ void NotifyBlockProcessor::Process(std::pair<CBlock, CBlockIndex*> entry)
             }
             else if (optype == "userInfo")
             {
-                auto response = PocketDb::NotifierRepoInst.GetUserReferrerAddress(txid);
+                auto response = find(blockData.Referrers, txid);
                 if (response.exists("referrerAddress"))
                 {
                     custom_fields cFields
@@ -238,7 +223,7 @@ void NotifyBlockProcessor::Process(std::pair<CBlock, CBlockIndex*> entry)
             }
             else if (optype == "upvoteShare")
             {
-                auto response = PocketDb::NotifierRepoInst.GetPostInfoAddressByScore(txid);
+                auto response = find(blockData.ContentScores, txid);
                 if (response.exists("postTxHash"))
                 {
                     custom_fields cFields
@@ -258,7 +243,7 @@ void NotifyBlockProcessor::Process(std::pair<CBlock, CBlockIndex*> entry)
             }
             else if (optype == "subscribe" || optype == "subscribePrivate" || optype == "unsubscribe")
             {
-                auto response = PocketDb::NotifierRepoInst.GetSubscribeAddressTo(txid);
+                auto response = find(blockData.Subscribes, txid);
                 if (response.exists("addressTo"))
                 {
                     custom_fields cFields
@@ -276,7 +261,7 @@ void NotifyBlockProcessor::Process(std::pair<CBlock, CBlockIndex*> entry)
             }
             else if (optype == "cScore")
             {
-                auto response = PocketDb::NotifierRepoInst.GetCommentInfoAddressByScore(txid);
+                auto response = find(blockData.CommentScores, txid);
                 if (response.exists("commentHash"))
                 {
                     custom_fields cFields
@@ -296,7 +281,7 @@ void NotifyBlockProcessor::Process(std::pair<CBlock, CBlockIndex*> entry)
             }
             else if (optype == "comment" || optype == "commentEdit" || optype == "commentDelete")
             {
-                auto response = PocketDb::NotifierRepoInst.GetFullCommentInfo(txid);
+                auto response = find(blockData.Comments, txid);
                 if (response.exists("postHash"))
                 {
                     if (response.exists("answerAddress") && !response["answerAddress"].get_str().empty())
@@ -354,73 +339,70 @@ void NotifyBlockProcessor::Process(std::pair<CBlock, CBlockIndex*> entry)
         for (const auto& itemLang : itemContent.second) {
             langContents.pushKV(itemLang.first, itemLang.second);
         }
-        contentsLang.pushKV(TransactionHelper::TxStringType(PocketHelpers::TransactionHelper::ConvertOpReturnToType(itemContent.first)), langContents);
+        contentsLang.pushKV(TransactionHelper::TxStringType(itemContent.first), langContents);
     }
 
-    auto send = [&](std::pair<const std::string, WSUser>& connWS) {
+    int height = blockIndex->nHeight;
+
+    // Identical for every client - serialized once and shared by all sockets
+    WSConnectionRegistry::MessageRef sharePocketnetMsg;
+    if (txidpocketnet != "")
+    {
+        UniValue m(UniValue::VOBJ);
+        m.pushKV("msg", "sharepocketnet");
+        m.pushKV("time", std::to_string(block.nTime));
+        m.pushKV("addrFrom", addrespocketnet);
+        if (pocketnetaccinfo.exists("name")) m.pushKV("nameFrom", pocketnetaccinfo["name"].get_str());
+        if (pocketnetaccinfo.exists("avatar")) m.pushKV("avatarFrom", pocketnetaccinfo["avatar"].get_str());
+        m.pushKV("txids", txidpocketnet.substr(0, txidpocketnet.size() - 1));
+        sharePocketnetMsg = WSConnectionRegistry::MakeMessage(m.write());
+    }
+
+    // Registry is not locked while messages are built and sent
+    for (const auto& [address, subscribers] : m_WSConnections->Snapshot())
+    {
+        std::vector<WSConnectionRegistry::SubscriberRef> recipients;
+        for (const auto& subscriber : subscribers)
+            if (height > subscriber->Block)
+                recipients.push_back(subscriber);
+
+        if (recipients.empty())
+            continue;
+
+        // Messages of one address built once for all its connections
+        std::vector<WSConnectionRegistry::MessageRef> addressMessages;
+
         UniValue msg(UniValue::VOBJ);
-        msg.pushKV("addr", connWS.second.Address);
+        msg.pushKV("addr", address);
         msg.pushKV("stakeTxHash", _block_stake_txHash);
         msg.pushKV("msg", "new block");
         msg.pushKV("blockhash", _block_hash.GetHex());
         msg.pushKV("time", std::to_string(block.nTime));
-        msg.pushKV("height", blockIndex->nHeight);
+        msg.pushKV("height", height);
         msg.pushKV("shares", sharesCnt);
         msg.pushKV("contentsLang", contentsLang);
 
-        auto countResponse = PocketDb::NotifierRepoInst.GetPostCountFromMySubscribes(connWS.second.Address, blockIndex->nHeight);
-        if (countResponse.exists("count"))
-        {
-            msg.pushKV("sharesSubscr", countResponse["count"].get_int());
-        }
+        auto subscribesCount = blockData.SubscribesContentsCount.find(address);
+        msg.pushKV("sharesSubscr", subscribesCount != blockData.SubscribesContentsCount.end() ? subscribesCount->second : 0);
 
-        if (blockIndex->nHeight > connWS.second.Block)
-        {
-            try
-            {
-                connWS.second.Connection->send(msg.write(), [](const SimpleWeb::error_code& ec) {});
-            }
-            catch (const std::exception& e)
-            {
-                LogPrintf("Error: CChainState::NotifyWSClients (1) - %s\n", e.what());
-            }
+        addressMessages.push_back(WSConnectionRegistry::MakeMessage(msg.write()));
 
-            if (txidpocketnet != "")
-            {
-                try
-                {
-                    UniValue m(UniValue::VOBJ);
-                    m.pushKV("msg", "sharepocketnet");
-                    m.pushKV("time", std::to_string(block.nTime));
-                    m.pushKV("addrFrom", addrespocketnet);
-                    if (pocketnetaccinfo.exists("name")) m.pushKV("nameFrom", pocketnetaccinfo["name"].get_str());
-                    if (pocketnetaccinfo.exists("avatar")) m.pushKV("avatarFrom", pocketnetaccinfo["avatar"].get_str());
-                    m.pushKV("txids", txidpocketnet.substr(0, txidpocketnet.size() - 1));
-                    connWS.second.Connection->send(m.write(), [](const SimpleWeb::error_code& ec) {});
-                }
-                catch (const std::exception& e)
-                {
-                    LogPrintf("Error: CChainState::NotifyWSClients (1) - %s\n", e.what());
-                }
-            }
+        if (sharePocketnetMsg)
+            addressMessages.push_back(sharePocketnetMsg);
 
-            if (messages.find(connWS.second.Address) != messages.end())
-            {
-                for (auto m : messages[connWS.second.Address])
-                {
-                    try
-                    {
-                        connWS.second.Connection->send(m.write(), [](const SimpleWeb::error_code& ec) {});
-                    }
-                    catch (const std::exception& e)
-                    {
-                        LogPrintf("Error: CChainState::NotifyWSClients (2) - %s\n", e.what());
-                    }
-                }
-            }
+        auto addressEvents = messages.find(address);
+        if (addressEvents != messages.end())
+        {
+            for (const auto& m : addressEvents->second)
+                addressMessages.push_back(WSConnectionRegistry::MakeMessage(m.write()));
+        }
 
-            connWS.second.Block = blockIndex->nHeight;
+        // Client with full send queue skips this block; next block message
+        // with latest state reaches it when socket drains
+        for (const auto& subscriber : recipients)
+        {
+            if (m_WSConnections->Send(subscriber, addressMessages))
+                subscriber->Block = height;
         }
-    };
-    m_WSConnections->Iterate(send);
+    }
 }
@@ -0,0 +1,173 @@
+#include "websocket/wsregistry.h"
+
+#include "util.h"
+
+#include <algorithm>
+
+WSConnectionRegistry::WSConnectionRegistry(int sendQueueLimit) : m_sendQueueLimit(std::max(sendQueueLimit, 1))
+{
+}
+
+WSConnectionRegistry::Shard& WSConnectionRegistry::GetShard(const std::string& address)
+{
+    return m_shards[std::hash<std::string>{}(address) % SHARDS];
+}
+
+const WSConnectionRegistry::Shard& WSConnectionRegistry::GetShard(const std::string& address) const
+{
+    return m_shards[std::hash<std::string>{}(address) % SHARDS];
+}
+
+void WSConnectionRegistry::Remove(const std::string& id, const std::string& address)
+{
+    auto& shard = GetShard(address);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.byAddress.find(address);
+    if (it == shard.byAddress.end())
+        return;
+
+    it->second.erase(id);
+    if (it->second.empty())
+        shard.byAddress.erase(it);
+}
+
+void WSConnectionRegistry::Subscribe(const std::string& id, const WSUser& user)
+{
+    auto subscriber = std::make_shared<Subscriber>(user);
+
+    std::lock_guard<std::mutex> lock(m_idsMutex);
+
+    auto it = m_ids.find(id);
+    if (it != m_ids.end() && it->second != user.Address)
+        Remove(id, it->second);
+
+    {
+        auto& shard = GetShard(user.Address);
+        std::lock_guard<std::mutex> shardLock(shard.mutex);
+        shard.byAddress[user.Address].insert_or_assign(id, std::move(subscriber));
+    }
+
+    m_ids.insert_or_assign(id, user.Address);
+}
+
+void WSConnectionRegistry::Unsubscribe(const std::string& id)
+{
+    std::lock_guard<std::mutex> lock(m_idsMutex);
+
+    auto it = m_ids.find(id);
+    if (it == m_ids.end())
+        return;
+
+    Remove(id, it->second);
+    m_ids.erase(it);
+}
+
+bool WSConnectionRegistry::empty() const
+{
+    std::lock_guard<std::mutex> lock(m_idsMutex);
+    return m_ids.empty();
+}
+
+std::vector<std::pair<std::string, std::vector<WSConnectionRegistry::SubscriberRef>>> WSConnectionRegistry::Snapshot() const
+{
+    std::vector<std::pair<std::string, std::vector<SubscriberRef>>> result;
+
+    for (const auto& shard : m_shards)
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (const auto& [address, connections] : shard.byAddress)
+        {
+            std::vector<SubscriberRef> subscribers;
+            subscribers.reserve(connections.size());
+            for (const auto& connection : connections)
+                subscribers.push_back(connection.second);
+
+            result.emplace_back(address, std::move(subscribers));
+        }
+    }
+
+    return result;
+}
+
+std::vector<WSConnectionRegistry::SubscriberRef> WSConnectionRegistry::Find(const std::string& address) const
+{
+    std::vector<SubscriberRef> result;
+
+    const auto& shard = GetShard(address);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.byAddress.find(address);
+    if (it != shard.byAddress.end())
+        for (const auto& connection : it->second)
+            result.push_back(connection.second);
+
+    return result;
+}
+
+void WSConnectionRegistry::Iterate(const std::function<void(const WSUser&)>& func) const
+{
+    for (const auto& [address, subscribers] : Snapshot())
+        for (const auto& subscriber : subscribers)
+            func(subscriber->User);
+}
+
+bool WSConnectionRegistry::Send(const SubscriberRef& subscriber, const std::vector<MessageRef>& messages)
+{
+    if (messages.empty())
+        return true;
+
+    auto pending = subscriber->Pending;
+    if (*pending + (int) messages.size() > m_sendQueueLimit)
+    {
+        m_dropped += messages.size();
+        return false;
+    }
+
+    for (const auto& message : messages)
+    {
+        *pending += 1;
+
+        try
+        {
+            // Callback holds only counter - connection keeps callbacks of unsent messages
+            subscriber->User.Connection->send(message, [pending](const SimpleWeb::error_code& ec) { *pending -= 1; });
+            m_sent += 1;
+        }
+        catch (const std::exception& e)
+        {
+            *pending -= 1;
+            LogPrintf("Error: WSConnectionRegistry::Send - %s\n", e.what());
+            return false;
+        }
+    }
+
+    return true;
+}
+
+WSConnectionRegistry::MessageRef WSConnectionRegistry::MakeMessage(const std::string& data)
+{
+    auto message = std::make_shared<SimpleWeb::SocketServer<SimpleWeb::WS>::OutMessage>();
+    message->write(data.data(), static_cast<std::streamsize>(data.size()));
+    return message;
+}
+
+WSRegistryStats WSConnectionRegistry::GetStats() const
+{
+    WSRegistryStats stats;
+
+    {
+        std::lock_guard<std::mutex> lock(m_idsMutex);
+        stats.Connections = m_ids.size();
+    }
+
+    for (const auto& shard : m_shards)
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        stats.Addresses += shard.byAddress.size();
+    }
+
+    stats.Sent = m_sent;
+    stats.Dropped = m_dropped;
+    return stats;
+}
@@ -0,0 +1,99 @@
+#ifndef POCKETCOIN_WSREGISTRY_H
+#define POCKETCOIN_WSREGISTRY_H
+
+#include "websocket/ws.h"
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/** Max messages queued to one websocket client before new messages are dropped */
+static const int DEFAULT_WS_SEND_QUEUE = 64;
+
+struct WSRegistryStats {
+    size_t Connections = 0;
+    size_t Addresses = 0;
+    int64_t Sent = 0;
+    int64_t Dropped = 0;
+};
+
+/**
+ * Connected websocket clients indexed by subscribed address.
+ *
+ * Addresses are spread between shards with own locks, so registration of new clients
+ * does not wait for notification of whole registry. Notifier takes a snapshot of
+ * subscribers and sends without holding any lock. Every subscriber counts messages
+ * queued to its socket; slow client exceeding the limit misses messages instead of
+ * growing its queue without bound.
+ */
+class WSConnectionRegistry
+{
+public:
+    using ConnectionRef = std::shared_ptr<SimpleWeb::SocketServer<SimpleWeb::WS>::Connection>;
+    using MessageRef = std::shared_ptr<SimpleWeb::SocketServer<SimpleWeb::WS>::OutMessage>;
+
+    struct Subscriber {
+        WSUser User;
+        // Last block notified to this client
+        std::atomic<int> Block;
+        // Messages queued to socket and not written yet; shared with send callbacks
+        std::shared_ptr<std::atomic<int>> Pending;
+
+        explicit Subscriber(const WSUser& user) : User(user), Block(user.Block), Pending(std::make_shared<std::atomic<int>>(0)) {}
+    };
+    using SubscriberRef = std::shared_ptr<Subscriber>;
+
+    explicit WSConnectionRegistry(int sendQueueLimit = DEFAULT_WS_SEND_QUEUE);
+
+    /** Register connection or move it to another address */
+    void Subscribe(const std::string& id, const WSUser& user);
+    void Unsubscribe(const std::string& id);
+    bool empty() const;
+
+    /** Subscribers grouped by address, taken shard by shard */
+    std::vector<std::pair<std::string, std::vector<SubscriberRef>>> Snapshot() const;
+
+    /** Connections subscribed to address */
+    std::vector<SubscriberRef> Find(const std::string& address) const;
+
+    void Iterate(const std::function<void(const WSUser&)>& func) const;
+
+    /**
+     * Queue all messages to subscriber or none of them if its socket is over the limit.
+     * Messages are sent as is, the same buffer may be shared by any number of connections.
+     */
+    bool Send(const SubscriberRef& subscriber, const std::vector<MessageRef>& messages);
+
+    static MessageRef MakeMessage(const std::string& data);
+
+    WSRegistryStats GetStats() const;
+
+private:
+    static const size_t SHARDS = 16;
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<std::string, std::unordered_map<std::string, SubscriberRef>> byAddress;
+    };
+
+    std::array<Shard, SHARDS> m_shards;
+
+    // Connection id -> address, needed to unsubscribe by connection
+    mutable std::mutex m_idsMutex;
+    std::unordered_map<std::string, std::string> m_ids;
+
+    int m_sendQueueLimit;
+    std::atomic<int64_t> m_sent{0};
+    std::atomic<int64_t> m_dropped{0};
+
+    Shard& GetShard(const std::string& address);
+    const Shard& GetShard(const std::string& address) const;
+    void Remove(const std::string& id, const std::string& address);
+};
+
+#endif // POCKETCOIN_WSREGISTRY_H